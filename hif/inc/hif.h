@@ -109,12 +109,16 @@ struct CE_state;
 /* NOTE: "napi->scale" can be changed,
    but this does not change the number of buckets */
 #define QCA_NAPI_NUM_BUCKETS (QCA_NAPI_BUDGET / QCA_NAPI_DEF_SCALE)
+/* poll duration buckets, upper bounds (in us) are in hif_napi.c */
+#define QCA_NAPI_NUM_LAT_BUCKETS 8
 struct qca_napi_stat {
 	uint32_t napi_schedules;
 	uint32_t napi_polls;
 	uint32_t napi_completes;
 	uint32_t napi_workdone;
 	uint32_t napi_budget_uses[QCA_NAPI_NUM_BUCKETS];
+	uint32_t napi_poll_lat[QCA_NAPI_NUM_LAT_BUCKETS];
+	uint32_t napi_poll_time_max; /* longest poll seen, in us */
 };
 
 /**
@@ -129,7 +133,8 @@ struct qca_napi_info {
 	struct napi_struct   napi;    /* one NAPI Instance per CE in phase I */
 	uint8_t              scale;   /* currently same on all instances */
 	uint8_t              id;
-	struct qca_napi_stat stats[NR_CPUS];
+	/* one copy per possible cpu, summed up when read */
+	struct qca_napi_stat __percpu *stats;
 };
 
 /**
@@ -478,6 +483,23 @@ void hif_trigger_dump(struct hif_opaque_softc *hif_ctx,
 QDF_STATUS hif_send_head(struct hif_opaque_softc *scn, uint8_t PipeID,
 				  uint32_t transferID, uint32_t nbytes,
 				  qdf_nbuf_t wbuf, uint32_t data_attr);
+#ifdef HIF_SDIO
+/**
+ * struct hif_sg_item - one contiguous piece of a scatter-gather send
+ * @buffer: CPU address of the piece
+ * @length: length of the piece in bytes
+ */
+struct hif_sg_item {
+	uint8_t *buffer;
+	uint32_t length;
+};
+
+QDF_STATUS hif_send_head_sg(struct hif_opaque_softc *scn, uint8_t PipeID,
+			    uint32_t transferID, uint32_t nbytes,
+			    qdf_nbuf_t wbuf, struct hif_sg_item *sg_list,
+			    uint32_t sg_count);
+uint32_t hif_get_send_sg_max_entries(struct hif_opaque_softc *scn);
+#endif
 void hif_send_complete_check(struct hif_opaque_softc *scn, uint8_t PipeID,
 			     int force);
 void hif_shut_down_device(struct hif_opaque_softc *scn);
@@ -610,6 +632,8 @@ int hif_send_single(struct hif_opaque_softc *osc, qdf_nbuf_t msdu, uint32_t
 		transfer_id, u_int32_t len);
 int hif_send_fast(struct hif_opaque_softc *osc, qdf_nbuf_t nbuf,
 	uint32_t transfer_id, uint32_t download_len);
+int hif_send_fast_multiple(struct hif_opaque_softc *osc, qdf_nbuf_t *msdus,
+	uint32_t num_msdus, uint32_t transfer_id, uint32_t download_len);
 void hif_pkt_dl_len_set(void *hif_sc, unsigned int pkt_download_len);
 void hif_ce_war_disable(void);
 void hif_ce_war_enable(void);
@@ -96,6 +96,12 @@ int hif_napi_schedule(struct hif_opaque_softc *scn, int ce_id);
 int hif_napi_poll(struct hif_opaque_softc *hif_ctx,
 			struct napi_struct *napi, int budget);
 
+/* per cpu stats of a NAPI instance, summed over all possible cpus */
+void hif_napi_stats_aggregate(struct qca_napi_info *napii,
+			      struct qca_napi_stat *sum);
+
+void hif_napi_stats(struct hif_opaque_softc *hif_ctx);
+
 #ifdef FEATURE_NAPI_DEBUG
 #define NAPI_DEBUG(fmt, ...)			\
 	qdf_print("wlan: NAPI: %s:%d "fmt, __func__, __LINE__, ##__VA_ARGS__);
@@ -149,6 +155,13 @@ static inline int hif_napi_schedule(struct hif_opaque_softc *hif, int ce_id)
 static inline int hif_napi_poll(struct napi_struct *napi, int budget)
 { return -EPERM; }
 
+static inline void hif_napi_stats_aggregate(struct qca_napi_info *napii,
+					    struct qca_napi_stat *sum)
+{ return; }
+
+static inline void hif_napi_stats(struct hif_opaque_softc *hif_ctx)
+{ return; }
+
 #endif /* FEATURE_NAPI */
 
 #endif /* __HIF_NAPI_H__ */
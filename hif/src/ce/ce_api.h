@@ -152,6 +152,9 @@ int ce_send(struct CE_handle *copyeng,
 #ifdef WLAN_FEATURE_FASTPATH
 int ce_send_fast(struct CE_handle *copyeng, qdf_nbuf_t msdu,
 	unsigned int transfer_id, uint32_t download_len);
+int ce_send_fast_multiple(struct CE_handle *copyeng, qdf_nbuf_t *msdus,
+	unsigned int num_msdus, unsigned int transfer_id,
+	uint32_t download_len);
 
 #endif
 
@@ -224,6 +227,32 @@ int ce_recv_buf_enqueue(struct CE_handle *copyeng,
 			void *per_transfer_recv_context,
 			qdf_dma_addr_t buffer);
 
+/**
+ * struct ce_recv_buf - a receive buffer to be posted to a destination ring
+ * @per_transfer_recv_context: context passed back to caller's recv_cb
+ * @buffer: address of buffer in CE space
+ */
+struct ce_recv_buf {
+	void *per_transfer_recv_context;
+	qdf_dma_addr_t buffer;
+};
+
+/*
+ * Make a batch of buffers available to receive.  All descriptors are
+ * filled under a single hold of the ring lock and the destination ring
+ * write index is updated once for the whole batch.
+ *   copyeng  - which copy engine to use
+ *   bufs     - array of receive buffers to post
+ *   num_bufs - number of entries in bufs
+ * Returns the number of buffers posted (posted from the head of bufs),
+ * or a negative error if the target could not be accessed.
+ *
+ * Implemenation note: Pushes up to num_bufs buffers to Dest ring.
+ */
+int ce_recv_buf_enqueue_multiple(struct CE_handle *copyeng,
+				 struct ce_recv_buf *bufs,
+				 unsigned int num_bufs);
+
 /*
  * Register a Receive Callback function.
  * This function is called as soon as data is received
@@ -398,6 +427,7 @@ bool ce_get_rx_pending(struct hif_softc *scn);
 #define CE_ATTR_SWIZZLE_DESCRIPTORS  0x04 /* Swizzle descriptors? */
 #define CE_ATTR_DISABLE_INTR         0x08 /* no interrupt on copy completion */
 #define CE_ATTR_ENABLE_POLL          0x10 /* poll for residue descriptors */
+#define CE_ATTR_INTR_MOD             0x20 /* adaptive interrupt moderation */
 
 /* Attributes of an instance of a Copy Engine */
 struct CE_attr {
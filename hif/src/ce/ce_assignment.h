@@ -77,6 +77,10 @@ static void hif_target_dump_access_log(void);
 #define CE_HTT_H2T_MSG_SRC_NENTRIES_AR900B 4096
 
 #define DIAG_CE_ID           7
+/* diag CE ring depth, lets hif_diag_read_mem() pipeline its chunks */
+#define DIAG_CE_NENTRIES     8
+/* HTT only rx rings, moderated under bulk rx if ce_intr_mod is set */
+#define CE_HTT_RX_FLAGS (CE_ATTR_FLAGS | CE_ATTR_INTR_MOD)
 #define EPPING_CE_FLAGS_POLL \
 	(CE_ATTR_DISABLE_INTR|CE_ATTR_ENABLE_POLL|CE_ATTR_FLAGS)
 
@@ -104,13 +108,13 @@ static struct CE_attr host_ce_config_wlan[] = {
 	{ /* CE6 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL,},
 	/* ce_diag, the Diagnostic Window */
 	{ /* CE7 */ (CE_ATTR_FLAGS | CE_ATTR_DISABLE_INTR), 0,
-		2, DIAG_TRANSFER_LIMIT, 2, NULL,},
+		DIAG_CE_NENTRIES, DIAG_TRANSFER_LIMIT, DIAG_CE_NENTRIES, NULL,},
 	/* Target to uMC */
 	{ /* CE8 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL,},
 	/* target->host HTT */
-	{ /* CE9 */ CE_ATTR_FLAGS, 0, 0,  2048, 512, NULL,},
+	{ /* CE9 */ CE_HTT_RX_FLAGS, 0, 0,  2048, 512, NULL,},
 	/* target->host HTT */
-	{ /* CE10 */ CE_ATTR_FLAGS, 0, 0,  2048, 512, NULL,},
+	{ /* CE10 */ CE_HTT_RX_FLAGS, 0, 0,  2048, 512, NULL,},
 	/* target -> host PKTLOG */
 	{ /* CE11 */ CE_ATTR_FLAGS, 0, 0, 2048, 512, NULL,},
 };
@@ -162,7 +166,8 @@ static struct CE_attr host_ce_config_wlan_epping_poll[] = {
 	/* unused */
 	{ /* CE6 */ CE_ATTR_FLAGS, 0, 0,   0, 0, NULL,},
 	/* ce_diag, the Diagnostic Window */
-	{ /* CE7 */ CE_ATTR_FLAGS, 0, 2,   DIAG_TRANSFER_LIMIT, 2, NULL,},
+	{ /* CE7 */ CE_ATTR_FLAGS, 0,
+		DIAG_CE_NENTRIES, DIAG_TRANSFER_LIMIT, DIAG_CE_NENTRIES, NULL,},
 };
 
 static struct CE_attr host_ce_config_wlan_epping_irq[] = {
@@ -181,7 +186,8 @@ static struct CE_attr host_ce_config_wlan_epping_irq[] = {
 	/* unused */
 	{ /* CE6 */ CE_ATTR_FLAGS, 0,   0, 0, 0, NULL,},
 	/* ce_diag, the Diagnostic Window */
-	{ /* CE7 */ CE_ATTR_FLAGS, 0,   2, DIAG_TRANSFER_LIMIT, 2, NULL,},
+	{ /* CE7 */ CE_ATTR_FLAGS, 0,
+		DIAG_CE_NENTRIES, DIAG_TRANSFER_LIMIT, DIAG_CE_NENTRIES, NULL,},
 };
 /*
  * EP-ping firmware's CE configuration
@@ -226,7 +232,7 @@ static struct CE_attr host_ce_config_wlan[] = {
 	{ /* CE6 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL,},
 	/* ce_diag, the Diagnostic Window */
 	{ /* CE7 */ CE_ATTR_FLAGS | CE_ATTR_DISABLE_INTR,
-		0, 2, DIAG_TRANSFER_LIMIT, 2, NULL,},
+		0, DIAG_CE_NENTRIES, DIAG_TRANSFER_LIMIT, DIAG_CE_NENTRIES, NULL,},
 };
 
 static struct CE_pipe_config target_ce_config_wlan[] = {
@@ -267,7 +273,8 @@ static struct CE_attr host_ce_config_wlan_epping_poll[] = {
 	/* unused */
 	{ /* CE6 */ CE_ATTR_FLAGS, 0, 0,   0, 0, NULL,},
 	/* ce_diag, the Diagnostic Window */
-	{ /* CE7 */ CE_ATTR_FLAGS, 0, 2,   DIAG_TRANSFER_LIMIT, 2, NULL,},
+	{ /* CE7 */ CE_ATTR_FLAGS, 0,
+		DIAG_CE_NENTRIES, DIAG_TRANSFER_LIMIT, DIAG_CE_NENTRIES, NULL,},
 	{ /* CE8 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL,},
 	/* The following CEs are not being used yet */
 	{ /* CE9 */ CE_ATTR_FLAGS, 0, 0,  0, 0, NULL,},
@@ -290,7 +297,8 @@ static struct CE_attr host_ce_config_wlan_epping_irq[] = {
 	/* unused */
 	{ /* CE6 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL,},
 	/* ce_diag, the Diagnostic Window */
-	{ /* CE7 */ CE_ATTR_FLAGS, 0, 2, DIAG_TRANSFER_LIMIT, 2, NULL,},
+	{ /* CE7 */ CE_ATTR_FLAGS, 0,
+		DIAG_CE_NENTRIES, DIAG_TRANSFER_LIMIT, DIAG_CE_NENTRIES, NULL,},
 	{ /* CE8 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL,},
 	/* The following CEs are not being used yet */
 	{ /* CE9 */ CE_ATTR_FLAGS, 0, 0,  0, 0, NULL,},
@@ -339,7 +347,7 @@ static struct CE_attr host_ce_config_wlan_ar9888[] = {
 	{ /* CE5 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL, },    /* unused */
 #endif  /* WLAN_FEATURE_FASTPATH */
 	{ /* CE6 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL, },    /* Target autonomous HIF_memcpy */
-	{ /* CE7 */ CE_ATTR_FLAGS, 0, 2, DIAG_TRANSFER_LIMIT, 2, NULL, }, /* ce_diag, the Diagnostic Window */
+	{ /* CE7 */ CE_ATTR_FLAGS, 0, DIAG_CE_NENTRIES, DIAG_TRANSFER_LIMIT, DIAG_CE_NENTRIES, NULL, }, /* ce_diag, the Diagnostic Window */
 	{ /* CE8 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL, },    /* Target autonomous HIF_memcpy */
 };
 
@@ -357,7 +365,7 @@ static struct CE_attr host_ce_config_wlan_ar900b[] = {
 	{ /* CE5 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL, },    /* unused */
 #endif  /* WLAN_FEATURE_FASTPATH */
 	{ /* CE6 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL, },    /* Target autonomous HIF_memcpy */
-	{ /* CE7 */ CE_ATTR_FLAGS, 0, 2, DIAG_TRANSFER_LIMIT, 2, NULL, }, /* ce_diag, the Diagnostic Window */
+	{ /* CE7 */ CE_ATTR_FLAGS, 0, DIAG_CE_NENTRIES, DIAG_TRANSFER_LIMIT, DIAG_CE_NENTRIES, NULL, }, /* ce_diag, the Diagnostic Window */
 	{ /* CE8 */ CE_ATTR_FLAGS, 0, 0, 2048, 128, NULL, },/* target->host pktlog */
 	{ /* CE9 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL, },    /* Target autonomous HIF_memcpy */
 	{ /* CE10 */ CE_ATTR_FLAGS, 0, 0, 0, 0, NULL, },   /* Target autonomous HIF_memcpy */
@@ -30,6 +30,7 @@
 #include "qdf_status.h"
 #include "qdf_status.h"
 #include <qdf_atomic.h>         /* qdf_atomic_read */
+#include <qdf_time.h>
 #include <targaddrs.h>
 #include "hif_io32.h"
 #include <hif.h>
@@ -94,6 +95,10 @@ hif_ce_dump_target_memory(struct hif_softc *scn, void *ramdump_base,
 
 /* Wait up to this many Ms for a Diagnostic Access CE operation to complete */
 #define DIAG_ACCESS_CE_TIMEOUT_MS 10
+/* Poll interval while waiting for a Diagnostic Access CE completion */
+#define DIAG_ACCESS_CE_POLL_US 5
+/* Max diag read chunks in flight, further limited by the diag CE rings */
+#define DIAG_READ_MAX_INFLIGHT 8
 
 /**
  * get_ce_phy_addr() - get the physical address of an soc virtual address
@@ -136,6 +141,111 @@ qdf_dma_addr_t get_ce_phy_addr(struct hif_softc *sc, uint32_t  address,
 	return ce_phy_addr;
 }
 
+/**
+ * hif_diag_wait_send_done() - wait for the oldest diag send to complete
+ * @ce_diag: diag copy engine
+ * @buf: set to the source address of the completed send
+ * @nbytes: set to the length of the completed send
+ *
+ * Polls without sleeping, the diag CE completes a chunk in microseconds.
+ *
+ * Return: QDF_STATUS_SUCCESS or QDF_STATUS_E_BUSY on timeout
+ */
+static QDF_STATUS hif_diag_wait_send_done(struct CE_handle *ce_diag,
+					  qdf_dma_addr_t *buf,
+					  unsigned int *nbytes)
+{
+	qdf_time_t deadline = qdf_system_ticks() +
+		qdf_system_msecs_to_ticks(DIAG_ACCESS_CE_TIMEOUT_MS) + 1;
+	unsigned int id;
+	unsigned int toeplitz_hash_result;
+
+	while (ce_completed_send_next(ce_diag, NULL, NULL, buf, nbytes, &id,
+				      NULL, NULL, &toeplitz_hash_result) !=
+	       QDF_STATUS_SUCCESS) {
+		if (qdf_system_time_after(qdf_system_ticks(), deadline))
+			return QDF_STATUS_E_BUSY;
+		qdf_udelay(DIAG_ACCESS_CE_POLL_US);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * hif_diag_wait_recv_done() - wait for the oldest diag receive to complete
+ * @ce_diag: diag copy engine
+ * @buf: set to the host address of the completed receive
+ * @nbytes: set to the length of the completed receive
+ *
+ * Return: QDF_STATUS_SUCCESS or QDF_STATUS_E_BUSY on timeout
+ */
+static QDF_STATUS hif_diag_wait_recv_done(struct CE_handle *ce_diag,
+					  qdf_dma_addr_t *buf,
+					  unsigned int *nbytes)
+{
+	qdf_time_t deadline = qdf_system_ticks() +
+		qdf_system_msecs_to_ticks(DIAG_ACCESS_CE_TIMEOUT_MS) + 1;
+	unsigned int id;
+	unsigned int flags;
+
+	while (ce_completed_recv_next(ce_diag, NULL, NULL, buf, nbytes, &id,
+				      &flags) != QDF_STATUS_SUCCESS) {
+		if (qdf_system_time_after(qdf_system_ticks(), deadline))
+			return QDF_STATUS_E_BUSY;
+		qdf_udelay(DIAG_ACCESS_CE_POLL_US);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * hif_diag_drain() - retire the diag entries a failed read left posted
+ * @ce_diag: diag copy engine
+ * @send_pending: sends posted and not yet completed
+ * @recv_pending: receives posted for those sends and not yet completed
+ * @recv_orphan: newest receives posted without a send, 0 or 1
+ *
+ * Waits the outstanding transfers out with the usual per transfer
+ * deadline. If the engine does not complete them, the entries are taken
+ * back from the rings, but DMA into the bounce buffer cannot be ruled
+ * out any more.
+ *
+ * Return: true if the bounce buffer is no longer targeted by the CE
+ */
+static bool hif_diag_drain(struct CE_handle *ce_diag,
+			   unsigned int send_pending,
+			   unsigned int recv_pending,
+			   unsigned int recv_orphan)
+{
+	qdf_dma_addr_t buf;
+	unsigned int nbytes;
+	unsigned int id;
+	unsigned int toeplitz_hash_result;
+	bool idle = true;
+
+	while (send_pending &&
+	       hif_diag_wait_send_done(ce_diag, &buf, &nbytes) ==
+	       QDF_STATUS_SUCCESS)
+		send_pending--;
+	while (recv_pending &&
+	       hif_diag_wait_recv_done(ce_diag, &buf, &nbytes) ==
+	       QDF_STATUS_SUCCESS)
+		recv_pending--;
+
+	if (send_pending || recv_pending) {
+		idle = false;
+		while (send_pending--)
+			ce_cancel_send_next(ce_diag, NULL, NULL, &buf, &nbytes,
+					    &id, &toeplitz_hash_result);
+	}
+	/* no send feeds these, they are only ever revoked */
+	recv_pending += recv_orphan;
+	while (recv_pending--)
+		ce_revoke_recv_next(ce_diag, NULL, NULL, &buf);
+
+	return idle;
+}
+
 /*
  * Diagnostic read/write access is provided for startup/config/debug usage.
  * Caller must guarantee proper alignment, when applicable, and single user
@@ -144,6 +254,20 @@ qdf_dma_addr_t get_ce_phy_addr(struct hif_softc *sc, uint32_t  address,
 
 #define FW_SRAM_ADDRESS     0x000C0000
 
+/**
+ * hif_diag_read_mem() - read soc memory through the diag copy engine
+ * @hif_ctx: hif context
+ * @address: soc virtual address
+ * @data: buffer to read into
+ * @nbytes: number of bytes to read
+ *
+ * Up to DIAG_READ_MAX_INFLIGHT chunks of DIAG_TRANSFER_LIMIT bytes are
+ * kept in flight on the diag CE. Each chunk is copied out to @data as
+ * soon as it completes and its bounce slot is reused for the next one,
+ * so the bounce buffer stays small however large the read is.
+ *
+ * Return: QDF_STATUS_SUCCESS on success
+ */
 QDF_STATUS hif_diag_read_mem(struct hif_opaque_softc *hif_ctx,
 			     uint32_t address, uint8_t *data, int nbytes)
 {
@@ -152,18 +276,21 @@ QDF_STATUS hif_diag_read_mem(struct hif_opaque_softc *hif_ctx,
 	struct HIF_CE_state *hif_state = HIF_GET_CE_STATE(scn);
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
 	qdf_dma_addr_t buf;
-	unsigned int completed_nbytes, orig_nbytes, remaining_bytes;
-	unsigned int id;
-	unsigned int flags;
+	unsigned int completed_nbytes, orig_nbytes;
+	unsigned int posted_bytes, done_bytes;
 	struct CE_handle *ce_diag;
 	qdf_dma_addr_t CE_data;      /* Host buffer address in CE space */
 	qdf_dma_addr_t CE_data_base = 0;
+	qdf_dma_addr_t src_addr[DIAG_READ_MAX_INFLIGHT];
+	unsigned int src_len[DIAG_READ_MAX_INFLIGHT];
+	unsigned int nslots, slot, inflight = 0;
+	unsigned int send_pending = 0, recv_pending = 0, recv_orphan = 0;
+	unsigned int issue_idx = 0, reap_idx = 0;
+	unsigned int data_buf_len = 0;
 	void *data_buf = NULL;
-	int i;
 	unsigned int mux_id = 0;
 	unsigned int transaction_id = 0xffff;
 	qdf_dma_addr_t ce_phy_addr = address;
-	unsigned int toeplitz_hash_result;
 	unsigned int user_flags = 0;
 	unsigned int target_type = 0;
 	unsigned int boundary_addr = 0;
@@ -210,80 +337,109 @@ QDF_STATUS hif_diag_read_mem(struct hif_opaque_softc *hif_ctx,
 
 	A_TARGET_ACCESS_LIKELY(scn);
 
+	orig_nbytes = nbytes;
+	if (!orig_nbytes)
+		goto done;
+
+	/* a slot needs both a source and a destination ring entry */
+	nslots = min(ce_send_entries_avail(ce_diag),
+		     ce_recv_entries_avail(ce_diag));
+	nslots = min(nslots, (unsigned int)DIAG_READ_MAX_INFLIGHT);
+	nslots = min(nslots, (orig_nbytes + DIAG_TRANSFER_LIMIT - 1) /
+		     DIAG_TRANSFER_LIMIT);
+	if (!nslots) {
+		status = QDF_STATUS_E_BUSY;
+		goto done;
+	}
+
 	/*
 	 * Allocate a temporary bounce buffer to hold caller's data
 	 * to be DMA'ed from Target. This guarantees
 	 *   1) 4-byte alignment
 	 *   2) Buffer in DMA-able space
 	 */
-	orig_nbytes = nbytes;
+	data_buf_len = nslots * DIAG_TRANSFER_LIMIT;
 	data_buf = qdf_mem_alloc_consistent(scn->qdf_dev, scn->qdf_dev->dev,
-				    orig_nbytes, &CE_data_base);
+				    data_buf_len, &CE_data_base);
 	if (!data_buf) {
 		status = QDF_STATUS_E_NOMEM;
 		goto done;
 	}
-	qdf_mem_set(data_buf, orig_nbytes, 0);
+	qdf_mem_set(data_buf, data_buf_len, 0);
 	qdf_mem_dma_sync_single_for_device(scn->qdf_dev, CE_data_base,
-				       orig_nbytes, DMA_FROM_DEVICE);
+				       data_buf_len, DMA_FROM_DEVICE);
+
+	posted_bytes = 0;
+	done_bytes = 0;
+	while (done_bytes < orig_nbytes) {
+		/* keep the pipeline full */
+		while (inflight < nslots && posted_bytes < orig_nbytes) {
+			slot = issue_idx % nslots;
+			nbytes = min(orig_nbytes - posted_bytes,
+				     DIAG_TRANSFER_LIMIT);
+			CE_data = CE_data_base + slot * DIAG_TRANSFER_LIMIT;
 
-	remaining_bytes = orig_nbytes;
-	CE_data = CE_data_base;
-	while (remaining_bytes) {
-		nbytes = min(remaining_bytes, DIAG_TRANSFER_LIMIT);
-		{
 			status = ce_recv_buf_enqueue(ce_diag, NULL, CE_data);
 			if (status != QDF_STATUS_SUCCESS)
 				goto done;
-		}
-
-		if (Q_TARGET_ACCESS_BEGIN(scn) < 0)
-			return QDF_STATUS_E_FAILURE;
-
-		/* convert soc virtual address to physical address */
-		ce_phy_addr = get_ce_phy_addr(scn, address, target_type);
+			recv_orphan = 1;
 
-		if (Q_TARGET_ACCESS_END(scn) < 0)
-			return QDF_STATUS_E_FAILURE;
+			if (Q_TARGET_ACCESS_BEGIN(scn) < 0) {
+				status = QDF_STATUS_E_FAILURE;
+				goto done;
+			}
 
-		/* Request CE to send from Target(!)
-		 * address to Host buffer */
-		status = ce_send(ce_diag, NULL, ce_phy_addr, nbytes,
-				transaction_id, 0, user_flags);
-		if (status != QDF_STATUS_SUCCESS)
-			goto done;
+			/* convert soc virtual address to physical address */
+			ce_phy_addr = get_ce_phy_addr(scn,
+						      address + posted_bytes,
+						      target_type);
 
-		i = 0;
-		while (ce_completed_send_next(ce_diag, NULL, NULL, &buf,
-				&completed_nbytes, &id, NULL, NULL,
-				&toeplitz_hash_result) != QDF_STATUS_SUCCESS) {
-			qdf_mdelay(1);
-			if (i++ > DIAG_ACCESS_CE_TIMEOUT_MS) {
-				status = QDF_STATUS_E_BUSY;
+			if (Q_TARGET_ACCESS_END(scn) < 0) {
+				status = QDF_STATUS_E_FAILURE;
 				goto done;
 			}
+
+			/* Request CE to send from Target(!)
+			 * address to Host buffer */
+			status = ce_send(ce_diag, NULL, ce_phy_addr, nbytes,
+					transaction_id, 0, user_flags);
+			if (status != QDF_STATUS_SUCCESS)
+				goto done;
+			recv_orphan = 0;
+			send_pending++;
+			recv_pending++;
+
+			src_addr[slot] = ce_phy_addr;
+			src_len[slot] = nbytes;
+			posted_bytes += nbytes;
+			issue_idx++;
+			inflight++;
 		}
-		if (nbytes != completed_nbytes) {
+
+		/* the diag CE completes in order, reap the oldest chunk */
+		slot = reap_idx % nslots;
+		CE_data = CE_data_base + slot * DIAG_TRANSFER_LIMIT;
+
+		status = hif_diag_wait_send_done(ce_diag, &buf,
+						 &completed_nbytes);
+		if (status != QDF_STATUS_SUCCESS)
+			goto done;
+		send_pending--;
+		if (src_len[slot] != completed_nbytes) {
 			status = QDF_STATUS_E_FAILURE;
 			goto done;
 		}
-		if (buf != ce_phy_addr) {
+		if (buf != src_addr[slot]) {
 			status = QDF_STATUS_E_FAILURE;
 			goto done;
 		}
 
-		i = 0;
-		while (ce_completed_recv_next
-				(ce_diag, NULL, NULL, &buf,
-				&completed_nbytes, &id,
-				 &flags) != QDF_STATUS_SUCCESS) {
-			qdf_mdelay(1);
-			if (i++ > DIAG_ACCESS_CE_TIMEOUT_MS) {
-				status = QDF_STATUS_E_BUSY;
-				goto done;
-			}
-		}
-		if (nbytes != completed_nbytes) {
+		status = hif_diag_wait_recv_done(ce_diag, &buf,
+						 &completed_nbytes);
+		if (status != QDF_STATUS_SUCCESS)
+			goto done;
+		recv_pending--;
+		if (src_len[slot] != completed_nbytes) {
 			status = QDF_STATUS_E_FAILURE;
 			goto done;
 		}
@@ -292,22 +448,32 @@ QDF_STATUS hif_diag_read_mem(struct hif_opaque_softc *hif_ctx,
 			goto done;
 		}
 
-		remaining_bytes -= nbytes;
-		address += nbytes;
-		CE_data += nbytes;
+		qdf_mem_copy(data + done_bytes,
+			     (uint8_t *)data_buf + slot * DIAG_TRANSFER_LIMIT,
+			     completed_nbytes);
+		done_bytes += completed_nbytes;
+		reap_idx++;
+		inflight--;
 	}
 
 done:
+	/* nothing may still point into data_buf when it is freed */
+	if ((send_pending || recv_pending || recv_orphan) &&
+	    !hif_diag_drain(ce_diag, send_pending, recv_pending,
+			    recv_orphan)) {
+		HIF_ERROR("%s: diag CE stuck, leaking %u byte bounce buffer",
+			  __func__, data_buf_len);
+		data_buf = NULL;
+	}
+
 	A_TARGET_ACCESS_UNLIKELY(scn);
 
-	if (status == QDF_STATUS_SUCCESS)
-		qdf_mem_copy(data, data_buf, orig_nbytes);
-	else
+	if (status != QDF_STATUS_SUCCESS)
 		HIF_ERROR("%s failure (0x%x)", __func__, address);
 
 	if (data_buf)
 		qdf_mem_free_consistent(scn->qdf_dev, scn->qdf_dev->dev,
-				orig_nbytes, data_buf, CE_data_base, 0);
+				data_buf_len, data_buf, CE_data_base, 0);
 
 	return status;
 }
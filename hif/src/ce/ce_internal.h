@@ -98,6 +98,60 @@ struct CE_ring_state {
 	OS_DMA_MEM_CONTEXT(ce_dmacontext) /* OS Specific DMA context */
 };
 
+/*
+ * Adaptive interrupt moderation. The packet and byte rates of a CE are
+ * sampled over CE_INTR_MOD_INTERVAL_MS; above the high marks the copy
+ * complete interrupt is turned off and the CE is polled every
+ * CE_INTR_MOD_POLL_TICKS instead, below the low marks it goes back to
+ * interrupts. Rates are normalized to one interval.
+ *
+ * The poll timer is a jiffies timer, so the poll period is sized in
+ * ticks: one tick is the shortest period it can give, 1 to 10 ms
+ * depending on HZ. The ring has to absorb a tick's worth of rx, which
+ * at line rate a 512 entry ring only does for HZ of about 250 and up;
+ * this is why moderation is opt in (ce_intr_mod) and never applied to a
+ * CE that also carries HTC control traffic.
+ */
+#define CE_INTR_MOD_INTERVAL_MS   10
+#define CE_INTR_MOD_POLL_TICKS    1
+#define CE_INTR_MOD_HIGH_PKTS     256
+#define CE_INTR_MOD_LOW_PKTS      32
+#define CE_INTR_MOD_HIGH_BYTES    (256 * 1024)
+#define CE_INTR_MOD_LOW_BYTES     (32 * 1024)
+
+enum ce_intr_mod_mode {
+	CE_INTR_MOD_IMMEDIATE = 0,
+	CE_INTR_MOD_DEFERRED,
+};
+
+/**
+ * struct ce_intr_mod - adaptive interrupt moderation state of a CE
+ * @enabled: CE was created with CE_ATTR_INTR_MOD
+ * @mode: current mode
+ * @interval_start: start of the current sampling interval, in ticks
+ * @interval_pkts: completions seen in the current interval
+ * @interval_bytes: bytes completed in the current interval
+ * @last_pkts: normalized completions of the last interval
+ * @last_bytes: normalized bytes of the last interval
+ * @to_deferred: switches from interrupt to polled mode
+ * @to_immediate: switches from polled back to interrupt mode
+ * @polls: services run from the poll timer
+ * @timer: poll timer used in deferred mode
+ */
+struct ce_intr_mod {
+	bool enabled;
+	enum ce_intr_mod_mode mode;
+	qdf_time_t interval_start;
+	uint32_t interval_pkts;
+	uint32_t interval_bytes;
+	uint32_t last_pkts;
+	uint32_t last_bytes;
+	uint32_t to_deferred;
+	uint32_t to_immediate;
+	uint32_t polls;
+	qdf_timer_t timer;
+};
+
 /* Copy Engine internal state */
 struct CE_state {
 	struct hif_softc *scn;
@@ -148,6 +202,7 @@ struct CE_state {
 	bool htt_rx_data;
 	void (*lro_flush_cb)(void *);
 	void *lro_data;
+	struct ce_intr_mod intr_mod;
 };
 
 /* Descriptor rings must be aligned to this boundary */
@@ -353,6 +408,9 @@ enum hif_ce_event_type {
 };
 
 void ce_init_ce_desc_event_log(int ce_id, int size);
+void ce_deinit_ce_desc_event_log(int ce_id);
+void hif_ce_desc_history_debugfs_create(void);
+void hif_ce_desc_history_debugfs_remove(void);
 void hif_record_ce_desc_event(struct hif_softc *scn, int ce_id,
 			      enum hif_ce_event_type type,
 			      union ce_desc *descriptor, void *memory,
@@ -391,6 +449,9 @@ struct ce_sendlist_s {
 bool hif_ce_service_should_yield(struct hif_softc *scn, struct CE_state
 				 *ce_state);
 
+void ce_intr_mod_init(struct CE_state *CE_state);
+void ce_intr_mod_deinit(struct CE_state *CE_state);
+
 #ifdef WLAN_FEATURE_FASTPATH
 void ce_h2t_tx_ce_cleanup(struct CE_handle *ce_hdl);
 void ce_t2h_msg_ce_cleanup(struct CE_handle *ce_hdl);
@@ -57,6 +57,16 @@
 #define PCIE_ACCESS_DUMP 4
 #endif
 #include "mp_dev.h"
+#include "qdf_module.h"
+
+/*
+ * ce_intr_mod - adaptive interrupt moderation of the CEs flagged with
+ * CE_ATTR_INTR_MOD. Off by default: the deferred mode poll runs once a
+ * jiffy, which at low HZ is too slow to keep a 512 entry ring from
+ * overrunning at line rate.
+ */
+static int ce_intr_mod;
+qdf_declare_param(ce_intr_mod, int);
 
 /* Forward references */
 static int hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info);
@@ -950,6 +960,10 @@ struct CE_handle *ce_init(struct hif_softc *scn,
 	/* update the htt_data attribute */
 	ce_mark_datapath(CE_state);
 
+	if (ce_intr_mod && (CE_state->attr_flags & CE_ATTR_INTR_MOD) &&
+	    !CE_state->intr_mod.enabled)
+		ce_intr_mod_init(CE_state);
+
 	return (struct CE_handle *)CE_state;
 
 error_target_access:
@@ -1140,6 +1154,8 @@ void ce_fini(struct CE_handle *copyeng)
 
 	CE_state->state = CE_UNUSED;
 	scn->ce_id_to_state[CE_id] = NULL;
+	ce_intr_mod_deinit(CE_state);
+	ce_deinit_ce_desc_event_log(CE_id);
 	if (CE_state->src_ring) {
 		/* Cleanup the datapath Tx ring */
 		ce_h2t_tx_ce_cleanup(copyeng);
@@ -1566,16 +1582,80 @@ void hif_dump_pipe_debug_count(struct hif_softc *scn)
 			pipe_info->nbuf_alloc_err_count,
 			pipe_info->nbuf_dma_err_count,
 			pipe_info->nbuf_ce_enqueue_err_count);
+
+	if (pipe_info->recv_doorbell_count)
+		HIF_INFO("%s: pipe_id = %d, recv_bufs_posted = %u, recv_doorbells = %u, avg bufs per doorbell = %u",
+			 __func__, pipe_info->pipe_num,
+			 pipe_info->recv_bufs_posted_count,
+			 pipe_info->recv_doorbell_count,
+			 pipe_info->recv_bufs_posted_count /
+			 pipe_info->recv_doorbell_count);
 	}
 }
 
+/**
+ * hif_post_recv_buffers_batch() - post a batch of prepared rx buffers
+ * @pipe_info: pipe the buffers belong to
+ * @bufs: mapped buffers to post
+ * @num_bufs: number of entries in @bufs
+ *
+ * Posts the batch with a single destination ring write index update.
+ * Buffers the copy engine did not accept are unmapped, freed and
+ * given back to recv_bufs_needed.
+ *
+ * Return: number of buffers posted
+ */
+static uint32_t hif_post_recv_buffers_batch(struct HIF_CE_pipe_info *pipe_info,
+					    struct ce_recv_buf *bufs,
+					    uint32_t num_bufs)
+{
+	struct hif_softc *scn = HIF_GET_SOFTC(pipe_info->HIF_CE_state);
+	uint32_t num_posted;
+	uint32_t i;
+	int status;
+
+	status = ce_recv_buf_enqueue_multiple(pipe_info->ce_hdl, bufs,
+					      num_bufs);
+	num_posted = (status > 0) ? status : 0;
+	QDF_ASSERT(num_posted == num_bufs);
+
+	qdf_spin_lock_bh(&pipe_info->recv_bufs_needed_lock);
+	if (num_posted) {
+		pipe_info->recv_doorbell_count++;
+		pipe_info->recv_bufs_posted_count += num_posted;
+	}
+	if (num_posted != num_bufs)
+		pipe_info->nbuf_ce_enqueue_err_count++;
+	qdf_spin_unlock_bh(&pipe_info->recv_bufs_needed_lock);
+
+	if (num_posted == num_bufs)
+		return num_posted;
+
+	HIF_ERROR("%s buf enqueue error [%d] posted %u of %u, nbuf_ce_enqueue_err_count = %u",
+		  __func__, pipe_info->pipe_num, num_posted, num_bufs,
+		  pipe_info->nbuf_ce_enqueue_err_count);
+
+	for (i = num_posted; i < num_bufs; i++) {
+		qdf_nbuf_t nbuf = bufs[i].per_transfer_recv_context;
+
+		qdf_nbuf_unmap_single(scn->qdf_dev, nbuf, QDF_DMA_FROM_DEVICE);
+		qdf_nbuf_free(nbuf);
+		atomic_inc(&pipe_info->recv_bufs_needed);
+	}
+
+	return num_posted;
+}
+
 static int hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info)
 {
-	struct CE_handle *ce_hdl;
 	qdf_size_t buf_sz;
 	struct hif_softc *scn = HIF_GET_SOFTC(pipe_info->HIF_CE_state);
 	QDF_STATUS ret;
 	uint32_t bufs_posted = 0;
+	struct ce_recv_buf bufs[HIF_RX_POST_BATCH_SIZE];
+	uint32_t num_bufs = 0;
+	uint32_t num_posted;
+	int rv = 0;
 
 	buf_sz = pipe_info->buf_sz;
 	if (buf_sz == 0) {
@@ -1583,13 +1663,10 @@ static int hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info)
 		return 0;
 	}
 
-	ce_hdl = pipe_info->ce_hdl;
-
 	qdf_spin_lock_bh(&pipe_info->recv_bufs_needed_lock);
 	while (atomic_read(&pipe_info->recv_bufs_needed) > 0) {
 		qdf_dma_addr_t CE_data;      /* CE space buffer address */
 		qdf_nbuf_t nbuf;
-		int status;
 
 		atomic_dec(&pipe_info->recv_bufs_needed);
 		qdf_spin_unlock_bh(&pipe_info->recv_bufs_needed_lock);
@@ -1606,7 +1683,8 @@ static int hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info)
 				 atomic_read(&pipe_info->recv_bufs_needed),
 				pipe_info->nbuf_alloc_err_count);
 			atomic_inc(&pipe_info->recv_bufs_needed);
-			return 1;
+			rv = 1;
+			goto flush;
 		}
 
 		/*
@@ -1629,32 +1707,46 @@ static int hif_post_recv_buffers_for_pipe(struct HIF_CE_pipe_info *pipe_info)
 				pipe_info->nbuf_dma_err_count);
 			qdf_nbuf_free(nbuf);
 			atomic_inc(&pipe_info->recv_bufs_needed);
-			return 1;
+			rv = 1;
+			goto flush;
 		}
 
 		CE_data = qdf_nbuf_get_frag_paddr(nbuf, 0);
 
 		qdf_mem_dma_sync_single_for_device(scn->qdf_dev, CE_data,
 					       buf_sz, DMA_FROM_DEVICE);
-		status = ce_recv_buf_enqueue(ce_hdl, (void *)nbuf, CE_data);
-		QDF_ASSERT(status == QDF_STATUS_SUCCESS);
-		if (status != EOK) {
-			qdf_spin_lock_bh(&pipe_info->recv_bufs_needed_lock);
-			pipe_info->nbuf_ce_enqueue_err_count++;
-			qdf_spin_unlock_bh(&pipe_info->recv_bufs_needed_lock);
-			HIF_ERROR(
-				"%s buf alloc error [%d] needed %d, nbuf_alloc_err_count = %u",
-				__func__, pipe_info->pipe_num,
-				atomic_read(&pipe_info->recv_bufs_needed),
-				pipe_info->nbuf_ce_enqueue_err_count);
-			atomic_inc(&pipe_info->recv_bufs_needed);
-			qdf_nbuf_free(nbuf);
-			return 1;
+
+		bufs[num_bufs].per_transfer_recv_context = nbuf;
+		bufs[num_bufs].buffer = CE_data;
+		num_bufs++;
+
+		if (num_bufs == HIF_RX_POST_BATCH_SIZE) {
+			num_posted = hif_post_recv_buffers_batch(pipe_info,
+								 bufs,
+								 num_bufs);
+			bufs_posted += num_posted;
+			if (num_posted != num_bufs)
+				return 1;
+			num_bufs = 0;
 		}
 
 		qdf_spin_lock_bh(&pipe_info->recv_bufs_needed_lock);
-		bufs_posted++;
 	}
+	qdf_spin_unlock_bh(&pipe_info->recv_bufs_needed_lock);
+
+flush:
+	if (num_bufs) {
+		num_posted = hif_post_recv_buffers_batch(pipe_info, bufs,
+							 num_bufs);
+		bufs_posted += num_posted;
+		if (num_posted != num_bufs)
+			return 1;
+	}
+
+	if (rv)
+		return rv;
+
+	qdf_spin_lock_bh(&pipe_info->recv_bufs_needed_lock);
 	pipe_info->nbuf_alloc_err_count =
 		(pipe_info->nbuf_alloc_err_count > bufs_posted) ?
 		pipe_info->nbuf_alloc_err_count - bufs_posted : 0;
@@ -2039,6 +2131,7 @@ QDF_STATUS hif_ce_open(struct hif_softc *hif_sc)
 	struct HIF_CE_state *hif_state = HIF_GET_CE_STATE(hif_sc);
 
 	qdf_spinlock_create(&hif_state->keep_awake_lock);
+	hif_ce_desc_history_debugfs_create();
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -2048,6 +2141,7 @@ QDF_STATUS hif_ce_open(struct hif_softc *hif_sc)
  */
 void hif_ce_close(struct hif_softc *hif_sc)
 {
+	hif_ce_desc_history_debugfs_remove();
 }
 
 /**
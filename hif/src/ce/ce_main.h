@@ -94,8 +94,15 @@ struct HIF_CE_pipe_info {
 	uint32_t nbuf_alloc_err_count;
 	uint32_t nbuf_dma_err_count;
 	uint32_t nbuf_ce_enqueue_err_count;
+
+	/* batched rx refill: descriptors posted vs. write index updates */
+	uint32_t recv_bufs_posted_count;
+	uint32_t recv_doorbell_count;
 };
 
+/* max rx buffers posted to a destination ring per write index update */
+#define HIF_RX_POST_BATCH_SIZE 32
+
 /**
  * struct ce_tasklet_entry
  *
@@ -35,6 +35,10 @@
 #include "regtable.h"
 #include "hif_main.h"
 #include "hif_debug.h"
+#include "ce_tasklet.h"
+#include <linux/debugfs.h>
+#include <linux/vmalloc.h>
+#include <linux/mutex.h>
 
 #ifdef IPA_OFFLOAD
 #ifdef QCA_WIFI_3_0
@@ -104,36 +108,27 @@ struct hif_ce_desc_event {
 	uint64_t time;
 	union ce_desc descriptor;
 	void *memory;
-};
-
-/* max history to record per copy engine */
-#define HIF_CE_HISTORY_MAX 512
-qdf_atomic_t hif_ce_desc_history_index[CE_COUNT_MAX];
-struct hif_ce_desc_event hif_ce_desc_history[CE_COUNT_MAX][HIF_CE_HISTORY_MAX];
+} ____cacheline_aligned;
 
+/* min and max history to record per copy engine */
+#define HIF_CE_HISTORY_MIN 512
+#define HIF_CE_HISTORY_MAX 8192
 
 /**
- * get_next_record_index() - get the next record index
- * @table_index: atomic index variable to increment
- * @array_size: array size of the circular buffer
- *
- * Increment the atomic index and reserve the value.
- * Takes care of buffer wrap.
- * Guaranteed to be thread safe as long as fewer than array_size contexts
- * try to access the array.  If there are more than array_size contexts
- * trying to access the array, full locking of the recording process would
- * be needed to have sane logging.
+ * struct hif_ce_desc_history - event history of one copy engine
+ * @events: ring of @size events, NULL when not allocated
+ * @size: number of events in the ring, a power of two
+ * @index: free running count of recorded events
  */
-static int get_next_record_index(qdf_atomic_t *table_index, int array_size)
-{
-	int record_index = qdf_atomic_inc_return(table_index);
-	if (record_index == array_size)
-		qdf_atomic_sub(array_size, table_index);
+struct hif_ce_desc_history {
+	struct hif_ce_desc_event *events;
+	uint32_t size;
+	qdf_atomic_t index;
+};
 
-	while (record_index >= array_size)
-		record_index -= array_size;
-	return record_index;
-}
+static struct hif_ce_desc_history hif_ce_desc_history[CE_COUNT_MAX];
+/* serializes allocating and freeing the rings against the debugfs export */
+static DEFINE_MUTEX(hif_ce_desc_history_lock);
 
 /**
  * hif_record_ce_desc_event() - record ce descriptor events
@@ -143,17 +138,24 @@ static int get_next_record_index(qdf_atomic_t *table_index, int array_size)
  * @descriptor: pointer to the descriptor posted/completed
  * @memory: virtual address of buffer related to the descriptor
  * @index: index that the descriptor was/will be at.
+ *
+ * Lock free: each caller reserves its own slot by bumping the ring index.
  */
 void hif_record_ce_desc_event(struct hif_softc *scn, int ce_id,
 				enum hif_ce_event_type type,
 				union ce_desc *descriptor,
 				void *memory, int index)
 {
-	int record_index = get_next_record_index(
-			&hif_ce_desc_history_index[ce_id], HIF_CE_HISTORY_MAX);
+	struct hif_ce_desc_history *history = &hif_ce_desc_history[ce_id];
+	struct hif_ce_desc_event *event;
+	uint32_t record_index;
+
+	if (!history->events)
+		return;
 
-	struct hif_ce_desc_event *event =
-		&hif_ce_desc_history[ce_id][record_index];
+	record_index = (uint32_t)qdf_atomic_inc_return(&history->index) &
+		       (history->size - 1);
+	event = &history->events[record_index];
 	event->type = type;
 	event->time = qdf_get_log_timestamp();
 
@@ -165,18 +167,257 @@ void hif_record_ce_desc_event(struct hif_softc *scn, int ce_id,
 	event->index = index;
 }
 
+/**
+ * __ce_deinit_ce_desc_event_log() - free a ce event log
+ * @history: history to free, with hif_ce_desc_history_lock held
+ */
+static void __ce_deinit_ce_desc_event_log(struct hif_ce_desc_history *history)
+{
+	struct hif_ce_desc_event *events = history->events;
+
+	history->events = NULL;
+	history->size = 0;
+	if (events)
+		qdf_mem_free(events);
+}
+
 /**
  * ce_init_ce_desc_event_log() - initialize the ce event log
  * @ce_id: copy engine id for which we are initializing the log
- * @size: size of array to dedicate
+ * @size: number of descriptors in the copy engine rings
  *
- * Currently the passed size is ignored in favor of a precompiled value.
+ * Two events are kept per descriptor, rounded up to a power of two and
+ * clamped to [HIF_CE_HISTORY_MIN, HIF_CE_HISTORY_MAX]. A smaller ring
+ * is tried if the allocation fails.
  */
 void ce_init_ce_desc_event_log(int ce_id, int size)
 {
-	qdf_atomic_init(&hif_ce_desc_history_index[ce_id]);
+	struct hif_ce_desc_history *history = &hif_ce_desc_history[ce_id];
+	uint32_t entries;
+
+	entries = roundup_pow_of_two(QDF_MAX(2 * size, HIF_CE_HISTORY_MIN));
+	entries = QDF_MIN(entries, (uint32_t)HIF_CE_HISTORY_MAX);
+
+	mutex_lock(&hif_ce_desc_history_lock);
+	if (history->events && history->size == entries) {
+		qdf_atomic_init(&history->index);
+		goto out;
+	}
+	__ce_deinit_ce_desc_event_log(history);
+
+	for (; entries >= HIF_CE_HISTORY_MIN; entries >>= 1) {
+		history->events = qdf_mem_malloc(entries *
+					sizeof(struct hif_ce_desc_event));
+		if (history->events)
+			break;
+	}
+	if (!history->events) {
+		HIF_ERROR("%s: CE%d no memory for history", __func__, ce_id);
+		goto out;
+	}
+
+	history->size = entries;
+	qdf_atomic_init(&history->index);
+out:
+	mutex_unlock(&hif_ce_desc_history_lock);
+}
+
+/**
+ * ce_deinit_ce_desc_event_log() - free the ce event log
+ * @ce_id: copy engine id whose log is freed
+ *
+ * The copy engine no longer records by now; the lock keeps a debugfs
+ * export from reading the ring while it is freed.
+ */
+void ce_deinit_ce_desc_event_log(int ce_id)
+{
+	mutex_lock(&hif_ce_desc_history_lock);
+	__ce_deinit_ce_desc_event_log(&hif_ce_desc_history[ce_id]);
+	mutex_unlock(&hif_ce_desc_history_lock);
+}
+
+#ifdef WLAN_OPEN_SOURCE
+/**
+ * struct hif_ce_desc_export_hdr - header of the binary history export
+ * @magic: HIF_CE_DESC_EXPORT_MAGIC
+ * @version: HIF_CE_DESC_EXPORT_VERSION
+ * @rec_size: size of one struct hif_ce_desc_export_rec
+ * @num_recs: number of records following the header
+ * @reserved: zero
+ *
+ * Records of one copy engine are contiguous and oldest first; user space
+ * merges the engines by @time to follow a buffer from post through ring
+ * index update and completion to the NAPI poll that handled it.
+ */
+struct hif_ce_desc_export_hdr {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t rec_size;
+	uint32_t num_recs;
+	uint32_t reserved;
+};
+
+/**
+ * struct hif_ce_desc_export_rec - one exported ce event
+ * @time: qdf_get_log_timestamp() of the event
+ * @index: ring index of the descriptor
+ * @type: enum hif_ce_event_type
+ * @ce_id: copy engine id
+ * @reserved: zero
+ * @desc: raw descriptor words, zero padded
+ */
+struct hif_ce_desc_export_rec {
+	uint64_t time;
+	uint16_t index;
+	uint8_t type;
+	uint8_t ce_id;
+	uint32_t reserved;
+	uint32_t desc[4];
+};
+
+#define HIF_CE_DESC_EXPORT_MAGIC   0x48444543 /* "CEDH" */
+#define HIF_CE_DESC_EXPORT_VERSION 1
+
+/**
+ * struct hif_ce_desc_export - snapshot handed to one debugfs reader
+ * @len: bytes in @data
+ * @data: header followed by the records
+ */
+struct hif_ce_desc_export {
+	size_t len;
+	uint8_t data[];
+};
+
+static struct dentry *hif_ce_desc_history_dentry;
+
+/**
+ * hif_ce_desc_history_open() - snapshot the histories for a reader
+ * @inode: debugfs inode
+ * @file: file being opened
+ *
+ * Return: 0 or -ENOMEM
+ */
+static int hif_ce_desc_history_open(struct inode *inode, struct file *file)
+{
+	struct hif_ce_desc_export *export;
+	struct hif_ce_desc_export_hdr *hdr;
+	struct hif_ce_desc_export_rec *rec;
+	uint32_t num_recs = 0, count, n, i;
+	int ce_id;
+
+	mutex_lock(&hif_ce_desc_history_lock);
+	for (ce_id = 0; ce_id < CE_COUNT_MAX; ce_id++) {
+		struct hif_ce_desc_history *history =
+			&hif_ce_desc_history[ce_id];
+
+		if (!history->events)
+			continue;
+		count = (uint32_t)qdf_atomic_read(&history->index);
+		num_recs += QDF_MIN(count, history->size);
+	}
+
+	export = vzalloc(sizeof(*export) + sizeof(*hdr) +
+			 num_recs * sizeof(*rec));
+	if (!export) {
+		mutex_unlock(&hif_ce_desc_history_lock);
+		return -ENOMEM;
+	}
+
+	hdr = (struct hif_ce_desc_export_hdr *)export->data;
+	rec = (struct hif_ce_desc_export_rec *)(hdr + 1);
+	hdr->magic = HIF_CE_DESC_EXPORT_MAGIC;
+	hdr->version = HIF_CE_DESC_EXPORT_VERSION;
+	hdr->rec_size = sizeof(*rec);
+
+	for (ce_id = 0; ce_id < CE_COUNT_MAX; ce_id++) {
+		struct hif_ce_desc_history *history =
+			&hif_ce_desc_history[ce_id];
+
+		if (!history->events)
+			continue;
+		count = (uint32_t)qdf_atomic_read(&history->index);
+		n = QDF_MIN(count, history->size);
+		/* never export more than was counted above */
+		n = QDF_MIN(n, num_recs - hdr->num_recs);
+		for (i = count - n + 1; n; i++, n--, rec++) {
+			struct hif_ce_desc_event *event =
+				&history->events[i & (history->size - 1)];
+
+			rec->time = event->time;
+			rec->index = event->index;
+			rec->type = event->type;
+			rec->ce_id = ce_id;
+			qdf_mem_copy(rec->desc, &event->descriptor,
+				     QDF_MIN(sizeof(rec->desc),
+					     sizeof(event->descriptor)));
+			hdr->num_recs++;
+		}
+	}
+	mutex_unlock(&hif_ce_desc_history_lock);
+
+	export->len = sizeof(*hdr) + hdr->num_recs * sizeof(*rec);
+	file->private_data = export;
+
+	return 0;
+}
+
+static ssize_t hif_ce_desc_history_read(struct file *file, char __user *buf,
+					size_t count, loff_t *ppos)
+{
+	struct hif_ce_desc_export *export = file->private_data;
+
+	return simple_read_from_buffer(buf, count, ppos, export->data,
+				       export->len);
+}
+
+static int hif_ce_desc_history_release(struct inode *inode, struct file *file)
+{
+	vfree(file->private_data);
+	return 0;
+}
+
+static const struct file_operations hif_ce_desc_history_fops = {
+	.owner          = THIS_MODULE,
+	.open           = hif_ce_desc_history_open,
+	.read           = hif_ce_desc_history_read,
+	.release        = hif_ce_desc_history_release,
+	.llseek         = default_llseek,
+};
+
+/**
+ * hif_ce_desc_history_debugfs_create() - create the history export entry
+ *
+ * Exposes the per copy engine event histories as a binary snapshot in
+ * debugfs "ce_desc_history".
+ */
+void hif_ce_desc_history_debugfs_create(void)
+{
+	if (hif_ce_desc_history_dentry)
+		return;
+
+	hif_ce_desc_history_dentry =
+		debugfs_create_file("ce_desc_history", S_IRUSR, NULL, NULL,
+				    &hif_ce_desc_history_fops);
+}
+
+/**
+ * hif_ce_desc_history_debugfs_remove() - remove the history export entry
+ */
+void hif_ce_desc_history_debugfs_remove(void)
+{
+	debugfs_remove(hif_ce_desc_history_dentry);
+	hif_ce_desc_history_dentry = NULL;
 }
 #else
+void hif_ce_desc_history_debugfs_create(void)
+{
+}
+
+void hif_ce_desc_history_debugfs_remove(void)
+{
+}
+#endif /* WLAN_OPEN_SOURCE */
+#else
 void hif_record_ce_desc_event(struct hif_softc *scn,
 		int ce_id, enum hif_ce_event_type type,
 		union ce_desc *descriptor, void *memory,
@@ -187,6 +428,18 @@ void hif_record_ce_desc_event(struct hif_softc *scn,
 inline void ce_init_ce_desc_event_log(int ce_id, int size)
 {
 }
+
+void ce_deinit_ce_desc_event_log(int ce_id)
+{
+}
+
+void hif_ce_desc_history_debugfs_create(void)
+{
+}
+
+void hif_ce_desc_history_debugfs_remove(void)
+{
+}
 #endif
 
 /**
@@ -536,6 +789,143 @@ ce_buffer_addr_hi_set(struct CE_src_desc *shadow_src_desc,
 
 #define SLOTS_PER_DATAPATH_TX 2
 
+/**
+ * ce_send_fast_fill_desc() - fill the source descriptor pair for one msdu
+ * @ce_state: copy engine state
+ * @msdu: msdu to be sent
+ * @write_index: ring index of the first descriptor of the pair
+ * @transfer_id: transfer_id
+ * @download_len: packet download length
+ *
+ * Fills the HTC/HTT header and payload descriptors for @msdu.  Must be
+ * called with ce_index_lock held and SLOTS_PER_DATAPATH_TX free entries
+ * in the source ring.  The hardware write index is not updated.
+ *
+ * Return: ring index following the descriptor pair
+ */
+static inline unsigned int
+ce_send_fast_fill_desc(struct CE_state *ce_state, qdf_nbuf_t msdu,
+		       unsigned int write_index, unsigned int transfer_id,
+		       uint32_t download_len)
+{
+	struct CE_ring_state *src_ring = ce_state->src_ring;
+	unsigned int nentries_mask = src_ring->nentries_mask;
+	struct CE_src_desc *src_ring_base =
+		(struct CE_src_desc *)src_ring->base_addr_owner_space;
+	struct CE_src_desc *shadow_base =
+		(struct CE_src_desc *)src_ring->shadow_base;
+	struct CE_src_desc *src_desc =
+		CE_SRC_RING_TO_DESC(src_ring_base, write_index);
+	struct CE_src_desc *shadow_src_desc =
+		CE_SRC_RING_TO_DESC(shadow_base, write_index);
+	unsigned int frag_len;
+	uint64_t dma_addr;
+	uint32_t user_flags;
+
+	hif_pm_runtime_get_noresume(GET_HIF_OPAQUE_HDL(ce_state->scn));
+
+	/*
+	 * First fill out the ring descriptor for the HTC HTT frame
+	 * header. These are uncached writes. Should we use a local
+	 * structure instead?
+	 */
+	/* HTT/HTC header can be passed as a argument */
+	dma_addr = qdf_nbuf_get_frag_paddr(msdu, 0);
+	shadow_src_desc->buffer_addr = (uint32_t)(dma_addr &
+						  0xFFFFFFFF);
+	user_flags = qdf_nbuf_data_attr_get(msdu) & DESC_DATA_FLAG_MASK;
+	ce_buffer_addr_hi_set(shadow_src_desc, dma_addr, user_flags);
+	shadow_src_desc->meta_data = transfer_id;
+	shadow_src_desc->nbytes = qdf_nbuf_get_frag_len(msdu, 0);
+	download_len -= shadow_src_desc->nbytes;
+	/*
+	 * HTC HTT header is a word stream, so byte swap if CE byte
+	 * swap enabled
+	 */
+	shadow_src_desc->byte_swap = ((ce_state->attr_flags &
+				CE_ATTR_BYTE_SWAP_DATA) != 0);
+	/* For the first one, it still does not need to write */
+	shadow_src_desc->gather = 1;
+	*src_desc = *shadow_src_desc;
+	/* By default we could initialize the transfer context to this
+	 * value
+	 */
+	src_ring->per_transfer_context[write_index] =
+		CE_SENDLIST_ITEM_CTXT;
+	write_index = CE_RING_IDX_INCR(nentries_mask, write_index);
+
+	src_desc = CE_SRC_RING_TO_DESC(src_ring_base, write_index);
+	shadow_src_desc = CE_SRC_RING_TO_DESC(shadow_base, write_index);
+	/*
+	 * Now fill out the ring descriptor for the actual data
+	 * packet
+	 */
+	dma_addr = qdf_nbuf_get_frag_paddr(msdu, 1);
+	shadow_src_desc->buffer_addr = (uint32_t)(dma_addr &
+						  0xFFFFFFFF);
+	/*
+	 * Clear packet offset for all but the first CE desc.
+	 */
+	user_flags &= ~QDF_CE_TX_PKT_OFFSET_BIT_M;
+	ce_buffer_addr_hi_set(shadow_src_desc, dma_addr, user_flags);
+	shadow_src_desc->meta_data = transfer_id;
+
+	/* get actual packet length */
+	frag_len = qdf_nbuf_get_frag_len(msdu, 1);
+
+	/* download remaining bytes of payload */
+	shadow_src_desc->nbytes =  download_len;
+	if (shadow_src_desc->nbytes > frag_len)
+		shadow_src_desc->nbytes = frag_len;
+
+	/*  Data packet is a byte stream, so disable byte swap */
+	shadow_src_desc->byte_swap = 0;
+	/* For the last one, gather is not set */
+	shadow_src_desc->gather    = 0;
+	*src_desc = *shadow_src_desc;
+	src_ring->per_transfer_context[write_index] = msdu;
+	write_index = CE_RING_IDX_INCR(nentries_mask, write_index);
+
+	DPTRACE(qdf_dp_trace(msdu,
+		QDF_DP_TRACE_CE_FAST_PACKET_PTR_RECORD,
+		qdf_nbuf_data_addr(msdu),
+		sizeof(qdf_nbuf_data(msdu)), QDF_TX));
+
+	return write_index;
+}
+
+/**
+ * ce_send_fast_write_idx_update() - publish the source ring write index
+ * @ce_state: copy engine state
+ * @write_index: new write index
+ *
+ * Must be called with ce_index_lock held.
+ *
+ * Return: None
+ */
+static inline void
+ce_send_fast_write_idx_update(struct CE_state *ce_state,
+			      unsigned int write_index)
+{
+	struct hif_softc *scn = ce_state->scn;
+	struct hif_opaque_softc *hif_hdl = GET_HIF_OPAQUE_HDL(scn);
+
+	ce_state->src_ring->write_index = write_index;
+
+	if (hif_pm_runtime_get(hif_hdl) == 0) {
+		hif_record_ce_desc_event(scn, ce_state->id,
+					 FAST_TX_WRITE_INDEX_UPDATE,
+					 NULL, NULL, write_index);
+
+		/* Don't call WAR_XXX from here
+		 * Just call XXX instead, that has the reqd. intel
+		 */
+		war_ce_src_ring_write_idx_set(scn, ce_state->ctrl_addr,
+				write_index);
+		hif_pm_runtime_put(hif_hdl);
+	}
+}
+
 /**
  * ce_send_fast() CE layer Tx buffer posting function
  * @copyeng: copy engine handle
@@ -543,9 +933,7 @@ ce_buffer_addr_hi_set(struct CE_src_desc *shadow_src_desc,
  * @transfer_id: transfer_id
  * @download_len: packet download length
  *
- * Assumption : Called with an array of MSDU's
  * Function:
- * For each msdu in the array
  * 1. Check no. of available entries
  * 2. Create src ring entries (allocated in consistent memory
  * 3. Write index to h/w
@@ -557,15 +945,11 @@ int ce_send_fast(struct CE_handle *copyeng, qdf_nbuf_t msdu,
 {
 	struct CE_state *ce_state = (struct CE_state *)copyeng;
 	struct hif_softc *scn = ce_state->scn;
-	struct hif_opaque_softc *hif_hdl = GET_HIF_OPAQUE_HDL(scn);
 	struct CE_ring_state *src_ring = ce_state->src_ring;
 	u_int32_t ctrl_addr = ce_state->ctrl_addr;
 	unsigned int nentries_mask = src_ring->nentries_mask;
 	unsigned int write_index;
 	unsigned int sw_index;
-	unsigned int frag_len;
-	uint64_t dma_addr;
-	uint32_t user_flags;
 
 	qdf_spin_lock_bh(&ce_state->ce_index_lock);
 	Q_TARGET_ACCESS_BEGIN(scn);
@@ -589,107 +973,87 @@ int ce_send_fast(struct CE_handle *copyeng, qdf_nbuf_t msdu,
 		return 0;
 	}
 
-	{
-		struct CE_src_desc *src_ring_base =
-			(struct CE_src_desc *)src_ring->base_addr_owner_space;
-		struct CE_src_desc *shadow_base =
-			(struct CE_src_desc *)src_ring->shadow_base;
-		struct CE_src_desc *src_desc =
-			CE_SRC_RING_TO_DESC(src_ring_base, write_index);
-		struct CE_src_desc *shadow_src_desc =
-			CE_SRC_RING_TO_DESC(shadow_base, write_index);
-
-		hif_pm_runtime_get_noresume(hif_hdl);
-
-		/*
-		 * First fill out the ring descriptor for the HTC HTT frame
-		 * header. These are uncached writes. Should we use a local
-		 * structure instead?
-		 */
-		/* HTT/HTC header can be passed as a argument */
-		dma_addr = qdf_nbuf_get_frag_paddr(msdu, 0);
-		shadow_src_desc->buffer_addr = (uint32_t)(dma_addr &
-							  0xFFFFFFFF);
-		user_flags = qdf_nbuf_data_attr_get(msdu) & DESC_DATA_FLAG_MASK;
-		ce_buffer_addr_hi_set(shadow_src_desc, dma_addr, user_flags);
-			shadow_src_desc->meta_data = transfer_id;
-		shadow_src_desc->nbytes = qdf_nbuf_get_frag_len(msdu, 0);
-		download_len -= shadow_src_desc->nbytes;
-		/*
-		 * HTC HTT header is a word stream, so byte swap if CE byte
-		 * swap enabled
-		 */
-		shadow_src_desc->byte_swap = ((ce_state->attr_flags &
-					CE_ATTR_BYTE_SWAP_DATA) != 0);
-		/* For the first one, it still does not need to write */
-		shadow_src_desc->gather = 1;
-		*src_desc = *shadow_src_desc;
-		/* By default we could initialize the transfer context to this
-		 * value
-		 */
-		src_ring->per_transfer_context[write_index] =
-			CE_SENDLIST_ITEM_CTXT;
-		write_index = CE_RING_IDX_INCR(nentries_mask, write_index);
+	write_index = ce_send_fast_fill_desc(ce_state, msdu, write_index,
+					     transfer_id, download_len);
+	ce_send_fast_write_idx_update(ce_state, write_index);
 
-		src_desc = CE_SRC_RING_TO_DESC(src_ring_base, write_index);
-		shadow_src_desc = CE_SRC_RING_TO_DESC(shadow_base, write_index);
-		/*
-		 * Now fill out the ring descriptor for the actual data
-		 * packet
-		 */
-		dma_addr = qdf_nbuf_get_frag_paddr(msdu, 1);
-		shadow_src_desc->buffer_addr = (uint32_t)(dma_addr &
-							  0xFFFFFFFF);
-		/*
-		 * Clear packet offset for all but the first CE desc.
-		 */
-		user_flags &= ~QDF_CE_TX_PKT_OFFSET_BIT_M;
-		ce_buffer_addr_hi_set(shadow_src_desc, dma_addr, user_flags);
-		shadow_src_desc->meta_data = transfer_id;
+	Q_TARGET_ACCESS_END(scn);
+	qdf_spin_unlock_bh(&ce_state->ce_index_lock);
 
-		/* get actual packet length */
-		frag_len = qdf_nbuf_get_frag_len(msdu, 1);
+	/* sent 1 packet */
+	return 1;
+}
 
-		/* download remaining bytes of payload */
-		shadow_src_desc->nbytes =  download_len;
-		if (shadow_src_desc->nbytes > frag_len)
-			shadow_src_desc->nbytes = frag_len;
+/**
+ * ce_send_fast_multiple() - CE layer Tx posting for an array of msdus
+ * @copyeng: copy engine handle
+ * @msdus: array of msdus to be sent
+ * @num_msdus: number of msdus in @msdus
+ * @transfer_id: transfer_id
+ * @download_len: packet download length
+ *
+ * Reserves SLOTS_PER_DATAPATH_TX source descriptors for as many msdus as
+ * the ring has room for, fills them under a single hold of
+ * ce_index_lock and writes the source ring write index once for the
+ * whole array.  Msdus are accepted in array order.
+ *
+ * Return: No. of packets that could be sent; the caller owns and must
+ *	   requeue msdus[ret..num_msdus - 1]
+ */
+int ce_send_fast_multiple(struct CE_handle *copyeng, qdf_nbuf_t *msdus,
+			  unsigned int num_msdus, unsigned int transfer_id,
+			  uint32_t download_len)
+{
+	struct CE_state *ce_state = (struct CE_state *)copyeng;
+	struct hif_softc *scn = ce_state->scn;
+	struct CE_ring_state *src_ring = ce_state->src_ring;
+	u_int32_t ctrl_addr = ce_state->ctrl_addr;
+	unsigned int nentries_mask = src_ring->nentries_mask;
+	unsigned int write_index;
+	unsigned int sw_index;
+	unsigned int num_sent;
+	unsigned int i;
 
-		/*  Data packet is a byte stream, so disable byte swap */
-		shadow_src_desc->byte_swap = 0;
-		/* For the last one, gather is not set */
-		shadow_src_desc->gather    = 0;
-		*src_desc = *shadow_src_desc;
-		src_ring->per_transfer_context[write_index] = msdu;
-		write_index = CE_RING_IDX_INCR(nentries_mask, write_index);
+	if (qdf_unlikely(num_msdus == 0))
+		return 0;
 
-		DPTRACE(qdf_dp_trace(msdu,
-			QDF_DP_TRACE_CE_FAST_PACKET_PTR_RECORD,
-			qdf_nbuf_data_addr(msdu),
-			sizeof(qdf_nbuf_data(msdu)), QDF_TX));
-	}
+	qdf_spin_lock_bh(&ce_state->ce_index_lock);
+	Q_TARGET_ACCESS_BEGIN(scn);
 
-	src_ring->write_index = write_index;
+	src_ring->sw_index = CE_SRC_RING_READ_IDX_GET_FROM_DDR(scn, ctrl_addr);
+	write_index = src_ring->write_index;
+	sw_index = src_ring->sw_index;
 
-	if (hif_pm_runtime_get(hif_hdl) == 0) {
-		hif_record_ce_desc_event(scn, ce_state->id,
-					 FAST_TX_WRITE_INDEX_UPDATE,
-					 NULL, NULL, write_index);
+	hif_record_ce_desc_event(scn, ce_state->id,
+				FAST_TX_SOFTWARE_INDEX_UPDATE,
+				NULL, NULL, write_index);
 
-		/* Don't call WAR_XXX from here
-		 * Just call XXX instead, that has the reqd. intel
-		 */
-		war_ce_src_ring_write_idx_set(scn, ctrl_addr,
-				write_index);
-		hif_pm_runtime_put(hif_hdl);
+	num_sent = CE_RING_DELTA(nentries_mask, write_index, sw_index - 1) /
+		   SLOTS_PER_DATAPATH_TX;
+	if (qdf_unlikely(num_sent == 0)) {
+		HIF_ERROR("Source ring full, required %d, available %d",
+		      SLOTS_PER_DATAPATH_TX,
+		      CE_RING_DELTA(nentries_mask, write_index, sw_index - 1));
+		OL_ATH_CE_PKT_ERROR_COUNT_INCR(scn, CE_RING_DELTA_FAIL);
+		Q_TARGET_ACCESS_END(scn);
+		qdf_spin_unlock_bh(&ce_state->ce_index_lock);
+		return 0;
 	}
+	if (num_sent > num_msdus)
+		num_sent = num_msdus;
 
+	for (i = 0; i < num_sent; i++)
+		write_index = ce_send_fast_fill_desc(ce_state, msdus[i],
+						     write_index, transfer_id,
+						     download_len);
+
+	/* One doorbell for all the msdus accepted */
+	ce_send_fast_write_idx_update(ce_state, write_index);
 
 	Q_TARGET_ACCESS_END(scn);
 	qdf_spin_unlock_bh(&ce_state->ce_index_lock);
 
-	/* sent 1 packet */
-	return 1;
+	return num_sent;
 }
 
 /**
@@ -994,6 +1358,97 @@ ce_recv_buf_enqueue(struct CE_handle *copyeng,
 	return status;
 }
 
+/**
+ * ce_recv_buf_enqueue_multiple() - enqueue a batch of recv buffers
+ * @copyeng: copy engine handle
+ * @bufs: array of (context, physical address) pairs to post
+ * @num_bufs: number of entries in @bufs
+ *
+ * Fills as many destination descriptors as there is room for under a
+ * single hold of ce_index_lock and writes the destination ring write
+ * index once, instead of once per buffer as ce_recv_buf_enqueue() does.
+ *
+ * Return: number of buffers posted from the head of @bufs,
+ *	   -EIO if the target could not be accessed
+ */
+int
+ce_recv_buf_enqueue_multiple(struct CE_handle *copyeng,
+			     struct ce_recv_buf *bufs,
+			     unsigned int num_bufs)
+{
+	struct CE_state *CE_state = (struct CE_state *)copyeng;
+	struct CE_ring_state *dest_ring = CE_state->dest_ring;
+	uint32_t ctrl_addr = CE_state->ctrl_addr;
+	unsigned int nentries_mask = dest_ring->nentries_mask;
+	struct CE_dest_desc *dest_ring_base =
+		(struct CE_dest_desc *)dest_ring->base_addr_owner_space;
+	unsigned int write_index;
+	unsigned int sw_index;
+	unsigned int num_posted = 0;
+	bool ring_always_open;
+	struct hif_softc *scn = CE_state->scn;
+
+	if (num_bufs == 0)
+		return 0;
+
+	ring_always_open = ce_is_fastpath_enabled(scn) &&
+			   CE_state->htt_rx_data;
+
+	qdf_spin_lock_bh(&CE_state->ce_index_lock);
+	write_index = dest_ring->write_index;
+	sw_index = dest_ring->sw_index;
+
+	if (Q_TARGET_ACCESS_BEGIN(scn) < 0) {
+		qdf_spin_unlock_bh(&CE_state->ce_index_lock);
+		return -EIO;
+	}
+
+	while (num_posted < num_bufs &&
+	       (ring_always_open ||
+		CE_RING_DELTA(nentries_mask, write_index, sw_index - 1) > 0)) {
+		struct CE_dest_desc *dest_desc =
+			CE_DEST_RING_TO_DESC(dest_ring_base, write_index);
+		uint64_t dma_addr = bufs[num_posted].buffer;
+		void *per_recv_context =
+			bufs[num_posted].per_transfer_recv_context;
+
+		/* Update low 32 bit destination descriptor */
+		dest_desc->buffer_addr = (uint32_t)(dma_addr & 0xFFFFFFFF);
+#ifdef QCA_WIFI_3_0
+		dest_desc->buffer_addr_hi =
+			(uint32_t)((dma_addr >> 32) & 0x1F);
+#endif
+		dest_desc->nbytes = 0;
+
+		dest_ring->per_transfer_context[write_index] =
+			per_recv_context;
+
+		hif_record_ce_desc_event(scn, CE_state->id, HIF_RX_DESC_POST,
+				(union ce_desc *) dest_desc, per_recv_context,
+				write_index);
+
+		num_posted++;
+		write_index = CE_RING_IDX_INCR(nentries_mask, write_index);
+		/*
+		 * Same rule as the single enqueue: never publish a write
+		 * index that equals the sw index.
+		 */
+		if (write_index != sw_index)
+			dest_ring->write_index = write_index;
+		else
+			break;
+	}
+
+	/* One doorbell for the whole batch */
+	if (num_posted)
+		CE_DEST_RING_WRITE_IDX_SET(scn, ctrl_addr,
+					   dest_ring->write_index);
+
+	Q_TARGET_ACCESS_END(scn);
+	qdf_spin_unlock_bh(&CE_state->ce_index_lock);
+	return num_posted;
+}
+
 void
 ce_send_watermarks_set(struct CE_handle *copyeng,
 		       unsigned int low_alert_nentries,
@@ -1762,6 +2217,121 @@ static void ce_per_engine_service_fast(struct hif_softc *scn, int ce_id)
 }
 #endif /* WLAN_FEATURE_FASTPATH */
 
+static void
+ce_per_engine_handler_adjust(struct CE_state *CE_state,
+			     int disable_copy_compl_intr);
+
+/**
+ * ce_intr_mod_timeout() - poll timer of a CE in deferred mode
+ * @arg: CE_state
+ *
+ * Hands the CE to its tasklet or NAPI instance, the same way an interrupt
+ * would, so the CE keeps a single servicing context.
+ *
+ * Return: none
+ */
+static void ce_intr_mod_timeout(void *arg)
+{
+	struct CE_state *CE_state = (struct CE_state *)arg;
+
+	if (CE_state->intr_mod.mode != CE_INTR_MOD_DEFERRED)
+		return;
+
+	CE_state->intr_mod.polls++;
+	ce_intr_mod_poll(CE_state->scn, CE_state->id);
+}
+
+/**
+ * ce_intr_mod_init() - set up interrupt moderation for a CE
+ * @CE_state: CE created with CE_ATTR_INTR_MOD
+ *
+ * Return: none
+ */
+void ce_intr_mod_init(struct CE_state *CE_state)
+{
+	struct ce_intr_mod *mod = &CE_state->intr_mod;
+
+	qdf_mem_zero(mod, sizeof(*mod));
+	qdf_timer_init(CE_state->scn->qdf_dev, &mod->timer,
+		       ce_intr_mod_timeout, CE_state, QDF_TIMER_TYPE_SW);
+	mod->interval_start = qdf_system_ticks();
+	mod->enabled = true;
+}
+
+/**
+ * ce_intr_mod_deinit() - tear down interrupt moderation for a CE
+ * @CE_state: CE state
+ *
+ * Return: none
+ */
+void ce_intr_mod_deinit(struct CE_state *CE_state)
+{
+	struct ce_intr_mod *mod = &CE_state->intr_mod;
+
+	if (!mod->enabled)
+		return;
+
+	mod->enabled = false;
+	mod->mode = CE_INTR_MOD_IMMEDIATE;
+	qdf_timer_free(&mod->timer);
+}
+
+/**
+ * ce_intr_mod_update() - account a service run and retune the CE
+ * @CE_state: CE state
+ * @pkts: completions handled by the run
+ * @bytes: bytes completed by the run, 0 where not known (fastpath)
+ *
+ * Called at the end of ce_per_engine_service() with target access held and
+ * the ring lock released. Once an interval has passed, its rates decide
+ * whether the CE is driven by copy complete interrupts or by the poll
+ * timer. In deferred mode the next poll is armed here, after the run, so
+ * polls never overlap with servicing.
+ *
+ * Return: none
+ */
+static void ce_intr_mod_update(struct CE_state *CE_state, uint32_t pkts,
+			       uint32_t bytes)
+{
+	struct ce_intr_mod *mod = &CE_state->intr_mod;
+	qdf_time_t now = qdf_system_ticks();
+	uint32_t elapsed_ms;
+
+	mod->interval_pkts += pkts;
+	mod->interval_bytes += bytes;
+
+	elapsed_ms = qdf_system_ticks_to_msecs(now - mod->interval_start);
+	if (elapsed_ms >= CE_INTR_MOD_INTERVAL_MS) {
+		mod->last_pkts = (uint32_t)div_u64((uint64_t)mod->interval_pkts *
+					CE_INTR_MOD_INTERVAL_MS, elapsed_ms);
+		mod->last_bytes = (uint32_t)div_u64((uint64_t)mod->interval_bytes *
+					CE_INTR_MOD_INTERVAL_MS, elapsed_ms);
+		mod->interval_pkts = 0;
+		mod->interval_bytes = 0;
+		mod->interval_start = now;
+
+		if (mod->mode == CE_INTR_MOD_IMMEDIATE &&
+		    !CE_state->disable_copy_compl_intr &&
+		    (mod->last_pkts >= CE_INTR_MOD_HIGH_PKTS ||
+		     mod->last_bytes >= CE_INTR_MOD_HIGH_BYTES)) {
+			mod->mode = CE_INTR_MOD_DEFERRED;
+			mod->to_deferred++;
+			ce_per_engine_handler_adjust(CE_state, 1);
+		} else if (mod->mode == CE_INTR_MOD_DEFERRED &&
+			   mod->last_pkts < CE_INTR_MOD_LOW_PKTS &&
+			   mod->last_bytes < CE_INTR_MOD_LOW_BYTES) {
+			mod->mode = CE_INTR_MOD_IMMEDIATE;
+			mod->to_immediate++;
+			qdf_timer_stop(&mod->timer);
+			ce_per_engine_handler_adjust(CE_state, 0);
+		}
+	}
+
+	if (mod->mode == CE_INTR_MOD_DEFERRED)
+		qdf_timer_mod(&mod->timer,
+			      qdf_system_ticks_to_msecs(CE_INTR_MOD_POLL_TICKS));
+}
+
 #define CE_PER_ENGINE_SERVICE_MAX_TIME_JIFFIES 2
 /*
  * Guts of interrupt handler for per-engine interrupts on a particular CE.
@@ -1787,6 +2357,7 @@ int ce_per_engine_service(struct hif_softc *scn, unsigned int CE_id)
 	unsigned int sw_idx, hw_idx;
 	uint32_t toeplitz_hash_result;
 	uint32_t mode = hif_get_conparam(scn);
+	uint32_t mod_pkts = 0, mod_bytes = 0;
 
 	if (hif_is_nss_wifi_enabled(scn) && (CE_state->htt_rx_data))
 		return CE_state->receive_count;
@@ -1811,6 +2382,7 @@ int ce_per_engine_service(struct hif_softc *scn, unsigned int CE_id)
 	if (ce_is_fastpath_handler_registered(CE_state)) {
 		/* For datapath only Rx CEs */
 		ce_per_engine_service_fast(scn, CE_id);
+		mod_pkts = CE_state->receive_count;
 		goto unlock_end;
 	}
 
@@ -1825,6 +2397,8 @@ more_completions:
 				&buf, &nbytes, &id, &flags) ==
 				QDF_STATUS_SUCCESS) {
 			qdf_spin_unlock(&CE_state->ce_index_lock);
+			mod_pkts++;
+			mod_bytes += nbytes;
 			CE_state->recv_cb((struct CE_handle *)CE_state,
 					  CE_context, transfer_context, buf,
 					  nbytes, id, flags);
@@ -1871,6 +2445,8 @@ more_completions:
 			 &transfer_context, &buf, &nbytes,
 			 &id, &sw_idx, &hw_idx,
 			 &toeplitz_hash_result) == QDF_STATUS_SUCCESS) {
+			mod_pkts++;
+			mod_bytes += nbytes;
 
 			if (CE_id != CE_HTT_H2T_MSG ||
 			    QDF_IS_EPPING_ENABLED(mode)) {
@@ -1897,6 +2473,8 @@ more_completions:
 			  &transfer_context, &buf, &nbytes,
 			  &id, &sw_idx, &hw_idx,
 			  &toeplitz_hash_result) == QDF_STATUS_SUCCESS) {
+			mod_pkts++;
+			mod_bytes += nbytes;
 			qdf_spin_unlock(&CE_state->ce_index_lock);
 			CE_state->send_cb((struct CE_handle *)CE_state,
 				  CE_context, transfer_context, buf,
@@ -1986,6 +2564,8 @@ more_watermarks:
 unlock_end:
 	qdf_spin_unlock(&CE_state->ce_index_lock);
 target_access_end:
+	if (CE_state->intr_mod.enabled)
+		ce_intr_mod_update(CE_state, mod_pkts, mod_bytes);
 	if (Q_TARGET_ACCESS_END(scn) < 0)
 		HIF_ERROR("<--[premature rc=%d]", CE_state->receive_count);
 	return CE_state->receive_count;
@@ -363,6 +363,7 @@ hif_ce_increment_interrupt_count(struct HIF_CE_state *hif_ce_state, int ce_id)
  */
 void hif_display_ce_stats(struct HIF_CE_state *hif_ce_state)
 {
+	struct hif_softc *scn = HIF_GET_SOFTC(hif_ce_state);
 #define STR_SIZE 128
 	uint8_t i, j, pos;
 	char str_buffer[STR_SIZE];
@@ -384,6 +385,22 @@ void hif_display_ce_stats(struct HIF_CE_state *hif_ce_state)
 		qdf_print("%s", str_buffer);
 	}
 #undef STR_SIZE
+
+	qdf_print("CE interrupt moderation:");
+	for (i = 0; i < scn->ce_count; i++) {
+		struct CE_state *ce_state = scn->ce_id_to_state[i];
+		struct ce_intr_mod *mod;
+
+		if (!ce_state || !ce_state->intr_mod.enabled)
+			continue;
+
+		mod = &ce_state->intr_mod;
+		qdf_print("CE id: %d mode: %s pkts/int: %u bytes/int: %u to_deferred: %u to_immediate: %u polls: %u",
+			  i, (mod->mode == CE_INTR_MOD_DEFERRED) ?
+			  "deferred" : "immediate",
+			  mod->last_pkts, mod->last_bytes,
+			  mod->to_deferred, mod->to_immediate, mod->polls);
+	}
 }
 
 /**
@@ -440,6 +457,34 @@ irqreturn_t ce_dispatch_interrupt(int ce_id,
 	return IRQ_HANDLED;
 }
 
+/**
+ * ce_intr_mod_poll() - service a CE whose interrupt is moderated away
+ * @scn: hif context
+ * @ce_id: CE to service
+ *
+ * Called from the interrupt moderation poll timer. Schedules the same
+ * tasklet or NAPI instance as ce_dispatch_interrupt(), without counting
+ * an interrupt.
+ *
+ * Return: none
+ */
+void ce_intr_mod_poll(struct hif_softc *scn, int ce_id)
+{
+	struct HIF_CE_state *hif_ce_state = HIF_GET_CE_STATE(scn);
+	struct hif_opaque_softc *hif_hdl = GET_HIF_OPAQUE_HDL(scn);
+
+	if (qdf_atomic_read(&scn->link_suspended))
+		return;
+
+	hif_irq_disable(scn, ce_id);
+	qdf_atomic_inc(&scn->active_tasklet_cnt);
+
+	if (hif_napi_enabled(hif_hdl, ce_id))
+		hif_napi_schedule(hif_hdl, ce_id);
+	else
+		tasklet_schedule(&hif_ce_state->tasklets[ce_id].intr_tq);
+}
+
 /**
  * const char *ce_name
  *
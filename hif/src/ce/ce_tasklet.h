@@ -38,4 +38,5 @@ irqreturn_t ce_dispatch_interrupt(int irq,
 				  struct ce_tasklet_entry *tasklet_entry);
 void hif_display_ce_stats(struct HIF_CE_state *hif_ce_state);
 void hif_clear_ce_stats(struct HIF_CE_state *hif_ce_state);
+void ce_intr_mod_poll(struct hif_softc *scn, int ce_id);
 #endif /* __CE_TASKLET_H__ */
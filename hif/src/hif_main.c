@@ -46,6 +46,7 @@
 #include "hif_debug.h"
 #include "mp_dev.h"
 #include "ce_api.h"
+#include "hif_napi.h"
 
 void hif_dump(struct hif_opaque_softc *hif_ctx, uint8_t cmd_id, bool start)
 {
@@ -493,6 +494,7 @@ void hif_disable(struct hif_opaque_softc *hif_ctx, enum hif_disable_type type)
 void hif_display_stats(struct hif_opaque_softc *hif_ctx)
 {
 	hif_display_bus_stats(hif_ctx);
+	hif_napi_stats(hif_ctx);
 }
 
 void hif_clear_stats(struct hif_opaque_softc *hif_ctx)
@@ -963,6 +965,28 @@ int hif_send_fast(struct hif_opaque_softc *osc, qdf_nbuf_t nbuf,
 	return ce_send_fast((struct CE_handle *)ce_tx_hdl, nbuf,
 			transfer_id, download_len);
 }
+
+/**
+ * hif_send_fast_multiple() - API to access hif specific function
+ * ce_send_fast_multiple.
+ * @osc: HIF Context
+ * @msdus : array of msdus to be sent
+ * @num_msdus : number of msdus in an array
+ * @transfer_id: transfer id
+ * @download_len: download length
+ *
+ * The source ring write index is updated once for all msdus sent.
+ *
+ * Return: No. of packets that could be sent, from the head of the array
+ */
+int hif_send_fast_multiple(struct hif_opaque_softc *osc, qdf_nbuf_t *msdus,
+		uint32_t num_msdus, uint32_t transfer_id,
+		uint32_t download_len)
+{
+	void *ce_tx_hdl = hif_get_ce_handle(osc, CE_HTT_TX_CE);
+	return ce_send_fast_multiple((struct CE_handle *)ce_tx_hdl, msdus,
+			num_msdus, transfer_id, download_len);
+}
 #endif
 
 /**
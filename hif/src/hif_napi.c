@@ -32,6 +32,8 @@
  */
 
 #include <string.h> /* memset */
+#include <linux/percpu.h>
+#include <linux/sched.h> /* sched_clock */
 
 #include <hif_napi.h>
 #include <hif_debug.h>
@@ -46,6 +48,11 @@ enum napi_decision_vector {
 };
 #define ENABLE_NAPI_MASK (HIF_NAPI_INITED | HIF_NAPI_CONF_UP)
 
+/* upper bounds (in us) of the napi_poll_lat buckets; the last is open */
+static const uint32_t napi_poll_lat_bounds[QCA_NAPI_NUM_LAT_BUCKETS - 1] = {
+	10, 20, 50, 100, 250, 500, 1000
+};
+
 /**
  * hif_napi_create() - creates the NAPI structures for a given CE
  * @hif    : pointer to hif context
@@ -107,6 +114,12 @@ int hif_napi_create(struct hif_opaque_softc   *hif_ctx,
 
 		napii = &(napid->napis[i]);
 		memset(napii, 0, sizeof(struct qca_napi_info));
+		napii->stats = alloc_percpu(struct qca_napi_stat);
+		if (!napii->stats) {
+			HIF_ERROR("%s: NAPI stats alloc failed for pipe %d; not creating NAPI",
+				  __func__, i);
+			continue;
+		}
 		napii->scale = scale;
 		napii->id    = NAPI_PIPE2ID(i);
 		init_dummy_netdev(&(napii->netdev));
@@ -203,6 +216,8 @@ int hif_napi_destroy(struct hif_opaque_softc *hif_ctx,
 				   napii->netdev.napi_list.next);
 
 			netif_napi_del(&(napii->napi));
+			free_percpu(napii->stats);
+			napii->stats = NULL;
 
 			napid->ce_map &= ~(0x01 << ce);
 			napii->scale  = 0;
@@ -388,13 +403,12 @@ inline void hif_napi_enable_irq(struct hif_opaque_softc *hif, int id)
  */
 int hif_napi_schedule(struct hif_opaque_softc *hif_ctx, int ce_id)
 {
-	int cpu = smp_processor_id();
 	struct hif_softc *scn = HIF_GET_SOFTC(hif_ctx);
 
 	hif_record_ce_desc_event(scn,  ce_id, NAPI_SCHEDULE,
 				 NULL, NULL, 0);
 
-	scn->napi_data.napis[ce_id].stats[cpu].napi_schedules++;
+	this_cpu_inc(scn->napi_data.napis[ce_id].stats->napi_schedules);
 	NAPI_DEBUG("scheduling napi %d (ce:%d)",
 		   scn->napi_data.napis[ce_id].id, ce_id);
 	napi_schedule(&(scn->napi_data.napis[ce_id].napi));
@@ -429,15 +443,19 @@ int hif_napi_poll(struct hif_opaque_softc *hif_ctx, struct napi_struct *napi,
 	int    rc = 0; /* default: no work done, also takes care of error */
 	int    normalized, bucket;
 	int    cpu = smp_processor_id();
+	uint64_t poll_start = sched_clock();
+	uint32_t poll_time;
 	struct hif_softc      *hif = HIF_GET_SOFTC(hif_ctx);
 	struct qca_napi_info *napi_info;
+	struct qca_napi_stat *napi_stat;
 	struct CE_state *ce_state = NULL;
 
 	NAPI_DEBUG("%s -->(.., budget=%d)", budget);
 
 	napi_info = (struct qca_napi_info *)
 		container_of(napi, struct qca_napi_info, napi);
-	napi_info->stats[cpu].napi_polls++;
+	napi_stat = per_cpu_ptr(napi_info->stats, cpu);
+	napi_stat->napi_polls++;
 
 	hif_record_ce_desc_event(hif, NAPI_ID2PIPE(napi_info->id),
 				 NAPI_POLL_ENTER, NULL, NULL, cpu);
@@ -449,7 +467,7 @@ int hif_napi_poll(struct hif_opaque_softc *hif_ctx, struct napi_struct *napi,
 		NAPI_DEBUG("%s: ce_per_engine_service processed %d msgs",
 			    __func__, rc);
 	}
-	napi_info->stats[cpu].napi_workdone += rc;
+	napi_stat->napi_workdone += rc;
 	normalized = (rc / napi_info->scale);
 
 	if (NULL != hif) {
@@ -464,7 +482,7 @@ int hif_napi_poll(struct hif_opaque_softc *hif_ctx, struct napi_struct *napi,
 	if (rc)
 		normalized++;
 	bucket   = (normalized / QCA_NAPI_DEF_SCALE);
-	napi_info->stats[cpu].napi_budget_uses[bucket]++;
+	napi_stat->napi_budget_uses[bucket]++;
 
 	/* if ce_per engine reports 0, then poll should be terminated */
 	if (0 == rc)
@@ -472,7 +490,7 @@ int hif_napi_poll(struct hif_opaque_softc *hif_ctx, struct napi_struct *napi,
 			   __func__, __LINE__);
 
 	if (ce_state && (!ce_check_rx_pending(ce_state) || 0 == rc)) {
-		napi_info->stats[cpu].napi_completes++;
+		napi_stat->napi_completes++;
 
 		hif_record_ce_desc_event(hif, ce_state->id, NAPI_COMPLETE,
 					 NULL, NULL, 0);
@@ -501,6 +519,85 @@ int hif_napi_poll(struct hif_opaque_softc *hif_ctx, struct napi_struct *napi,
 	hif_record_ce_desc_event(hif, NAPI_ID2PIPE(napi_info->id),
 				 NAPI_POLL_EXIT, NULL, NULL, normalized);
 
+	poll_time = (uint32_t)div_u64(sched_clock() - poll_start, 1000);
+	for (bucket = 0; bucket < QCA_NAPI_NUM_LAT_BUCKETS - 1; bucket++)
+		if (poll_time < napi_poll_lat_bounds[bucket])
+			break;
+	napi_stat->napi_poll_lat[bucket]++;
+	if (poll_time > napi_stat->napi_poll_time_max)
+		napi_stat->napi_poll_time_max = poll_time;
+
 	NAPI_DEBUG("%s <--[normalized=%d]", _func__, normalized);
 	return normalized;
 }
+
+/**
+ * hif_napi_stats_aggregate() - sum up the per cpu stats of a NAPI instance
+ * @napii: NAPI instance
+ * @sum  : filled with the totals over all possible cpus
+ *
+ * The per cpu copies are updated without locking from the poll and
+ * schedule paths, so the result is a snapshot that may be a few events
+ * behind.
+ *
+ * Return: void
+ */
+void hif_napi_stats_aggregate(struct qca_napi_info *napii,
+			      struct qca_napi_stat *sum)
+{
+	struct qca_napi_stat *stat;
+	int cpu, i;
+
+	memset(sum, 0, sizeof(*sum));
+	if (!napii->stats)
+		return;
+
+	for_each_possible_cpu(cpu) {
+		stat = per_cpu_ptr(napii->stats, cpu);
+		sum->napi_schedules += stat->napi_schedules;
+		sum->napi_polls     += stat->napi_polls;
+		sum->napi_completes += stat->napi_completes;
+		sum->napi_workdone  += stat->napi_workdone;
+		for (i = 0; i < QCA_NAPI_NUM_BUCKETS; i++)
+			sum->napi_budget_uses[i] += stat->napi_budget_uses[i];
+		for (i = 0; i < QCA_NAPI_NUM_LAT_BUCKETS; i++)
+			sum->napi_poll_lat[i] += stat->napi_poll_lat[i];
+		if (stat->napi_poll_time_max > sum->napi_poll_time_max)
+			sum->napi_poll_time_max = stat->napi_poll_time_max;
+	}
+}
+
+/**
+ * hif_napi_stats() - dump the aggregated stats of all NAPI instances
+ * @hif_ctx: hif context
+ *
+ * Return: void
+ */
+void hif_napi_stats(struct hif_opaque_softc *hif_ctx)
+{
+	struct hif_softc *hif = HIF_GET_SOFTC(hif_ctx);
+	struct qca_napi_data *napid = &(hif->napi_data);
+	struct qca_napi_stat sum;
+	int i, j;
+
+	for (i = 0; i < CE_COUNT_MAX; i++) {
+		if (!(napid->ce_map & (0x01 << i)))
+			continue;
+
+		hif_napi_stats_aggregate(&(napid->napis[i]), &sum);
+		HIF_ERROR("NAPI[%d] pipe %d: sched %u poll %u comp %u work %u max %uus",
+			  napid->napis[i].id, i, sum.napi_schedules,
+			  sum.napi_polls, sum.napi_completes,
+			  sum.napi_workdone, sum.napi_poll_time_max);
+		for (j = 0; j < QCA_NAPI_NUM_BUCKETS; j++)
+			if (sum.napi_budget_uses[j])
+				HIF_ERROR("  budget bucket %d: %u",
+					  j, sum.napi_budget_uses[j]);
+		for (j = 0; j < QCA_NAPI_NUM_LAT_BUCKETS - 1; j++)
+			HIF_ERROR("  poll < %4uus: %u",
+				  napi_poll_lat_bounds[j],
+				  sum.napi_poll_lat[j]);
+		HIF_ERROR("  poll >=%4uus: %u",
+			  napi_poll_lat_bounds[j], sum.napi_poll_lat[j]);
+	}
+}
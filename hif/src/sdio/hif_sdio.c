@@ -124,6 +124,53 @@ QDF_STATUS hif_send_head(struct hif_opaque_softc *hif_ctx, uint8_t pipe,
 				nbytes, buf);
 }
 
+/**
+ * hif_send_head_sg() - send a scatter list on hif bus interface.
+ * @hif_ctx: HIF context
+ * @pipe: ul pipe id
+ * @transfer_id: transfer id
+ * @nbytes: total length of the scatter list
+ * @buf: nbuf handed back in the tx completion
+ * @sg_list: pieces to send, in order
+ * @sg_count: number of entries in @sg_list
+ *
+ * Return: QDF_STATUS_SUCCESS if queued, QDF_STATUS_E_NOSUPPORT or
+ * QDF_STATUS_E_RESOURCES if the caller should send a linear copy instead
+ */
+QDF_STATUS hif_send_head_sg(struct hif_opaque_softc *hif_ctx, uint8_t pipe,
+		uint32_t transfer_id, uint32_t nbytes, qdf_nbuf_t buf,
+		struct hif_sg_item *sg_list, uint32_t sg_count)
+{
+	struct hif_sdio_softc *scn = HIF_GET_SDIO_SOFTC(hif_ctx);
+	struct hif_sdio_dev *hif_device = scn->hif_handle;
+	struct hif_sdio_device *htc_sdio_device = hif_dev_from_hif(hif_device);
+
+	return hif_dev_send_buffer_sg(htc_sdio_device, transfer_id, pipe,
+				      nbytes, buf, sg_list, sg_count);
+}
+
+/**
+ * hif_get_send_sg_max_entries() - scatter list entries a send may use
+ * @hif_ctx: HIF context
+ *
+ * One entry of the HIF scatter request is kept back for the block pad.
+ *
+ * Return: max entries for hif_send_head_sg(), 0 if not supported
+ */
+uint32_t hif_get_send_sg_max_entries(struct hif_opaque_softc *hif_ctx)
+{
+	struct hif_sdio_softc *scn = HIF_GET_SDIO_SOFTC(hif_ctx);
+	struct hif_sdio_dev *hif_device = scn->hif_handle;
+	struct hif_sdio_device *htc_sdio_device = hif_dev_from_hif(hif_device);
+
+	if (!htc_sdio_device ||
+	    !htc_sdio_device->HifScatterInfo.read_write_scatter_func ||
+	    htc_sdio_device->HifScatterInfo.max_scatter_entries < 2)
+		return 0;
+
+	return htc_sdio_device->HifScatterInfo.max_scatter_entries - 1;
+}
+
 /**
  * hif_map_service_to_pipe() - maps ul/dl pipe to service id.
  * @hif_ctx: HIF hdl
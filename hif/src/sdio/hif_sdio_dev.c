@@ -271,6 +271,8 @@ void hif_dev_destroy(struct hif_sdio_device *pdev)
 				("(%s)HIF_DEVICE_SET_HTC_CONTEXT failed!!!\n",
 				 __func__));
 	}
+	if (pdev->ScatterPadBuffer)
+		qdf_mem_free(pdev->ScatterPadBuffer);
 	qdf_mem_free(pdev);
 }
 
@@ -466,6 +468,21 @@ QDF_STATUS hif_dev_setup(struct hif_sdio_device *pdev)
 	pdev->BlockMask = pdev->BlockSize - 1;
 	A_ASSERT((pdev->BlockSize & pdev->BlockMask) == 0);
 
+	/* see if the HIF layer can take scatter-gather sends */
+	status = hif_configure_device(hif_device,
+				      HIF_CONFIGURE_QUERY_SCATTER_REQUEST_SUPPORT,
+				      &pdev->HifScatterInfo,
+				      sizeof(pdev->HifScatterInfo));
+	if (status == QDF_STATUS_SUCCESS && !pdev->ScatterPadBuffer) {
+		/* zeroed block tail pad shared by all scatter sends */
+		pdev->ScatterPadBuffer = qdf_mem_malloc(pdev->BlockSize);
+		if (pdev->ScatterPadBuffer)
+			qdf_mem_zero(pdev->ScatterPadBuffer, pdev->BlockSize);
+	}
+	if (!pdev->ScatterPadBuffer)
+		qdf_mem_zero(&pdev->HifScatterInfo,
+			     sizeof(pdev->HifScatterInfo));
+
 	/* assume we can process HIF interrupt events asynchronously */
 	pdev->HifIRQProcessingMode = HIF_DEVICE_IRQ_ASYNC_SYNC;
 
@@ -54,6 +54,12 @@ QDF_STATUS hif_dev_send_buffer(struct hif_sdio_device *htc_sdio_device,
 			     unsigned int transfer_id, uint8_t pipe,
 			     unsigned int nbytes, qdf_nbuf_t buf);
 
+QDF_STATUS hif_dev_send_buffer_sg(struct hif_sdio_device *htc_sdio_device,
+				  unsigned int transfer_id, uint8_t pipe,
+				  unsigned int nbytes, qdf_nbuf_t buf,
+				  struct hif_sg_item *sg_list,
+				  uint32_t sg_count);
+
 QDF_STATUS hif_dev_map_service_to_pipe(struct hif_sdio_device *pdev,
 				       uint16_t service_id,
 				       uint8_t *ul_pipe,
@@ -112,6 +112,9 @@ struct hif_sdio_device {
 	int RecheckIRQStatusCnt;
 	uint32_t RecvStateFlags;
 	void *pTarget;
+	/* scatter-gather send support, zeroed if HIF has none */
+	struct HIF_DEVICE_SCATTER_SUPPORT_INFO HifScatterInfo;
+	uint8_t *ScatterPadBuffer;
 };
 
 #define LOCK_HIF_DEV(device)    qdf_spin_lock(&(device)->Lock);
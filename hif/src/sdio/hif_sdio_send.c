@@ -195,3 +195,100 @@ QDF_STATUS hif_dev_send_buffer(struct hif_sdio_device *pdev,
 
 	return status;
 }
+
+/**
+ * hif_dev_sg_completion_handler() - completion routine for scatter sends
+ * @req: scatter request that completed
+ *
+ * Return: none
+ */
+static void hif_dev_sg_completion_handler(struct _HIF_SCATTER_REQ *req)
+{
+	struct hif_sdio_device *pdev = (struct hif_sdio_device *)req->context;
+	qdf_nbuf_t buf = (qdf_nbuf_t)req->scatter_list[0].caller_contexts[0];
+	unsigned int transfer_id = req->caller_flags;
+
+	if (QDF_IS_STATUS_ERROR(req->completion_status))
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+				("%s: scatter send failed: %d\n",
+				 __func__, req->completion_status));
+
+	pdev->HifScatterInfo.free_req_func(pdev->HIFDevice, req);
+
+	if (pdev->hif_callbacks.txCompletionHandler)
+		pdev->hif_callbacks.txCompletionHandler(pdev->hif_callbacks.
+					Context, buf, transfer_id, 0);
+}
+
+/**
+ * hif_dev_send_buffer_sg() - send a scatter list to sdio device
+ * @pdev: sdio function
+ * @transfer_id: transfer id
+ * @pipe: ul pipe
+ * @nbytes: total length of @sg_list
+ * @buf: nbuf handed back in the tx completion
+ * @sg_list: pieces to send, in order
+ * @sg_count: number of entries in @sg_list
+ *
+ * The pieces are written with one CMD53 through the HIF scatter request,
+ * padded up to the block size from the shared zero pad buffer.
+ *
+ * Return: QDF_STATUS_SUCCESS if queued, QDF_STATUS_E_NOSUPPORT or
+ * QDF_STATUS_E_RESOURCES if the caller should send a linear copy instead
+ */
+QDF_STATUS hif_dev_send_buffer_sg(struct hif_sdio_device *pdev,
+				  unsigned int transfer_id,
+				  uint8_t pipe, unsigned int nbytes,
+				  qdf_nbuf_t buf,
+				  struct hif_sg_item *sg_list,
+				  uint32_t sg_count)
+{
+	struct HIF_DEVICE_SCATTER_SUPPORT_INFO *info = &pdev->HifScatterInfo;
+	struct _HIF_SCATTER_REQ *req;
+	uint32_t padded_length;
+	uint32_t i;
+	uint8_t mbox_index = hif_dev_map_pipe_to_mail_box(pdev, pipe);
+
+	if (!info->read_write_scatter_func || !sg_count)
+		return QDF_STATUS_E_NOSUPPORT;
+
+	padded_length = DEV_CALC_SEND_PADDED_LEN(pdev, nbytes);
+	if (sg_count + 1 > info->max_scatter_entries ||
+	    padded_length > info->max_tx_size_per_scatter_req ||
+	    padded_length >
+		pdev->MailBoxInfo.mbox_prop[mbox_index].extended_size)
+		return QDF_STATUS_E_NOSUPPORT;
+
+	req = info->allocate_req_func(pdev->HIFDevice);
+	if (NULL == req)
+		return QDF_STATUS_E_RESOURCES;
+
+	for (i = 0; i < sg_count; i++) {
+		req->scatter_list[i].buffer = sg_list[i].buffer;
+		req->scatter_list[i].length = sg_list[i].length;
+	}
+	if (padded_length != nbytes) {
+		req->scatter_list[i].buffer = pdev->ScatterPadBuffer;
+		req->scatter_list[i].length = padded_length - nbytes;
+		i++;
+	}
+
+	/*
+	 * the scatter path does not apply the mailbox dummy space, end
+	 * the real data at the mailbox end as hif_read_write() does
+	 */
+	req->address = pdev->MailBoxInfo.mbox_prop[mbox_index].
+			extended_address +
+		pdev->MailBoxInfo.mbox_prop[mbox_index].extended_size -
+		nbytes;
+	req->request = HIF_WR_ASYNC_BLOCK_INC;
+	req->total_length = padded_length;
+	req->valid_scatter_entries = i;
+	req->completion_routine = hif_dev_sg_completion_handler;
+	req->context = pdev;
+	req->caller_flags = transfer_id;
+	req->scatter_list[0].caller_contexts[0] = buf;
+
+	/* async errors are reported through the completion routine */
+	return info->read_write_scatter_func(pdev->HIFDevice, req);
+}
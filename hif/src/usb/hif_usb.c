@@ -387,6 +387,9 @@ QDF_STATUS hif_usb_device_init(struct hif_usb_softc *sc)
 
 			HIF_USB_INIT_WORK(pipe);
 			skb_queue_head_init(&pipe->io_comp_queue);
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+			skb_queue_head_init(&pipe->rx_buf_pool);
+#endif
 		}
 
 		device->diag_cmd_buffer =
@@ -774,6 +777,15 @@ void hif_dump_info(struct hif_opaque_softc *scn)
 			HIF_INFO("Pipe Type INT");
 		else if (usb_pipecontrol(pipe->usb_pipe_handle))
 			HIF_INFO("Pipe Type control");
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+		HIF_INFO("RX bundle clone %u copy %u pool reuse %u alloc %u drop %u depth %u",
+			pipe->rx_bundle_clone_cnt,
+			pipe->rx_bundle_copy_cnt,
+			pipe->rx_buf_pool_reuse_cnt,
+			pipe->rx_buf_pool_alloc_cnt,
+			pipe->rx_buf_pool_drop_cnt,
+			skb_queue_len(&pipe->rx_buf_pool));
+#endif
 	}
 
 	for (i = 0; i < iface_desc->desc.bNumEndpoints; i++) {
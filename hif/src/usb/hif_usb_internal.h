@@ -43,6 +43,13 @@
 #define HIF_USB_RX_BUFFER_SIZE  (1792 + 8)
 #define HIF_USB_RX_BUNDLE_ONE_PKT_SIZE  (1792 + 8)
 
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+/* subframes shorter than this are copied rather than cloned */
+#define HIF_USB_RX_BUNDLE_COPY_THRESH   128
+/* max bundle buffers parked per pipe waiting for their subframes */
+#define HIF_USB_RX_BUF_POOL_SIZE        (2 * RX_URB_COUNT)
+#endif
+
 #ifdef HIF_USB_TASKLET
 #define HIF_USB_SCHEDULE_WORK(pipe)\
 	tasklet_schedule(&pipe->io_complete_tasklet);
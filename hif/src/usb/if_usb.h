@@ -115,6 +115,15 @@ typedef struct _HIF_USB_PIPE {
 	struct sk_buff_head io_comp_queue;
 	struct usb_endpoint_descriptor *ep_desc;
 	int32_t urb_prestart_cnt;
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+	/* bundle buffers still shared with subframes handed up to HTC */
+	struct sk_buff_head rx_buf_pool;
+	uint32_t rx_bundle_clone_cnt;
+	uint32_t rx_bundle_copy_cnt;
+	uint32_t rx_buf_pool_reuse_cnt;
+	uint32_t rx_buf_pool_alloc_cnt;
+	uint32_t rx_buf_pool_drop_cnt;
+#endif
 } HIF_USB_PIPE;
 
 typedef struct _HIF_DEVICE_USB {
@@ -232,6 +232,15 @@ static void usb_hif_free_pipe_resources(HIF_USB_PIPE *pipe)
 		qdf_mem_free(urb_context);
 	}
 
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+	while (true) {
+		qdf_nbuf_t buf = skb_dequeue(&pipe->rx_buf_pool);
+
+		if (NULL == buf)
+			break;
+		qdf_nbuf_free(buf);
+	}
+#endif
 }
 
 /**
@@ -670,6 +679,122 @@ static void usb_hif_usb_recv_complete(struct urb *urb)
 	HIF_DBG("-%s", __func__);
 }
 
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+/**
+ * usb_hif_rx_bundle_subframe() - get an nbuf for one subframe of a bundle
+ * @pipe: rx pipe the bundle was received on
+ * @buf: bundle buffer, with its length set to the received length
+ * @offset: offset of the subframe within @buf
+ * @frame_len: length of the subframe
+ *
+ * Subframes of at least HIF_USB_RX_BUNDLE_COPY_THRESH bytes are handed up
+ * as clones of @buf trimmed to the subframe, so the bundle data stays
+ * shared until the last subframe is freed. Small subframes, and any
+ * subframe that can not be cloned, are copied into a private nbuf.
+ *
+ * Return: nbuf holding the subframe or NULL on allocation failure
+ */
+static qdf_nbuf_t usb_hif_rx_bundle_subframe(HIF_USB_PIPE *pipe,
+					     qdf_nbuf_t buf, uint32_t offset,
+					     uint16_t frame_len)
+{
+	qdf_nbuf_t new_skb;
+
+	if (frame_len >= HIF_USB_RX_BUNDLE_COPY_THRESH) {
+		new_skb = qdf_nbuf_clone(buf);
+		if (new_skb) {
+#ifdef MEMORY_DEBUG
+			qdf_net_buf_debug_add_node(new_skb, frame_len,
+						   __FILE__, __LINE__);
+#endif
+			qdf_nbuf_pull_head(new_skb, offset);
+			qdf_nbuf_set_pktlen(new_skb, frame_len);
+			pipe->rx_bundle_clone_cnt++;
+			return new_skb;
+		}
+	}
+
+	new_skb = qdf_nbuf_alloc(NULL, frame_len, 0, 4, false);
+	if (new_skb == NULL)
+		return NULL;
+
+	qdf_mem_copy(qdf_nbuf_put_tail(new_skb, frame_len),
+		     qdf_nbuf_data(buf) + offset, frame_len);
+	pipe->rx_bundle_copy_cnt++;
+
+	return new_skb;
+}
+
+/**
+ * usb_hif_rx_buf_pool_put() - release a bundle buffer after de-aggregation
+ * @pipe: rx pipe the bundle was received on
+ * @urb_context: urb context owning the bundle buffer
+ *
+ * A buffer that still has subframe clones outstanding is detached from
+ * the urb and parked in the pipe pool until the clones are freed; the
+ * urb gets a fresh buffer when it is next posted. A buffer with no
+ * clones is emptied and stays with the urb.
+ *
+ * Return: none
+ */
+static void usb_hif_rx_buf_pool_put(HIF_USB_PIPE *pipe,
+				    HIF_URB_CONTEXT *urb_context)
+{
+	qdf_nbuf_t buf = urb_context->buf;
+
+	if (buf == NULL)
+		return;
+
+	if (!qdf_nbuf_is_cloned(buf)) {
+		qdf_nbuf_set_pktlen(buf, 0);
+		return;
+	}
+
+	urb_context->buf = NULL;
+	if (skb_queue_len(&pipe->rx_buf_pool) >= HIF_USB_RX_BUF_POOL_SIZE) {
+		/* drop our reference, the last subframe frees the data */
+		pipe->rx_buf_pool_drop_cnt++;
+		qdf_nbuf_free(buf);
+		return;
+	}
+
+	skb_queue_tail(&pipe->rx_buf_pool, buf);
+}
+
+/**
+ * usb_hif_rx_buf_pool_get() - get a bundle buffer for an rx urb
+ * @pipe: rx pipe the urb belongs to
+ * @buffer_length: size of the bundle buffer
+ *
+ * Reuses the oldest parked buffer once all of its subframes have been
+ * freed, otherwise allocates a new one.
+ *
+ * Return: empty nbuf or NULL on allocation failure
+ */
+static qdf_nbuf_t usb_hif_rx_buf_pool_get(HIF_USB_PIPE *pipe,
+					  int buffer_length)
+{
+	qdf_nbuf_t buf;
+
+	buf = skb_dequeue(&pipe->rx_buf_pool);
+	if (buf) {
+		if (!qdf_nbuf_is_cloned(buf)) {
+			qdf_nbuf_set_pktlen(buf, 0);
+			pipe->rx_buf_pool_reuse_cnt++;
+			return buf;
+		}
+		/* still referenced, keep it parked behind the others */
+		skb_queue_tail(&pipe->rx_buf_pool, buf);
+	}
+
+	buf = qdf_nbuf_alloc(NULL, buffer_length, 0, 4, false);
+	if (buf)
+		pipe->rx_buf_pool_alloc_cnt++;
+
+	return buf;
+}
+#endif
+
 /**
  * usb_hif_usb_recv_bundle_complete() - completion routine for rx bundling urb
  * @urb: urb for which the completion routine is being called
@@ -682,8 +807,13 @@ static void usb_hif_usb_recv_bundle_complete(struct urb *urb)
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
 	qdf_nbuf_t buf = NULL;
 	HIF_USB_PIPE *pipe = urb_context->pipe;
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+	uint8_t *netdata;
+	uint32_t netlen;
+#else
 	uint8_t *netdata, *netdata_new;
 	uint32_t netlen, netlen_new;
+#endif
 	HTC_FRAME_HDR *HtcHdr;
 	uint16_t payloadLen;
 	qdf_nbuf_t new_skb = NULL;
@@ -736,6 +866,9 @@ static void usb_hif_usb_recv_bundle_complete(struct urb *urb)
 
 		qdf_nbuf_peek_header(buf, &netdata, &netlen);
 		netlen = urb->actual_length;
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+		qdf_nbuf_put_tail(buf, netlen);
+#endif
 
 		do {
 			uint16_t frame_len;
@@ -768,6 +901,16 @@ static void usb_hif_usb_recv_bundle_complete(struct urb *urb)
 				break;
 			}
 
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+			new_skb = usb_hif_rx_bundle_subframe(pipe, buf,
+					netdata - qdf_nbuf_data(buf),
+					frame_len);
+			if (new_skb == NULL) {
+				HIF_ERROR("athusb: allocate skb (len=%u) failed"
+						, frame_len);
+				break;
+			}
+#else
 			/* allocate a new skb and copy */
 			new_skb =
 				qdf_nbuf_alloc(NULL, frame_len, 0, 4, false);
@@ -781,6 +924,7 @@ static void usb_hif_usb_recv_bundle_complete(struct urb *urb)
 						&netlen_new);
 			qdf_mem_copy(netdata_new, netdata, frame_len);
 			qdf_nbuf_put_tail(new_skb, frame_len);
+#endif
 			skb_queue_tail(&pipe->io_comp_queue, new_skb);
 			new_skb = NULL;
 			netdata += frame_len;
@@ -792,6 +936,9 @@ static void usb_hif_usb_recv_bundle_complete(struct urb *urb)
 	if (urb_context->buf == NULL)
 		HIF_ERROR("athusb: buffer in urb_context is NULL");
 
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+	usb_hif_rx_buf_pool_put(pipe, urb_context);
+#endif
 	/* reset urb_context->buf ==> seems not necessary */
 	usb_hif_free_urb_to_pipe(urb_context->pipe, urb_context);
 
@@ -964,8 +1111,13 @@ static void usb_hif_post_recv_bundle_transfers
 			break;
 
 		if (NULL == urb_context->buf) {
+#ifdef HIF_USB_RX_BUNDLE_ZERO_COPY
+			urb_context->buf =
+			usb_hif_rx_buf_pool_get(recv_pipe, buffer_length);
+#else
 			urb_context->buf =
 			qdf_nbuf_alloc(NULL, buffer_length, 0, 4, false);
+#endif
 			if (NULL == urb_context->buf) {
 				usb_hif_cleanup_recv_urb(urb_context);
 				break;
@@ -163,6 +163,10 @@ static void htc_cleanup(HTC_TARGET *target)
 		qdf_mem_free(pPacket);
 		pPacket = pPacketTmp;
 	}
+#ifdef HIF_SDIO
+	if (target->tx_bundle_pad_buf)
+		qdf_mem_free(target->tx_bundle_pad_buf);
+#endif
 #ifdef TODO_FIXME
 	while (true) {
 		pPacket = htc_alloc_control_tx_packet(target);
@@ -387,6 +391,122 @@ htc_setup_epping_credit_allocation(struct hif_opaque_softc *scn,
 	return;
 }
 
+/**
+ * htc_setup_credit_policy_allocation() - split tx credits by the policy
+ * @target: HTC Target Pointer
+ * @pEntry: first ServiceTxAllocTable entry to fill
+ * @credits: credits to split
+ *
+ * Each service gets its share of @credits, rounding leftovers go to the
+ * first service in the policy.
+ *
+ * Return: none
+ */
+static void htc_setup_credit_policy_allocation(HTC_TARGET *target,
+			HTC_SERVICE_TX_CREDIT_ALLOCATION *pEntry,
+			int credits)
+{
+	HTC_SERVICE_TX_CREDIT_ALLOCATION *first = pEntry;
+	int assigned = 0;
+	int alloc;
+	int i;
+
+	for (i = 0; i < target->credit_policy_cnt; i++, pEntry++) {
+		alloc = credits * target->credit_policy[i].share / 100;
+		pEntry->service_id = target->credit_policy[i].service_id;
+		pEntry->CreditAllocation = QDF_MIN(alloc, 0xFF);
+		assigned += pEntry->CreditAllocation;
+	}
+
+	if (assigned < credits)
+		first->CreditAllocation = QDF_MIN(first->CreditAllocation +
+						  credits - assigned, 0xFF);
+}
+
+/**
+ * htc_credit_policy_apply() - set the credit limits of a new endpoint
+ * @target: HTC Target Pointer
+ * @pEndpoint: endpoint being connected
+ * @initial_credits: credits the endpoint starts with
+ *
+ * Without a policy entry the endpoint keeps its initial credits and only
+ * gives back what it borrowed.
+ *
+ * Return: none
+ */
+void htc_credit_policy_apply(HTC_TARGET *target, HTC_ENDPOINT *pEndpoint,
+			     int initial_credits)
+{
+	int i;
+
+	pEndpoint->tx_credits_initial = initial_credits;
+	pEndpoint->tx_credits_min = initial_credits;
+	pEndpoint->tx_credits_max = 0;
+
+	for (i = 0; i < target->credit_policy_cnt; i++) {
+		if (target->credit_policy[i].service_id ==
+		    pEndpoint->service_id) {
+			pEndpoint->tx_credits_min =
+				target->credit_policy[i].min_credits;
+			pEndpoint->tx_credits_max =
+				target->credit_policy[i].max_credits;
+			break;
+		}
+	}
+}
+
+/**
+ * htc_set_credit_policy() - configure tx credit allocation across services
+ * @HTCHandle: HTC handle
+ * @policy: policy entries
+ * @num: number of entries in @policy, 0 to drop the policy
+ *
+ * The policy is checked before it replaces the current one: the shares
+ * may not add up to more than all credits, no entry may have a minimum
+ * above its maximum, and WMI control must be part of it so WMI is never
+ * left without credits. Connected endpoints get the new limits at once.
+ *
+ * Return: A_OK on success, A_EINVAL for an invalid policy
+ */
+A_STATUS htc_set_credit_policy(HTC_HANDLE HTCHandle,
+			       const struct htc_credit_policy *policy,
+			       int num)
+{
+	HTC_TARGET *target = GET_HTC_TARGET_FROM_HANDLE(HTCHandle);
+	HTC_ENDPOINT *pEndpoint;
+	bool has_wmi_control = false;
+	int share = 0;
+	int i;
+
+	if (num < 0 || num > HTC_MAX_CREDIT_POLICY_ENTRIES)
+		return A_EINVAL;
+
+	for (i = 0; i < num; i++) {
+		share += policy[i].share;
+		if (policy[i].max_credits &&
+		    policy[i].min_credits > policy[i].max_credits)
+			return A_EINVAL;
+		if (policy[i].service_id == WMI_CONTROL_SVC)
+			has_wmi_control = true;
+	}
+	if (share > 100 || (num && !has_wmi_control))
+		return A_EINVAL;
+
+	LOCK_HTC_TX(target);
+	qdf_mem_copy(target->credit_policy, policy, num * sizeof(*policy));
+	target->credit_policy_cnt = num;
+
+	for (i = ENDPOINT_1; i < ENDPOINT_MAX; i++) {
+		pEndpoint = &target->endpoint[i];
+		if (pEndpoint->service_id != 0)
+			htc_credit_policy_apply(target, pEndpoint,
+						pEndpoint->tx_credits_initial);
+	}
+	UNLOCK_HTC_TX(target);
+
+	return A_OK;
+}
+
 /**
  * htc_setup_target_buffer_assignments() - setup target buffer assignments
  * @target: HTC Target Pointer
@@ -405,20 +525,23 @@ A_STATUS htc_setup_target_buffer_assignments(HTC_TARGET *target)
 		creditsPerMaxMsg++;
 	}
 
-	/* TODO, this should be configured by the caller! */
-
 	credits = target->TotalTransmitCredits;
 	pEntry = &target->ServiceTxAllocTable[0];
 
-	/*
-	 * Allocate all credists/HTC buffers to WMI.
-	 * no buffers are used/required for data. data always
-	 * remains on host.
-	 */
 	status = A_OK;
 	pEntry++;
-	pEntry->service_id = WMI_CONTROL_SVC;
-	pEntry->CreditAllocation = credits;
+	if (target->credit_policy_cnt) {
+		/* split as configured by htc_set_credit_policy() */
+		htc_setup_credit_policy_allocation(target, pEntry, credits);
+	} else {
+		/*
+		 * Allocate all credists/HTC buffers to WMI.
+		 * no buffers are used/required for data. data always
+		 * remains on host.
+		 */
+		pEntry->service_id = WMI_CONTROL_SVC;
+		pEntry->CreditAllocation = credits;
+	}
 
 	if (HTC_IS_EPPING_ENABLED(target->con_mode)) {
 		/* endpoint ping is a testing tool directly on top of HTC in
@@ -488,6 +611,55 @@ uint8_t htc_get_credit_allocation(HTC_TARGET *target, uint16_t service_id)
 	return allocation;
 }
 
+#if defined(HIF_SDIO) && defined(ENABLE_BUNDLE_TX)
+/**
+ * htc_setup_tx_bundle_sg() - enable scatter-gather tx bundling
+ * @target: HTC target
+ *
+ * Scatter-gather bundling is used when the HIF can take scatter lists.
+ * Credit pad slots of a bundle all point at one zeroed buffer as large
+ * as the largest credit size an endpoint may use.
+ *
+ * Return: none
+ */
+static void htc_setup_tx_bundle_sg(HTC_TARGET *target)
+{
+	uint32_t sg_max;
+	int pad_size;
+
+	if (target->tx_bundle_pad_buf) {
+		qdf_mem_free(target->tx_bundle_pad_buf);
+		target->tx_bundle_pad_buf = NULL;
+	}
+	target->tx_bundle_sg_max = 0;
+
+	if (!HTC_TX_BUNDLE_ENABLED(target))
+		return;
+
+	sg_max = hif_get_send_sg_max_entries(target->hif_dev);
+	if (sg_max < HTC_MIN_MSG_PER_BUNDLE)
+		return;
+
+	/* pads are bounded by the endpoint credit size, HTT may use the alt */
+	pad_size = QDF_MAX(target->TargetCreditSize,
+			   (int)target->AltDataCreditSize);
+	target->tx_bundle_pad_buf = qdf_mem_malloc(pad_size);
+	if (!target->tx_bundle_pad_buf)
+		return;
+	qdf_mem_zero(target->tx_bundle_pad_buf, pad_size);
+
+	target->tx_bundle_sg_max = QDF_MIN(sg_max,
+					   HTC_TX_BUNDLE_SG_MAX_ENTRIES);
+	AR_DEBUG_PRINTF(ATH_DEBUG_INIT,
+			("HTC tx bundle scatter-gather, %d entries\n",
+			 target->tx_bundle_sg_max));
+}
+#else
+static inline void htc_setup_tx_bundle_sg(HTC_TARGET *target)
+{
+}
+#endif
+
 A_STATUS htc_wait_target(HTC_HANDLE HTCHandle)
 {
 	A_STATUS status = A_OK;
@@ -563,6 +735,7 @@ A_STATUS htc_wait_target(HTC_HANDLE HTCHandle)
 		target->CtrlResponseProcessing = false;
 
 		htc_setup_target_buffer_assignments(target);
+		htc_setup_tx_bundle_sg(target);
 
 		/* setup our pseudo HTC control endpoint connection */
 		qdf_mem_zero(&connect, sizeof(connect));
@@ -604,10 +777,33 @@ static void reset_endpoint_states(HTC_TARGET *target)
 		pEndpoint->Id = i;
 		INIT_HTC_PACKET_QUEUE(&pEndpoint->TxQueue);
 		INIT_HTC_PACKET_QUEUE(&pEndpoint->TxLookupQueue);
+		qdf_mem_zero(&pEndpoint->tx_lookup_tbl,
+			     sizeof(pEndpoint->tx_lookup_tbl));
+		pEndpoint->tx_ooo_cmpl_cnt = 0;
 		INIT_HTC_PACKET_QUEUE(&pEndpoint->RxBufferHoldQueue);
 		pEndpoint->target = target;
 		pEndpoint->TxCreditFlowEnabled = (bool)htc_credit_flow;
 		qdf_atomic_init(&pEndpoint->TxProcessCount);
+		pEndpoint->tx_sched_weight = HTC_TX_SCHED_WEIGHT_DEFAULT;
+		pEndpoint->tx_sched_deficit = 0;
+		pEndpoint->tx_sched_pkts = 0;
+		pEndpoint->tx_sched_deferred = 0;
+		pEndpoint->tx_credits_min = 0;
+		pEndpoint->tx_credits_max = 0;
+		pEndpoint->tx_credits_seek = 0;
+		pEndpoint->tx_credits_used = 0;
+		pEndpoint->tx_credit_starved = 0;
+		pEndpoint->tx_credits_lent = 0;
+		pEndpoint->tx_credits_borrowed = 0;
+#ifdef RX_SG_SUPPORT
+		pEndpoint->rx_sg_chain = false;
+#endif
+	}
+
+	for (i = 0; i < HTC_TX_SCHED_PIPE_MAX; i++) {
+		qdf_atomic_init(&target->tx_sched[i].pending);
+		qdf_atomic_init(&target->tx_sched[i].busy);
+		target->tx_sched[i].next_ep = 0;
 	}
 }
 
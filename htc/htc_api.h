@@ -178,6 +178,7 @@ typedef struct _HTC_SERVICE_CONNECT_REQ {
 } HTC_SERVICE_CONNECT_REQ;
 
 #define HTC_LOCAL_CONN_FLAGS_ENABLE_SEND_BUNDLE_PADDING (1 << 0)        /* enable send bundle padding for this endpoint */
+#define HTC_LOCAL_CONN_FLAGS_RX_SG_CHAIN                (1 << 1)        /* deliver rx scatter-gather messages as nbuf chains */
 
 /* service connection response information */
 typedef struct _HTC_SERVICE_CONNECT_RESP {
@@ -354,6 +355,101 @@ void htc_set_credit_distribution(HTC_HANDLE HTCHandle,
    @see also: htc_connect_service
  +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 A_STATUS htc_wait_target(HTC_HANDLE HTCHandle);
+
+/**
+ * struct htc_credit_policy - tx credit policy of one service
+ * @service_id: service the entry applies to
+ * @share: percent of the target tx credits requested for the service
+ *	when it connects
+ * @min_credits: credits the service keeps while idle, credits above this
+ *	may be lent to services that are starved for credits
+ * @max_credits: most credits the service may hold, 0 for no limit
+ */
+struct htc_credit_policy {
+	HTC_SERVICE_ID service_id;
+	uint8_t share;
+	uint8_t min_credits;
+	uint8_t max_credits;
+};
+
+/**
+ * htc_set_credit_policy() - configure tx credit allocation across services
+ * @HTCHandle: HTC handle
+ * @policy: policy entries, earlier entries get leftover credits first
+ * @num: number of entries in @policy
+ *
+ * Call before htc_wait_target() for the shares to be used for the initial
+ * allocation; min and max credits also apply to connected services.
+ *
+ * Return: A_OK on success, A_EINVAL if @num exceeds the table size, the
+ *	shares add up to more than 100, an entry has min_credits above a
+ *	non zero max_credits, or WMI_CONTROL_SVC is missing from the policy
+ */
+A_STATUS htc_set_credit_policy(HTC_HANDLE HTCHandle,
+			       const struct htc_credit_policy *policy,
+			       int num);
+
+/**
+ * struct htc_rx_frag_iter - cursor over a received message
+ * @head: nbuf the message was delivered in
+ * @cur: nbuf holding the current position
+ * @offset: offset of the current position within @cur
+ * @remaining: bytes of the message left after the current position
+ *
+ * Messages received on endpoints connected with
+ * HTC_LOCAL_CONN_FLAGS_RX_SG_CHAIN may arrive as a head nbuf with the rest
+ * of the message in its extension list. The iterator walks such a chain as
+ * well as a plain linear nbuf, so parsers need not care which they got.
+ */
+struct htc_rx_frag_iter {
+	qdf_nbuf_t head;
+	qdf_nbuf_t cur;
+	uint32_t offset;
+	uint32_t remaining;
+};
+
+/**
+ * htc_rx_frag_iter_init() - start iterating over a received message
+ * @iter: iterator to set up
+ * @netbuf: nbuf of the message, data pointing at the HTC payload
+ * @len: message length, normally the packet ActualLength
+ *
+ * Return: none
+ */
+void htc_rx_frag_iter_init(struct htc_rx_frag_iter *iter, qdf_nbuf_t netbuf,
+			   uint32_t len);
+
+/**
+ * htc_rx_frag_iter_read() - copy bytes out and advance
+ * @iter: iterator
+ * @dst: destination buffer
+ * @len: bytes to copy
+ *
+ * Return: bytes copied, less than @len if the message ended first
+ */
+uint32_t htc_rx_frag_iter_read(struct htc_rx_frag_iter *iter, void *dst,
+			       uint32_t len);
+
+/**
+ * htc_rx_frag_iter_peek() - get a pointer to the next bytes
+ * @iter: iterator
+ * @len: bytes the caller wants to access
+ *
+ * Does not advance the iterator. Fails when the bytes straddle two
+ * fragments, in which case the caller falls back to htc_rx_frag_iter_read().
+ *
+ * Return: pointer to @len contiguous bytes or NULL
+ */
+uint8_t *htc_rx_frag_iter_peek(struct htc_rx_frag_iter *iter, uint32_t len);
+
+/**
+ * htc_rx_frag_iter_skip() - advance without copying
+ * @iter: iterator
+ * @len: bytes to skip
+ *
+ * Return: bytes skipped, less than @len if the message ended first
+ */
+uint32_t htc_rx_frag_iter_skip(struct htc_rx_frag_iter *iter, uint32_t len);
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
    @desc: Start target service communications
    @function name: htc_start
@@ -706,6 +802,8 @@ do {									\
 #endif
 void htc_get_control_endpoint_tx_host_credits(HTC_HANDLE HTCHandle, int *credit);
 void htc_dump_counter_info(HTC_HANDLE HTCHandle);
+void htc_set_endpoint_tx_weight(HTC_HANDLE HTCHandle, HTC_ENDPOINT_ID Endpoint,
+				uint32_t weight);
 void *htc_get_targetdef(HTC_HANDLE htc_handle);
 #ifdef FEATURE_RUNTIME_PM
 int htc_runtime_suspend(HTC_HANDLE htc_ctx);
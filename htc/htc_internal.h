@@ -99,6 +99,23 @@ typedef struct {
 	uint32_t htc_tx_queue_depth;
 } HTC_CREDIT_HISTORY;
 
+/*
+ * Per endpoint open addressing table matching a completed tx netbuf to the
+ * HTC packet that carried it. Sized as a power of two and only filled up to
+ * HTC_TX_LOOKUP_TBL_MAX_FILL so that linear probe chains stay short; packets
+ * that do not fit are left in TxLookupQueue only and found by walking it.
+ */
+#define HTC_TX_LOOKUP_TBL_SIZE              256
+#define HTC_TX_LOOKUP_TBL_MASK              (HTC_TX_LOOKUP_TBL_SIZE - 1)
+#define HTC_TX_LOOKUP_TBL_MAX_FILL          (HTC_TX_LOOKUP_TBL_SIZE / 2)
+
+struct htc_tx_lookup_tbl {
+	qdf_nbuf_t netbuf[HTC_TX_LOOKUP_TBL_SIZE];
+	HTC_PACKET *packet[HTC_TX_LOOKUP_TBL_SIZE];
+	uint32_t count;         /* packets currently in the table */
+	uint32_t unhashed;      /* lookup queue packets not in the table */
+};
+
 typedef struct _HTC_ENDPOINT {
 	HTC_ENDPOINT_ID Id;
 
@@ -124,6 +141,8 @@ typedef struct _HTC_ENDPOINT {
 #endif
 
 	HTC_PACKET_QUEUE TxLookupQueue;         /* lookup queue to match netbufs to htc packets */
+	struct htc_tx_lookup_tbl tx_lookup_tbl; /* netbuf hash over TxLookupQueue */
+	uint32_t tx_ooo_cmpl_cnt;               /* completions not at the head of TxLookupQueue */
 	HTC_PACKET_QUEUE RxBufferHoldQueue;             /* temporary hold queue for back compatibility */
 	uint8_t SeqNo;          /* TX seq no (helpful) for debugging */
 	qdf_atomic_t TxProcessCount;            /* serialization */
@@ -135,6 +154,21 @@ typedef struct _HTC_ENDPOINT {
 	HTC_ENDPOINT_STATS endpoint_stats;     /* endpoint statistics */
 #endif
 	bool TxCreditFlowEnabled;
+	uint32_t tx_sched_weight;       /* packets per tx scheduler round */
+	int32_t tx_sched_deficit;       /* packets left in the current round */
+	uint32_t tx_sched_pkts;         /* packets issued by the tx scheduler */
+	uint32_t tx_sched_deferred;     /* rounds cut short by the pipe */
+	int tx_credits_initial;         /* credits allocated at connect */
+	int tx_credits_min;             /* credits kept while idle */
+	int tx_credits_max;             /* credit cap, 0 for none */
+	int tx_credits_seek;            /* credits the head packet lacked */
+	uint32_t tx_credits_used;       /* credits consumed by sends */
+	uint32_t tx_credit_starved;     /* sends stopped for lack of credits */
+	uint32_t tx_credits_lent;       /* credits given to other endpoints */
+	uint32_t tx_credits_borrowed;   /* credits taken from other endpoints */
+#ifdef RX_SG_SUPPORT
+	bool rx_sg_chain;               /* rx sg messages delivered unlinearized */
+#endif
 } HTC_ENDPOINT;
 
 #ifdef HTC_EP_STAT_PROFILING
@@ -148,7 +182,28 @@ typedef struct {
 	uint8_t CreditAllocation;
 } HTC_SERVICE_TX_CREDIT_ALLOCATION;
 
+/* UL pipes the tx scheduler keeps state for */
+#define HTC_TX_SCHED_PIPE_MAX           16
+/* upper bound on deficit round robin rounds per scheduler run */
+#define HTC_TX_SCHED_MAX_ROUNDS         8
+#define HTC_TX_SCHED_WEIGHT_DEFAULT     4
+#define HTC_TX_SEND_UNLIMITED           0xFFFFFFFF
+
+/**
+ * struct htc_tx_sched_pipe - tx scheduler state of one UL pipe
+ * @pending: a resource indication arrived that is not served yet
+ * @busy: a context is running the scheduler for the pipe
+ * @next_ep: endpoint the next round starts at
+ */
+struct htc_tx_sched_pipe {
+	qdf_atomic_t pending;
+	qdf_atomic_t busy;
+	uint8_t next_ep;
+};
+
 #define HTC_MAX_SERVICE_ALLOC_ENTRIES 8
+/* entry 0 of ServiceTxAllocTable is left unused */
+#define HTC_MAX_CREDIT_POLICY_ENTRIES (HTC_MAX_SERVICE_ALLOC_ENTRIES - 1)
 
 /* Error codes for HTC layer packet stats*/
 enum ol_ath_htc_pkt_ecodes {
@@ -176,12 +231,17 @@ typedef struct _HTC_TARGET {
 	int TotalTransmitCredits;
 	HTC_SERVICE_TX_CREDIT_ALLOCATION
 		ServiceTxAllocTable[HTC_MAX_SERVICE_ALLOC_ENTRIES];
+	struct htc_credit_policy credit_policy[HTC_MAX_CREDIT_POLICY_ENTRIES];
+	int credit_policy_cnt;
 	int TargetCreditSize;
 #ifdef RX_SG_SUPPORT
 	qdf_nbuf_queue_t RxSgQueue;
 	bool IsRxSgInprogress;
 	uint32_t CurRxSgTotalLen;               /* current total length */
 	uint32_t ExpRxSgTotalLen;               /* expected total length */
+	bool RxSgChain;                         /* deliver as an nbuf chain */
+	uint32_t rx_sg_chained;                 /* messages delivered chained */
+	uint32_t rx_sg_linearized;              /* messages copied to one nbuf */
 #endif
 	qdf_device_t osdev;
 	struct ol_ath_htc_stats htc_pkt_stats;
@@ -190,9 +250,15 @@ typedef struct _HTC_TARGET {
 	uint32_t TX_comp_cnt;
 	uint8_t MaxMsgsPerHTCBundle;
 	qdf_work_t queue_kicker;
+	struct htc_tx_sched_pipe tx_sched[HTC_TX_SCHED_PIPE_MAX];
 
 #ifdef HIF_SDIO
 	A_UINT16 AltDataCreditSize;
+	/* scatter-gather tx bundling, tx_bundle_sg_max is 0 when unused */
+	uint32_t tx_bundle_sg_max;
+	uint8_t *tx_bundle_pad_buf;
+	uint32_t tx_bundle_sg_cnt;
+	uint32_t tx_bundle_sg_fallback_cnt;
 #endif
 	A_UINT32 avail_tx_credits;
 #if defined(DEBUG_HL_LOGGING) && defined(CONFIG_HL_SUPPORT)
@@ -217,11 +283,18 @@ typedef struct _HTC_TARGET {
 
 #define HTC_ENABLE_BUNDLE(target) (target->MaxMsgsPerHTCBundle > 1)
 
+/* upper bound on scatter list entries HTC builds for one tx bundle */
+#define HTC_TX_BUNDLE_SG_MAX_ENTRIES        32
+
 #ifdef RX_SG_SUPPORT
 #define RESET_RX_SG_CONFIG(_target) \
 	_target->ExpRxSgTotalLen = 0; \
 	_target->CurRxSgTotalLen = 0; \
-	_target->IsRxSgInprogress = false;
+	_target->IsRxSgInprogress = false; \
+	_target->RxSgChain = false;
+
+/* trailer length is carried in the 8 bit CONTROLBYTES0 field */
+#define HTC_MAX_RX_TRAILER_LEN      0xFF
 #endif
 
 #define HTC_STATE_STOPPING      (1 << 0)
@@ -274,6 +347,8 @@ A_STATUS htc_wait_recv_ctrl_message(HTC_TARGET *target);
 void htc_free_control_tx_packet(HTC_TARGET *target, HTC_PACKET *pPacket);
 HTC_PACKET *htc_alloc_control_tx_packet(HTC_TARGET *target);
 uint8_t htc_get_credit_allocation(HTC_TARGET *target, uint16_t service_id);
+void htc_credit_policy_apply(HTC_TARGET *target, HTC_ENDPOINT *pEndpoint,
+			     int initial_credits);
 void htc_tx_resource_avail_handler(void *context, uint8_t pipeID);
 void htc_control_rx_complete(void *Context, HTC_PACKET *pPacket);
 void htc_process_credit_rpt(HTC_TARGET *target,
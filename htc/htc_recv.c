@@ -245,6 +245,7 @@ qdf_nbuf_t rx_sg_to_single_netbuf(HTC_TARGET *target)
 		skb = qdf_nbuf_queue_remove(rx_sg_queue);
 	} while (skb != NULL);
 
+	target->rx_sg_linearized++;
 	RESET_RX_SG_CONFIG(target);
 	return new_skb;
 
@@ -256,8 +257,170 @@ _failed:
 	RESET_RX_SG_CONFIG(target);
 	return NULL;
 }
+
+/**
+ * rx_sg_to_chained_netbuf() - hand over queued rx fragments as one chain
+ * @target: HTC target with a complete message on RxSgQueue
+ *
+ * The first fragment becomes the head and the rest are linked to it as its
+ * extension list, so no fragment is copied. Called with LOCK_HTC_RX held.
+ *
+ * Return: head nbuf of the message or NULL
+ */
+static qdf_nbuf_t rx_sg_to_chained_netbuf(HTC_TARGET *target)
+{
+	qdf_nbuf_queue_t *rx_sg_queue = &target->RxSgQueue;
+	qdf_nbuf_t head;
+	qdf_nbuf_t ext_list = NULL;
+	qdf_nbuf_t prev = NULL;
+	qdf_nbuf_t skb;
+	uint32_t ext_len;
+
+	head = qdf_nbuf_queue_remove(rx_sg_queue);
+	if (head == NULL) {
+		RESET_RX_SG_CONFIG(target);
+		return NULL;
+	}
+	qdf_nbuf_set_next(head, NULL);
+	ext_len = target->CurRxSgTotalLen - qdf_nbuf_len(head);
+
+	while ((skb = qdf_nbuf_queue_remove(rx_sg_queue)) != NULL) {
+		/* the head owns the fragment from here on */
+		qdf_net_buf_debug_release_skb(skb);
+		qdf_nbuf_set_next(skb, NULL);
+		if (prev)
+			qdf_nbuf_set_next(prev, skb);
+		else
+			ext_list = skb;
+		prev = skb;
+	}
+
+	if (ext_list)
+		qdf_nbuf_append_ext_list(head, ext_list, ext_len);
+
+	target->rx_sg_chained++;
+	RESET_RX_SG_CONFIG(target);
+	return head;
+}
+
+/**
+ * htc_process_chained_trailer() - process a trailer of a chained message
+ * @target: HTC target
+ * @netbuf: head nbuf of the message, data pointing at the HTC header
+ * @offset: offset of the trailer from the HTC header
+ * @len: trailer length
+ * @from_endpoint: endpoint the message was received on
+ *
+ * Return: A_OK on success
+ */
+static A_STATUS htc_process_chained_trailer(HTC_TARGET *target,
+					    qdf_nbuf_t netbuf,
+					    uint32_t offset, uint32_t len,
+					    HTC_ENDPOINT_ID from_endpoint)
+{
+	struct htc_rx_frag_iter iter;
+	uint8_t trailer[HTC_MAX_RX_TRAILER_LEN];
+	uint8_t *buf;
+
+	if (len > sizeof(trailer))
+		return A_EINVAL;
+
+	htc_rx_frag_iter_init(&iter, netbuf, offset + len);
+	if (htc_rx_frag_iter_skip(&iter, offset) != offset)
+		return A_EINVAL;
+
+	buf = htc_rx_frag_iter_peek(&iter, len);
+	if (buf == NULL) {
+		if (htc_rx_frag_iter_read(&iter, trailer, len) != len)
+			return A_EINVAL;
+		buf = trailer;
+	}
+
+	return htc_process_trailer(target, buf, len, from_endpoint);
+}
 #endif
 
+/* length of the part of @cur that belongs to the walked message */
+static inline uint32_t htc_rx_frag_seg_len(struct htc_rx_frag_iter *iter)
+{
+	if (iter->cur == iter->head)
+		return qdf_nbuf_headlen(iter->cur);
+	return qdf_nbuf_len(iter->cur);
+}
+
+/* move to the next fragment once the current one is used up */
+static void htc_rx_frag_iter_advance(struct htc_rx_frag_iter *iter)
+{
+	while (iter->cur && iter->offset >= htc_rx_frag_seg_len(iter)) {
+		iter->offset -= htc_rx_frag_seg_len(iter);
+		if (iter->cur == iter->head)
+			iter->cur = qdf_nbuf_get_ext_list(iter->head);
+		else
+			iter->cur = qdf_nbuf_next(iter->cur);
+	}
+
+	if (iter->cur == NULL)
+		iter->remaining = 0;
+}
+
+void htc_rx_frag_iter_init(struct htc_rx_frag_iter *iter, qdf_nbuf_t netbuf,
+			   uint32_t len)
+{
+	iter->head = netbuf;
+	iter->cur = netbuf;
+	iter->offset = 0;
+	iter->remaining = QDF_MIN(len, (uint32_t)qdf_nbuf_len(netbuf));
+	htc_rx_frag_iter_advance(iter);
+}
+
+uint32_t htc_rx_frag_iter_skip(struct htc_rx_frag_iter *iter, uint32_t len)
+{
+	uint32_t done = 0;
+	uint32_t chunk;
+
+	while (done < len && iter->remaining) {
+		chunk = QDF_MIN(len - done, iter->remaining);
+		chunk = QDF_MIN(chunk, htc_rx_frag_seg_len(iter) - iter->offset);
+		iter->offset += chunk;
+		iter->remaining -= chunk;
+		done += chunk;
+		htc_rx_frag_iter_advance(iter);
+	}
+
+	return done;
+}
+
+uint32_t htc_rx_frag_iter_read(struct htc_rx_frag_iter *iter, void *dst,
+			       uint32_t len)
+{
+	uint8_t *to = dst;
+	uint32_t done = 0;
+	uint32_t chunk;
+
+	while (done < len && iter->remaining) {
+		chunk = QDF_MIN(len - done, iter->remaining);
+		chunk = QDF_MIN(chunk, htc_rx_frag_seg_len(iter) - iter->offset);
+		qdf_mem_copy(to + done, qdf_nbuf_data(iter->cur) + iter->offset,
+			     chunk);
+		iter->offset += chunk;
+		iter->remaining -= chunk;
+		done += chunk;
+		htc_rx_frag_iter_advance(iter);
+	}
+
+	return done;
+}
+
+uint8_t *htc_rx_frag_iter_peek(struct htc_rx_frag_iter *iter, uint32_t len)
+{
+	if (len > iter->remaining || iter->cur == NULL)
+		return NULL;
+	if (len > htc_rx_frag_seg_len(iter) - iter->offset)
+		return NULL;
+
+	return qdf_nbuf_data(iter->cur) + iter->offset;
+}
+
 #ifdef CONFIG_WIN
 #define HTC_MSG_NACK_SUSPEND 7
 #endif
@@ -282,7 +445,10 @@ QDF_STATUS htc_rx_completion_handler(void *Context, qdf_nbuf_t netbuf,
 		target->CurRxSgTotalLen += qdf_nbuf_len(netbuf);
 		qdf_nbuf_queue_add(&target->RxSgQueue, netbuf);
 		if (target->CurRxSgTotalLen == target->ExpRxSgTotalLen) {
-			netbuf = rx_sg_to_single_netbuf(target);
+			if (target->RxSgChain)
+				netbuf = rx_sg_to_chained_netbuf(target);
+			else
+				netbuf = rx_sg_to_single_netbuf(target);
 			if (netbuf == NULL) {
 				UNLOCK_HTC_RX(target);
 				goto _out;
@@ -334,6 +500,7 @@ QDF_STATUS htc_rx_completion_handler(void *Context, qdf_nbuf_t netbuf,
 #ifdef RX_SG_SUPPORT
 			LOCK_HTC_RX(target);
 			target->IsRxSgInprogress = true;
+			target->RxSgChain = pEndpoint->rx_sg_chain;
 			qdf_nbuf_queue_init(&target->RxSgQueue);
 			qdf_nbuf_queue_add(&target->RxSgQueue, netbuf);
 			target->ExpRxSgTotalLen = (payloadLen + HTC_HDR_LENGTH);
@@ -381,7 +548,17 @@ QDF_STATUS htc_rx_completion_handler(void *Context, qdf_nbuf_t netbuf,
 
 				trailerlen = temp;
 				/* process trailer data that follows HDR + application payload */
-				temp_status = htc_process_trailer(target,
+#ifdef RX_SG_SUPPORT
+				if (qdf_nbuf_is_nonlinear(netbuf))
+					temp_status =
+						htc_process_chained_trailer(
+							target, netbuf,
+							HTC_HDR_LENGTH +
+							payloadLen - temp,
+							temp, htc_ep_id);
+				else
+#endif
+					temp_status = htc_process_trailer(target,
 							     ((uint8_t *) HtcHdr +
 							      HTC_HDR_LENGTH +
 							      payloadLen - temp),
@@ -501,7 +678,12 @@ QDF_STATUS htc_rx_completion_handler(void *Context, qdf_nbuf_t netbuf,
 		pPacket->ActualLength = netlen - HTC_HEADER_LEN - trailerlen;
 
 		qdf_nbuf_pull_head(netbuf, HTC_HEADER_LEN);
-		qdf_nbuf_set_pktlen(netbuf, pPacket->ActualLength);
+		/*
+		 * A chained message keeps its trailer in the last fragment,
+		 * ActualLength bounds what the endpoint may parse.
+		 */
+		if (!qdf_nbuf_is_nonlinear(netbuf))
+			qdf_nbuf_set_pktlen(netbuf, pPacket->ActualLength);
 
 		recv_packet_completion(target, pEndpoint, pPacket);
 		/* recover the packet container */
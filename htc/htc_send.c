@@ -91,10 +91,73 @@ void htc_credit_record(htc_credit_exchange_type type, uint32_t tx_credit,
 void htc_dump_counter_info(HTC_HANDLE HTCHandle)
 {
 	HTC_TARGET *target = GET_HTC_TARGET_FROM_HANDLE(HTCHandle);
+	HTC_ENDPOINT *pEndpoint;
+	uint32_t pipe_pkts;
+	int i;
+	int j;
 
 	AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
 			("\n%s: ce_send_cnt = %d, TX_comp_cnt = %d\n",
 			 __func__, target->ce_send_cnt, target->TX_comp_cnt));
+
+	for (i = 0; i < ENDPOINT_MAX; i++) {
+		pEndpoint = &target->endpoint[i];
+		if (0 == pEndpoint->service_id)
+			continue;
+
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+				("EP%d: tx_ooo_cmpl_cnt = %u, tx_lookup_hashed = %u, tx_lookup_unhashed = %u\n",
+				 pEndpoint->Id, pEndpoint->tx_ooo_cmpl_cnt,
+				 pEndpoint->tx_lookup_tbl.count,
+				 pEndpoint->tx_lookup_tbl.unhashed));
+	}
+
+	for (i = 0; i < ENDPOINT_MAX; i++) {
+		pEndpoint = &target->endpoint[i];
+		if (0 == pEndpoint->service_id)
+			continue;
+
+		pipe_pkts = 0;
+		for (j = 0; j < ENDPOINT_MAX; j++) {
+			if (target->endpoint[j].service_id &&
+			    target->endpoint[j].UL_PipeID ==
+			    pEndpoint->UL_PipeID)
+				pipe_pkts += target->endpoint[j].tx_sched_pkts;
+		}
+
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+				("EP%d: pipe %u tx_sched_weight = %u, tx_sched_pkts = %u of %u on pipe, tx_sched_deferred = %u\n",
+				 pEndpoint->Id, pEndpoint->UL_PipeID,
+				 pEndpoint->tx_sched_weight,
+				 pEndpoint->tx_sched_pkts, pipe_pkts,
+				 pEndpoint->tx_sched_deferred));
+
+		if (!IS_TX_CREDIT_FLOW_ENABLED(pEndpoint) ||
+		    pEndpoint->Id == ENDPOINT_0)
+			continue;
+
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+				("EP%d: service 0x%x TxCredits = %d (min %d, max %d), credits used = %u, starved = %u, lent = %u, borrowed = %u\n",
+				 pEndpoint->Id, pEndpoint->service_id,
+				 pEndpoint->TxCredits,
+				 pEndpoint->tx_credits_min,
+				 pEndpoint->tx_credits_max,
+				 pEndpoint->tx_credits_used,
+				 pEndpoint->tx_credit_starved,
+				 pEndpoint->tx_credits_lent,
+				 pEndpoint->tx_credits_borrowed));
+	}
+#ifdef HIF_SDIO
+	AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+			("tx_bundle_sg_cnt = %u, tx_bundle_sg_fallback_cnt = %u\n",
+			 target->tx_bundle_sg_cnt,
+			 target->tx_bundle_sg_fallback_cnt));
+#endif
+#ifdef RX_SG_SUPPORT
+	AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+			("rx_sg_chained = %u, rx_sg_linearized = %u\n",
+			 target->rx_sg_chained, target->rx_sg_linearized));
+#endif
 }
 
 void htc_get_control_endpoint_tx_host_credits(HTC_HANDLE HTCHandle, int *credits)
@@ -131,6 +194,116 @@ static inline void restore_tx_packet(HTC_TARGET *target, HTC_PACKET *pPacket)
 
 }
 
+static inline uint32_t htc_tx_lookup_hash(qdf_nbuf_t netbuf)
+{
+	uint32_t key = (uint32_t)((uintptr_t)netbuf >> 6);
+
+	return ((key * 0x9E3779B1) >> 24) & HTC_TX_LOOKUP_TBL_MASK;
+}
+
+/**
+ * htc_tx_lookup_enqueue() - track a packet handed down to HIF
+ * @pEndpoint: endpoint the packet is sent on
+ * @pPacket: packet whose netbuf completion needs to be matched
+ *
+ * Adds the packet to TxLookupQueue and, if there is room, to the endpoint
+ * netbuf hash so that htc_lookup_tx_packet() can find it without walking
+ * the queue. Caller must hold the HTC TX lock.
+ *
+ * Return: None
+ */
+static void htc_tx_lookup_enqueue(HTC_ENDPOINT *pEndpoint,
+				  HTC_PACKET *pPacket)
+{
+	struct htc_tx_lookup_tbl *tbl = &pEndpoint->tx_lookup_tbl;
+	qdf_nbuf_t netbuf = GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket);
+	uint32_t slot;
+
+	HTC_PACKET_ENQUEUE(&pEndpoint->TxLookupQueue, pPacket);
+
+	if (qdf_unlikely(!netbuf ||
+			 tbl->count >= HTC_TX_LOOKUP_TBL_MAX_FILL)) {
+		tbl->unhashed++;
+		return;
+	}
+
+	slot = htc_tx_lookup_hash(netbuf);
+	while (tbl->netbuf[slot])
+		slot = (slot + 1) & HTC_TX_LOOKUP_TBL_MASK;
+
+	tbl->netbuf[slot] = netbuf;
+	tbl->packet[slot] = pPacket;
+	tbl->count++;
+}
+
+/**
+ * htc_tx_lookup_unhash() - drop a netbuf from the endpoint lookup hash
+ * @tbl: endpoint lookup table
+ * @netbuf: netbuf to drop
+ *
+ * Uses backward shift deletion so that no tombstones are left behind and
+ * probe chains of the remaining entries stay intact. Caller must hold the
+ * HTC TX lock.
+ *
+ * Return: packet the netbuf was mapped to, or NULL if it was not hashed
+ */
+static HTC_PACKET *htc_tx_lookup_unhash(struct htc_tx_lookup_tbl *tbl,
+					qdf_nbuf_t netbuf)
+{
+	HTC_PACKET *pPacket;
+	uint32_t slot, next, home;
+
+	if (!tbl->count || !netbuf)
+		return NULL;
+
+	slot = htc_tx_lookup_hash(netbuf);
+	while (tbl->netbuf[slot] != netbuf) {
+		if (!tbl->netbuf[slot])
+			return NULL;
+		slot = (slot + 1) & HTC_TX_LOOKUP_TBL_MASK;
+	}
+
+	pPacket = tbl->packet[slot];
+	tbl->count--;
+
+	next = slot;
+	while (1) {
+		next = (next + 1) & HTC_TX_LOOKUP_TBL_MASK;
+		if (!tbl->netbuf[next])
+			break;
+		home = htc_tx_lookup_hash(tbl->netbuf[next]);
+		/* leave entries whose home slot lies cyclically in (slot, next] */
+		if (((next - home) & HTC_TX_LOOKUP_TBL_MASK) <
+		    ((next - slot) & HTC_TX_LOOKUP_TBL_MASK))
+			continue;
+		tbl->netbuf[slot] = tbl->netbuf[next];
+		tbl->packet[slot] = tbl->packet[next];
+		slot = next;
+	}
+	tbl->netbuf[slot] = NULL;
+	tbl->packet[slot] = NULL;
+
+	return pPacket;
+}
+
+/**
+ * htc_tx_lookup_remove() - stop tracking a packet that HIF did not accept
+ * @pEndpoint: endpoint the packet was queued on
+ * @pPacket: packet to remove
+ *
+ * Caller must hold the HTC TX lock.
+ *
+ * Return: None
+ */
+static void htc_tx_lookup_remove(HTC_ENDPOINT *pEndpoint, HTC_PACKET *pPacket)
+{
+	qdf_nbuf_t netbuf = GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket);
+
+	HTC_PACKET_REMOVE(&pEndpoint->TxLookupQueue, pPacket);
+	if (!htc_tx_lookup_unhash(&pEndpoint->tx_lookup_tbl, netbuf))
+		pEndpoint->tx_lookup_tbl.unhashed--;
+}
+
 static void do_send_completion(HTC_ENDPOINT *pEndpoint,
 			       HTC_PACKET_QUEUE *pQueueToIndicate)
 {
@@ -360,7 +533,7 @@ static A_STATUS htc_send_bundled_netbuf(HTC_TARGET *target,
 			       data_len,
 			       pEndpoint->Id, HTC_TX_PACKET_TAG_BUNDLED);
 	LOCK_HTC_TX(target);
-	HTC_PACKET_ENQUEUE(&pEndpoint->TxLookupQueue, pPacketTx);
+	htc_tx_lookup_enqueue(pEndpoint, pPacketTx);
 	UNLOCK_HTC_TX(target);
 #if DEBUG_BUNDLE
 	qdf_print(" Send bundle EP%d buffer size:0x%x, total:0x%x, count:%d.\n",
@@ -383,6 +556,216 @@ static A_STATUS htc_send_bundled_netbuf(HTC_TARGET *target,
 	return status;
 }
 
+#ifdef HIF_SDIO
+/**
+ * htc_send_bundled_sg() - send a tx bundle described by a scatter list
+ * @target: HTC target
+ * @pEndpoint: endpoint the bundle is sent on
+ * @pPacketTx: bundle packet holding the bundled packets
+ * @sg_list: frames and credit pads of the bundle, in order
+ * @sg_count: number of entries in @sg_list
+ * @data_len: total length of @sg_list
+ *
+ * If the HIF can not take the scatter list right now the pieces are
+ * copied into the bundle buffer and sent the usual way.
+ *
+ * Return: A_OK on success
+ */
+static A_STATUS htc_send_bundled_sg(HTC_TARGET *target,
+				    HTC_ENDPOINT *pEndpoint,
+				    HTC_PACKET *pPacketTx,
+				    struct hif_sg_item *sg_list,
+				    uint32_t sg_count, uint32_t data_len)
+{
+	qdf_nbuf_t bundleBuf = GET_HTC_PACKET_NET_BUF_CONTEXT(pPacketTx);
+	unsigned char *pBundleBuffer;
+	A_STATUS status;
+	uint32_t i;
+
+	SET_HTC_PACKET_INFO_TX(pPacketTx,
+			       target,
+			       qdf_nbuf_data(bundleBuf),
+			       data_len,
+			       pEndpoint->Id, HTC_TX_PACKET_TAG_BUNDLED);
+	LOCK_HTC_TX(target);
+	htc_tx_lookup_enqueue(pEndpoint, pPacketTx);
+	UNLOCK_HTC_TX(target);
+
+	htc_send_update_tx_bundle_stats(target, data_len,
+					pEndpoint->TxCreditSize);
+
+	status = hif_send_head_sg(target->hif_dev,
+				  pEndpoint->UL_PipeID,
+				  pEndpoint->Id, data_len,
+				  bundleBuf, sg_list, sg_count);
+	if (status == QDF_STATUS_SUCCESS) {
+		target->tx_bundle_sg_cnt++;
+		return A_OK;
+	}
+
+	if (status == QDF_STATUS_E_NOSUPPORT ||
+	    status == QDF_STATUS_E_RESOURCES) {
+		pBundleBuffer = qdf_nbuf_data(bundleBuf);
+		for (i = 0; i < sg_count; i++) {
+			qdf_mem_copy(pBundleBuffer, sg_list[i].buffer,
+				     sg_list[i].length);
+			pBundleBuffer += sg_list[i].length;
+		}
+		qdf_nbuf_put_tail(bundleBuf, data_len);
+		target->tx_bundle_sg_fallback_cnt++;
+
+		status = hif_send_head(target->hif_dev,
+				       pEndpoint->UL_PipeID,
+				       pEndpoint->Id, data_len,
+				       bundleBuf, 0);
+	}
+
+	if (status != A_OK) {
+		qdf_print("%s:hif send failed(len=%u).\n", __func__,
+			  data_len);
+	}
+	return status;
+}
+
+/**
+ * htc_issue_packets_bundle_sg() - send bundle packets without a bounce copy
+ * @target: HTC target on which packets need to be sent
+ * @pEndpoint: logical endpoint on which packets needs to be sent
+ * @pPktQueue: HTC packet queue containing the list of packets to be sent
+ *
+ * Same framing as htc_issue_packets_bundle(), but each bundle is a
+ * scatter list of packet fragments with credit pad slots pointing at
+ * the shared zero pad buffer.
+ *
+ * Return: void
+ */
+static void htc_issue_packets_bundle_sg(HTC_TARGET *target,
+					HTC_ENDPOINT *pEndpoint,
+					HTC_PACKET_QUEUE *pPktQueue)
+{
+	struct hif_sg_item sg_list[HTC_TX_BUNDLE_SG_MAX_ENTRIES];
+	uint32_t sg_count = 0, sg_needed, data_len = 0;
+	int i, frag_count, nbytes;
+	qdf_nbuf_t netbuf;
+	HTC_PACKET *pPacket = NULL, *pPacketTx = NULL;
+	HTC_FRAME_HDR *pHtcHdr;
+	int creditPad, creditRemainder, transferLength, bundlesSpaceRemaining;
+	HTC_PACKET_QUEUE *pQueueSave = NULL;
+
+	bundlesSpaceRemaining =
+		target->MaxMsgsPerHTCBundle * pEndpoint->TxCreditSize;
+	pPacketTx = allocate_htc_bundle_packet(target);
+	if (!pPacketTx) {
+		/* good time to panic */
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+				("allocate_htc_bundle_packet failed \n"));
+		AR_DEBUG_ASSERT(false);
+		return;
+	}
+	pQueueSave = (HTC_PACKET_QUEUE *) pPacketTx->pContext;
+	while (1) {
+		pPacket = htc_packet_dequeue(pPktQueue);
+		if (pPacket == NULL)
+			break;
+
+		creditPad = 0;
+		transferLength = pPacket->ActualLength + HTC_HDR_LENGTH;
+		creditRemainder = transferLength % pEndpoint->TxCreditSize;
+		if (creditRemainder != 0) {
+			if (transferLength < pEndpoint->TxCreditSize) {
+				creditPad =
+					pEndpoint->TxCreditSize - transferLength;
+			} else {
+				creditPad = creditRemainder;
+			}
+			transferLength += creditPad;
+		}
+
+		netbuf = GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket);
+		frag_count = qdf_nbuf_get_num_frags(netbuf);
+		sg_needed = frag_count + (creditPad ? 1 : 0);
+
+		if (bundlesSpaceRemaining < transferLength ||
+		    sg_count + sg_needed > target->tx_bundle_sg_max) {
+			if (!sg_count) {
+				/* too big for any bundle, caller sends it */
+				HTC_PACKET_ENQUEUE_TO_HEAD(pPktQueue, pPacket);
+				free_htc_bundle_packet(target, pPacketTx);
+				return;
+			}
+			/* send out previous bundle */
+			htc_send_bundled_sg(target, pEndpoint, pPacketTx,
+					    sg_list, sg_count, data_len);
+			if (HTC_PACKET_QUEUE_DEPTH(pPktQueue) + 1 <
+			    HTC_MIN_MSG_PER_BUNDLE) {
+				HTC_PACKET_ENQUEUE_TO_HEAD(pPktQueue, pPacket);
+				return;
+			}
+			bundlesSpaceRemaining =
+				target->MaxMsgsPerHTCBundle *
+				pEndpoint->TxCreditSize;
+			sg_count = 0;
+			data_len = 0;
+			pPacketTx = allocate_htc_bundle_packet(target);
+			if (!pPacketTx) {
+				/* good time to panic */
+				AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+						("allocate_htc_bundle_packet failed \n"));
+				AR_DEBUG_ASSERT(false);
+				HTC_PACKET_ENQUEUE_TO_HEAD(pPktQueue, pPacket);
+				return;
+			}
+			pQueueSave = (HTC_PACKET_QUEUE *) pPacketTx->pContext;
+		}
+
+		bundlesSpaceRemaining -= transferLength;
+
+		pHtcHdr = (HTC_FRAME_HDR *) qdf_nbuf_get_frag_vaddr(netbuf, 0);
+		HTC_WRITE32(pHtcHdr,
+			    SM(pPacket->ActualLength,
+			       HTC_FRAME_HDR_PAYLOADLEN) |
+			    SM(pPacket->PktInfo.AsTx.SendFlags |
+			       HTC_FLAGS_SEND_BUNDLE,
+			       HTC_FRAME_HDR_FLAGS) |
+			    SM(pPacket->Endpoint,
+			       HTC_FRAME_HDR_ENDPOINTID));
+		HTC_WRITE32((uint32_t *) pHtcHdr + 1,
+			    SM(pPacket->PktInfo.AsTx.SeqNo,
+			       HTC_FRAME_HDR_CONTROLBYTES1) |
+			    SM(creditPad, HTC_FRAME_HDR_RESERVED));
+		pHtcHdr->reserved = creditPad;
+
+		nbytes = pPacket->ActualLength + HTC_HDR_LENGTH;
+		for (i = 0; i < frag_count && nbytes > 0; i++) {
+			int frag_len = qdf_nbuf_get_frag_len(netbuf, i);
+
+			if (frag_len > nbytes)
+				frag_len = nbytes;
+			sg_list[sg_count].buffer =
+				qdf_nbuf_get_frag_vaddr(netbuf, i);
+			sg_list[sg_count].length = frag_len;
+			sg_count++;
+			nbytes -= frag_len;
+		}
+		if (creditPad) {
+			sg_list[sg_count].buffer = target->tx_bundle_pad_buf;
+			sg_list[sg_count].length = creditPad;
+			sg_count++;
+		}
+		data_len += transferLength;
+		HTC_PACKET_ENQUEUE(pQueueSave, pPacket);
+	}
+
+	if (sg_count) {
+		/* send out remaining bundle */
+		htc_send_bundled_sg(target, pEndpoint, pPacketTx,
+				    sg_list, sg_count, data_len);
+	} else {
+		free_htc_bundle_packet(target, pPacketTx);
+	}
+}
+#endif
+
 /**
  * htc_issue_packets_bundle() - HTC function to send bundle packets from a queue
  * @target: HTC target on which packets need to be sent
@@ -405,6 +788,13 @@ static void htc_issue_packets_bundle(HTC_TARGET *target,
 		0;
 	HTC_PACKET_QUEUE *pQueueSave = NULL;
 
+#ifdef HIF_SDIO
+	if (target->tx_bundle_sg_max) {
+		htc_issue_packets_bundle_sg(target, pEndpoint, pPktQueue);
+		return;
+	}
+#endif
+
 	bundlesSpaceRemaining =
 		target->MaxMsgsPerHTCBundle * pEndpoint->TxCreditSize;
 	pPacketTx = allocate_htc_bundle_packet(target);
@@ -617,7 +1007,7 @@ static A_STATUS htc_issue_packets(HTC_TARGET *target,
 		}
 		LOCK_HTC_TX(target);
 		/* store in look up queue to match completions */
-		HTC_PACKET_ENQUEUE(&pEndpoint->TxLookupQueue, pPacket);
+		htc_tx_lookup_enqueue(pEndpoint, pPacket);
 		INC_HTC_EP_STAT(pEndpoint, TxIssued, 1);
 		pEndpoint->ul_outstanding_cnt++;
 		UNLOCK_HTC_TX(target);
@@ -648,7 +1038,7 @@ static A_STATUS htc_issue_packets(HTC_TARGET *target,
 			LOCK_HTC_TX(target);
 			target->ce_send_cnt--;
 			pEndpoint->ul_outstanding_cnt--;
-			HTC_PACKET_REMOVE(&pEndpoint->TxLookupQueue, pPacket);
+			htc_tx_lookup_remove(pEndpoint, pPacket);
 			/* reclaim credits */
 				pEndpoint->TxCredits +=
 					pPacket->PktInfo.AsTx.CreditsUsed;
@@ -765,6 +1155,7 @@ void get_htc_send_packets_credit_based(HTC_TARGET *target,
 	} else {
 		tx_queue = &pm_queue;
 	}
+	pEndpoint->tx_credits_seek = 0;
 
 	/* loop until we can grab as many packets out of the queue as we can */
 	while (true) {
@@ -823,12 +1214,16 @@ void get_htc_send_packets_credit_based(HTC_TARGET *target,
 						 pEndpoint->TxCredits,
 						 creditsRequired));
 #endif
+				/* let the credit rebalancer know */
+				pEndpoint->tx_credits_seek = creditsRequired;
+				pEndpoint->tx_credit_starved++;
 				if (do_pm_get)
 					hif_pm_runtime_put(target->hif_dev);
 				break;
 			}
 
 			pEndpoint->TxCredits -= creditsRequired;
+			pEndpoint->tx_credits_used += creditsRequired;
 			INC_HTC_EP_STAT(pEndpoint, TxCreditsConsummed,
 					creditsRequired);
 
@@ -959,24 +1354,63 @@ void get_htc_send_packets(HTC_TARGET *target,
 }
 
 /**
- * htc_try_send() - Send packets in a queue on an endpoint
+ * htc_tx_trim_to_budget() - return packets beyond a budget to the TX queue
+ * @target: HTC target
+ * @pEndpoint: endpoint the packets were taken from
+ * @pQueue: packets taken by get_htc_send_packets()
+ * @budget: number of packets that may stay in @pQueue
+ *
+ * Only for packets that did not consume credits. Must be called with the
+ * TX lock held.
+ *
+ * Return: none
+ */
+static void htc_tx_trim_to_budget(HTC_TARGET *target, HTC_ENDPOINT *pEndpoint,
+				  HTC_PACKET_QUEUE *pQueue, uint32_t budget)
+{
+	HTC_PACKET *pPacket;
+
+	while (HTC_PACKET_QUEUE_DEPTH(pQueue) > budget) {
+		pPacket = htc_packet_dequeue_tail(pQueue);
+		if (pPacket->PktInfo.AsTx.Tag != HTC_TX_PACKET_TAG_AUTO_PM)
+			hif_pm_runtime_put(target->hif_dev);
+		HTC_PACKET_ENQUEUE_TO_HEAD(&pEndpoint->TxQueue, pPacket);
+	}
+}
+
+/**
+ * htc_try_send_limit() - Send up to a number of packets on an endpoint
  * @target: HTC target on which packets need to be sent
  * @pEndpoint: logical endpoint on which packets needs to be sent
  * @pCallersSendQueue: packet queue containing the list of packets to be sent
+ * @max_pkts: packets to issue before returning, HTC_TX_SEND_UNLIMITED to
+ *	drain as long as there are transmit resources, 0 to only move the
+ *	caller's packets to the endpoint TX queue
+ * @pkts_sent: if not NULL, set to the number of packets issued
+ *
+ * With credit flow the packets taken for the credits on hand are all
+ * issued, so @pkts_sent may exceed @max_pkts.
  *
  * Return: HTC_SEND_QUEUE_RESULT indicates whether the packet was queued to be
  *         sent or the packet should be dropped by the upper layer
  */
-static HTC_SEND_QUEUE_RESULT htc_try_send(HTC_TARGET *target,
-					  HTC_ENDPOINT *pEndpoint,
-					  HTC_PACKET_QUEUE *pCallersSendQueue)
+static HTC_SEND_QUEUE_RESULT htc_try_send_limit(HTC_TARGET *target,
+					HTC_ENDPOINT *pEndpoint,
+					HTC_PACKET_QUEUE *pCallersSendQueue,
+					uint32_t max_pkts,
+					uint32_t *pkts_sent)
 {
 	HTC_PACKET_QUEUE sendQueue;     /* temp queue to hold packets at various stages */
 	HTC_PACKET *pPacket;
 	int tx_resources;
 	int overflow;
+	uint32_t sent = 0;
+	uint32_t issued;
 	HTC_SEND_QUEUE_RESULT result = HTC_SEND_QUEUE_OK;
 
+	if (pkts_sent)
+		*pkts_sent = 0;
+
 	AR_DEBUG_PRINTF(ATH_DEBUG_SEND, ("+htc_try_send (Queue:%p Depth:%d)\n",
 					 pCallersSendQueue,
 					 (pCallersSendQueue ==
@@ -1119,6 +1553,13 @@ static HTC_SEND_QUEUE_RESULT htc_try_send(HTC_TARGET *target,
 		INIT_HTC_PACKET_QUEUE(&sendQueue);
 	}
 
+	if (!max_pkts) {
+		/* queue only, the caller runs the tx scheduler */
+		UNLOCK_HTC_TX(target);
+		AR_DEBUG_PRINTF(ATH_DEBUG_SEND, ("-htc_try_send (queued)\n"));
+		return HTC_SEND_QUEUE_OK;
+	}
+
 	/* increment tx processing count on entry */
 	if (qdf_atomic_inc_return(&pEndpoint->TxProcessCount) > 1) {
 		/* another thread or task is draining the TX queues on this endpoint
@@ -1181,6 +1622,12 @@ static HTC_SEND_QUEUE_RESULT htc_try_send(HTC_TARGET *target,
 			break;
 		}
 
+		if (!IS_TX_CREDIT_FLOW_ENABLED(pEndpoint))
+			htc_tx_trim_to_budget(target, pEndpoint, &sendQueue,
+					      max_pkts - sent);
+
+		issued = HTC_PACKET_QUEUE_DEPTH(&sendQueue);
+
 		UNLOCK_HTC_TX(target);
 
 		/* send what we can */
@@ -1199,6 +1646,7 @@ static HTC_SEND_QUEUE_RESULT htc_try_send(HTC_TARGET *target,
 			LOCK_HTC_TX(target);
 			break;
 		}
+		sent += issued;
 
 		if (!IS_TX_CREDIT_FLOW_ENABLED(pEndpoint)) {
 			tx_resources =
@@ -1208,6 +1656,8 @@ static HTC_SEND_QUEUE_RESULT htc_try_send(HTC_TARGET *target,
 
 		LOCK_HTC_TX(target);
 
+		if (sent >= max_pkts)
+			break;
 	}
 
 	/* done with this endpoint, we can clear the count */
@@ -1215,11 +1665,31 @@ static HTC_SEND_QUEUE_RESULT htc_try_send(HTC_TARGET *target,
 
 	UNLOCK_HTC_TX(target);
 
+	if (pkts_sent)
+		*pkts_sent = sent;
+
 	AR_DEBUG_PRINTF(ATH_DEBUG_SEND, ("-htc_try_send:  \n"));
 
 	return HTC_SEND_QUEUE_OK;
 }
 
+/**
+ * htc_try_send() - Send packets in a queue on an endpoint
+ * @target: HTC target on which packets need to be sent
+ * @pEndpoint: logical endpoint on which packets needs to be sent
+ * @pCallersSendQueue: packet queue containing the list of packets to be sent
+ *
+ * Return: HTC_SEND_QUEUE_RESULT indicates whether the packet was queued to be
+ *         sent or the packet should be dropped by the upper layer
+ */
+static inline HTC_SEND_QUEUE_RESULT htc_try_send(HTC_TARGET *target,
+					HTC_ENDPOINT *pEndpoint,
+					HTC_PACKET_QUEUE *pCallersSendQueue)
+{
+	return htc_try_send_limit(target, pEndpoint, pCallersSendQueue,
+				  HTC_TX_SEND_UNLIMITED, NULL);
+}
+
 #ifdef USB_HIF_SINGLE_PIPE_DATA_SCHED
 static uint16_t htc_send_pkts_sched_check(HTC_HANDLE HTCHandle, HTC_ENDPOINT_ID id)
 {
@@ -1385,14 +1855,19 @@ A_STATUS htc_send_pkts_multiple(HTC_HANDLE HTCHandle, HTC_PACKET_QUEUE *pPktQueu
 	}
 	HTC_PACKET_QUEUE_ITERATE_END;
 
+	/* queue the packets and let the pipe's tx scheduler send them, so
+	 * the deficit round robin also holds while the pipe is not backed up
+	 */
 #ifdef USB_HIF_SINGLE_PIPE_DATA_SCHED
 	if (!htc_send_pkts_sched_check(HTCHandle, pEndpoint->Id)) {
 		htc_send_pkts_sched_queue(HTCHandle, pPktQueue, pEndpoint->Id);
 	} else {
-		htc_try_send(target, pEndpoint, pPktQueue);
+		htc_try_send_limit(target, pEndpoint, pPktQueue, 0, NULL);
+		htc_tx_resource_avail_handler(target, pEndpoint->UL_PipeID);
 	}
 #else
-	htc_try_send(target, pEndpoint, pPktQueue);
+	htc_try_send_limit(target, pEndpoint, pPktQueue, 0, NULL);
+	htc_tx_resource_avail_handler(target, pEndpoint->UL_PipeID);
 #endif
 
 	/* do completion on any packets that couldn't get in */
@@ -1680,7 +2155,7 @@ A_STATUS htc_send_data_pkt(HTC_HANDLE HTCHandle, HTC_PACKET *pPacket,
 
 		LOCK_HTC_TX(target);
 		/* store in look up queue to match completions */
-		HTC_PACKET_ENQUEUE(&pEndpoint->TxLookupQueue, pPacket);
+		htc_tx_lookup_enqueue(pEndpoint, pPacket);
 		INC_HTC_EP_STAT(pEndpoint, TxIssued, 1);
 		pEndpoint->ul_outstanding_cnt++;
 		UNLOCK_HTC_TX(target);
@@ -1703,7 +2178,7 @@ A_STATUS htc_send_data_pkt(HTC_HANDLE HTCHandle, HTC_PACKET *pPacket,
 			LOCK_HTC_TX(target);
 			pEndpoint->ul_outstanding_cnt--;
 			/* remove this packet from the tx completion queue */
-			HTC_PACKET_REMOVE(&pEndpoint->TxLookupQueue, pPacket);
+			htc_tx_lookup_remove(pEndpoint, pPacket);
 
 			/*
 			 * Don't bother reclaiming credits - HTC flow control
@@ -1746,9 +2221,9 @@ A_STATUS htc_send_data_pkt(HTC_HANDLE HTCHandle, HTC_PACKET *pPacket,
  * In the adapted HIF layer, qdf_nbuf_t are passed between HIF and HTC,
  * since upper layers expects HTC_PACKET containers we use the completed netbuf
  * and lookup its corresponding HTC packet buffer from a lookup list.
- * This is extra overhead that can be fixed by re-aligning HIF interfaces
- * with HTC.
- *
+ * Completions are normally in order so the head of the lookup queue is tried
+ * first; anything else is resolved through the per endpoint netbuf hash, and
+ * the queue is only walked for packets that did not fit in the hash.
  */
 static HTC_PACKET *htc_lookup_tx_packet(HTC_TARGET *target,
 					HTC_ENDPOINT *pEndpoint,
@@ -1758,25 +2233,42 @@ static HTC_PACKET *htc_lookup_tx_packet(HTC_TARGET *target,
 	HTC_PACKET *pFoundPacket = NULL;
 	HTC_PACKET_QUEUE lookupQueue;
 
-	INIT_HTC_PACKET_QUEUE(&lookupQueue);
 	LOCK_HTC_TX(target);
 
 	/* mark that HIF has indicated the send complete for another packet */
 	pEndpoint->ul_outstanding_cnt--;
 
-	/* Dequeue first packet directly because of in-order completion */
-	pPacket = htc_packet_dequeue(&pEndpoint->TxLookupQueue);
+	pPacket = htc_get_pkt_at_head(&pEndpoint->TxLookupQueue);
 	if (qdf_unlikely(!pPacket)) {
 		UNLOCK_HTC_TX(target);
 		return NULL;
 	}
+
+	pFoundPacket = htc_tx_lookup_unhash(&pEndpoint->tx_lookup_tbl, netbuf);
+	if (pFoundPacket) {
+		if (pFoundPacket != pPacket)
+			pEndpoint->tx_ooo_cmpl_cnt++;
+		HTC_PACKET_REMOVE(&pEndpoint->TxLookupQueue, pFoundPacket);
+		UNLOCK_HTC_TX(target);
+		return pFoundPacket;
+	}
+
+	if (!pEndpoint->tx_lookup_tbl.unhashed) {
+		UNLOCK_HTC_TX(target);
+		return NULL;
+	}
+
+	/* Dequeue first packet directly because of in-order completion */
+	pPacket = htc_packet_dequeue(&pEndpoint->TxLookupQueue);
 	if (netbuf == (qdf_nbuf_t) GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket)) {
+		pEndpoint->tx_lookup_tbl.unhashed--;
 		UNLOCK_HTC_TX(target);
 		return pPacket;
-	} else {
-		HTC_PACKET_ENQUEUE(&lookupQueue, pPacket);
 	}
 
+	INIT_HTC_PACKET_QUEUE_AND_ADD(&lookupQueue, pPacket);
+	pEndpoint->tx_ooo_cmpl_cnt++;
+
 	/*
 	 * Move TX lookup queue to temp queue because most of packets that are not index 0
 	 * are not top 10 packets.
@@ -1785,6 +2277,7 @@ static HTC_PACKET *htc_lookup_tx_packet(HTC_TARGET *target,
 					  &pEndpoint->TxLookupQueue);
 	UNLOCK_HTC_TX(target);
 
+	pFoundPacket = NULL;
 	ITERATE_OVER_LIST_ALLOW_REMOVE(&lookupQueue.QueueHead, pPacket,
 				       HTC_PACKET, ListLink) {
 
@@ -1807,6 +2300,8 @@ static HTC_PACKET *htc_lookup_tx_packet(HTC_TARGET *target,
 	LOCK_HTC_TX(target);
 	HTC_PACKET_QUEUE_TRANSFER_TO_HEAD(&pEndpoint->TxLookupQueue,
 					  &lookupQueue);
+	if (pFoundPacket)
+		pEndpoint->tx_lookup_tbl.unhashed--;
 	UNLOCK_HTC_TX(target);
 
 	return pFoundPacket;
@@ -1866,7 +2361,8 @@ QDF_STATUS htc_tx_completion_handler(void *Context,
 
 			if (hif_get_bus_type(target->hif_dev) == QDF_BUS_TYPE_USB) {
 				if (!IS_TX_CREDIT_FLOW_ENABLED(pEndpoint))
-					htc_try_send(target, pEndpoint, NULL);
+					htc_tx_resource_avail_handler(target,
+							pEndpoint->UL_PipeID);
 			}
 
 			return QDF_STATUS_SUCCESS;
@@ -1881,8 +2377,9 @@ QDF_STATUS htc_tx_completion_handler(void *Context,
 	if (!IS_TX_CREDIT_FLOW_ENABLED(pEndpoint)) {
 		/* note: when using TX credit flow, the re-checking of queues happens
 		* when credits flow back from the target.
-		* in the non-TX credit case, we recheck after the packet completes */
-		htc_try_send(target, pEndpoint, NULL);
+		* in the non-TX credit case, the completion freed a pipe resource,
+		* let the tx scheduler pick the endpoint that gets it */
+		htc_tx_resource_avail_handler(target, pEndpoint->UL_PipeID);
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -1907,34 +2404,145 @@ void htc_ctrl_msg_cmpl(HTC_HANDLE htc_pdev, HTC_ENDPOINT_ID htc_ep_id)
 }
 #endif
 
-/* callback when TX resources become available */
-void htc_tx_resource_avail_handler(void *context, uint8_t pipeID)
+/**
+ * htc_tx_sched_run() - one deficit round robin pass over a UL pipe
+ * @target: HTC target
+ * @pipeID: UL pipe whose endpoints are served
+ *
+ * Every backlogged endpoint on @pipeID gets its weight added to its
+ * deficit each round and may then issue up to deficit packets. Rounds
+ * repeat until the endpoints are drained or the pipe runs out of
+ * resources; the endpoint that hit the limit is served first next time.
+ * An endpoint that sends nothing while the pipe still has resources (out
+ * of credits, or drained by another context) is skipped for the round.
+ *
+ * Return: none
+ */
+static void htc_tx_sched_run(HTC_TARGET *target, uint8_t pipeID)
 {
+	struct htc_tx_sched_pipe *sched = &target->tx_sched[pipeID];
+	HTC_ENDPOINT *pEndpoint;
+	uint32_t sent;
+	int backlogged;
+	int round;
+	int start;
+	int n;
 	int i;
-	HTC_TARGET *target = (HTC_TARGET *) context;
-	HTC_ENDPOINT *pEndpoint = NULL;
 
-	for (i = 0; i < ENDPOINT_MAX; i++) {
-		pEndpoint = &target->endpoint[i];
-		if (pEndpoint->service_id != 0) {
-			if (pEndpoint->UL_PipeID == pipeID) {
-				break;
+	for (round = 0; round < HTC_TX_SCHED_MAX_ROUNDS; round++) {
+		backlogged = 0;
+		start = sched->next_ep;
+
+		for (n = 0; n < ENDPOINT_MAX; n++) {
+			i = (start + n) % ENDPOINT_MAX;
+			pEndpoint = &target->endpoint[i];
+			if (pEndpoint->service_id == 0 ||
+			    pEndpoint->UL_PipeID != pipeID)
+				continue;
+
+			if (HTC_QUEUE_EMPTY(&pEndpoint->TxQueue)) {
+				/* idle endpoints do not bank service */
+				pEndpoint->tx_sched_deficit = 0;
+				continue;
+			}
+
+			/* a positive deficit left from a blocked pass is not
+			 * added to, a negative one from credit overshoot is
+			 * paid back
+			 */
+			pEndpoint->tx_sched_deficit =
+				QDF_MIN(pEndpoint->tx_sched_deficit +
+					(int32_t)pEndpoint->tx_sched_weight,
+					(int32_t)pEndpoint->tx_sched_weight);
+			if (pEndpoint->tx_sched_deficit <= 0) {
+				backlogged++;
+				continue;
+			}
+
+			htc_try_send_limit(target, pEndpoint, NULL,
+					   pEndpoint->tx_sched_deficit, &sent);
+			pEndpoint->tx_sched_deficit -= sent;
+			pEndpoint->tx_sched_pkts += sent;
+
+			if (!sent) {
+				if (hif_get_free_queue_number(target->hif_dev,
+							      pipeID) == 0) {
+					/* pipe is out of resources */
+					pEndpoint->tx_sched_deferred++;
+					sched->next_ep = i;
+					return;
+				}
+				/* out of credits or another context is
+				 * draining it, serve the rest of the pipe
+				 */
+				continue;
 			}
+
+			if (!HTC_QUEUE_EMPTY(&pEndpoint->TxQueue))
+				backlogged++;
 		}
-	}
 
-	if (i >= ENDPOINT_MAX) {
-		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
-				("Invalid pipe indicated for TX resource avail : %d!\n",
-				 pipeID));
-		return;
+		if (!backlogged)
+			break;
 	}
+}
+
+/* callback when TX resources become available */
+void htc_tx_resource_avail_handler(void *context, uint8_t pipeID)
+{
+	HTC_TARGET *target = (HTC_TARGET *) context;
+	HTC_ENDPOINT *pEndpoint;
+	struct htc_tx_sched_pipe *sched;
+	int i;
 
 	AR_DEBUG_PRINTF(ATH_DEBUG_SEND,
 			("HIF indicated more resources for pipe:%d \n",
 			 pipeID));
 
-	htc_try_send(target, pEndpoint, NULL);
+	if (pipeID >= HTC_TX_SCHED_PIPE_MAX) {
+		/* no scheduler state for this pipe, serve it unscheduled */
+		for (i = 0; i < ENDPOINT_MAX; i++) {
+			pEndpoint = &target->endpoint[i];
+			if (pEndpoint->service_id != 0 &&
+			    pEndpoint->UL_PipeID == pipeID)
+				htc_try_send(target, pEndpoint, NULL);
+		}
+		return;
+	}
+
+	/* one context runs the scheduler per pipe, kicks that arrive while
+	 * it runs make it go around once more
+	 */
+	sched = &target->tx_sched[pipeID];
+	qdf_atomic_set(&sched->pending, 1);
+	while (qdf_atomic_read(&sched->pending)) {
+		if (qdf_atomic_inc_return(&sched->busy) > 1) {
+			qdf_atomic_dec(&sched->busy);
+			return;
+		}
+		qdf_atomic_set(&sched->pending, 0);
+		htc_tx_sched_run(target, pipeID);
+		qdf_atomic_dec(&sched->busy);
+	}
+}
+
+/**
+ * htc_set_endpoint_tx_weight() - set the tx scheduler weight of an endpoint
+ * @HTCHandle: HTC handle
+ * @Endpoint: endpoint to configure
+ * @weight: packets the endpoint may send per scheduler round
+ *
+ * Return: none
+ */
+void htc_set_endpoint_tx_weight(HTC_HANDLE HTCHandle, HTC_ENDPOINT_ID Endpoint,
+				uint32_t weight)
+{
+	HTC_TARGET *target = GET_HTC_TARGET_FROM_HANDLE(HTCHandle);
+
+	if (Endpoint >= ENDPOINT_MAX || !weight)
+		return;
+
+	target->endpoint[Endpoint].tx_sched_weight = weight;
 }
 
 #ifdef FEATURE_RUNTIME_PM
@@ -2015,6 +2623,67 @@ bool htc_is_endpoint_active(HTC_HANDLE HTCHandle, HTC_ENDPOINT_ID Endpoint)
 	return true;
 }
 
+/**
+ * htc_credit_rebalance() - lend idle tx credits to starved endpoints
+ * @target: HTC target
+ *
+ * Credits stand for target buffers shared by all services, so credits an
+ * idle endpoint holds above its minimum can be moved to an endpoint that
+ * ran out of credits with packets queued. A starved endpoint is topped up
+ * to what its queue needs, within its maximum. Must be called with the
+ * TX lock held.
+ *
+ * Return: bitmap of endpoints that received credits
+ */
+static uint32_t htc_credit_rebalance(HTC_TARGET *target)
+{
+	HTC_ENDPOINT *rcv;
+	HTC_ENDPOINT *donor;
+	uint32_t topped_up = 0;
+	int need;
+	int give;
+	int i;
+	int j;
+
+	for (i = ENDPOINT_1; i < ENDPOINT_MAX; i++) {
+		rcv = &target->endpoint[i];
+		if (rcv->service_id == 0 || !IS_TX_CREDIT_FLOW_ENABLED(rcv) ||
+		    !rcv->tx_credits_seek || HTC_QUEUE_EMPTY(&rcv->TxQueue))
+			continue;
+
+		need = QDF_MAX(rcv->tx_credits_seek,
+			       HTC_PACKET_QUEUE_DEPTH(&rcv->TxQueue) *
+			       rcv->TxCreditsPerMaxMsg);
+		if (rcv->tx_credits_max)
+			need = QDF_MIN(need, rcv->tx_credits_max);
+		need -= rcv->TxCredits;
+
+		for (j = ENDPOINT_1; j < ENDPOINT_MAX && need > 0; j++) {
+			donor = &target->endpoint[j];
+			if (donor == rcv || donor->service_id == 0 ||
+			    !IS_TX_CREDIT_FLOW_ENABLED(donor) ||
+			    !HTC_QUEUE_EMPTY(&donor->TxQueue) ||
+			    donor->TxCredits <= donor->tx_credits_min)
+				continue;
+
+			give = QDF_MIN(donor->TxCredits -
+				       donor->tx_credits_min, need);
+			donor->TxCredits -= give;
+			donor->tx_credits_lent += give;
+			rcv->TxCredits += give;
+			rcv->tx_credits_borrowed += give;
+			need -= give;
+		}
+
+		if (rcv->TxCredits >= rcv->tx_credits_seek) {
+			rcv->tx_credits_seek = 0;
+			topped_up |= 1 << i;
+		}
+	}
+
+	return topped_up;
+}
+
 /**
  * htc_process_credit_rpt() - process credit report, call distribution function
  * @target: pointer to HTC_TARGET
@@ -2031,6 +2700,7 @@ void htc_process_credit_rpt(HTC_TARGET *target, HTC_CREDIT_REPORT *pRpt,
 	HTC_ENDPOINT *pEndpoint;
 	int totalCredits = 0;
 	uint8_t rpt_credits, rpt_ep_id;
+	uint32_t topped_up;
 
 	AR_DEBUG_PRINTF(ATH_DEBUG_SEND,
 			("+htc_process_credit_rpt, Credit Report Entries:%d \n",
@@ -2118,6 +2788,25 @@ void htc_process_credit_rpt(HTC_TARGET *target, HTC_CREDIT_REPORT *pRpt,
 			("  Report indicated %d credits to distribute \n",
 			 totalCredits));
 
+	topped_up = htc_credit_rebalance(target);
+	for (i = ENDPOINT_1; topped_up && i < ENDPOINT_MAX; i++) {
+		if (!(topped_up & (1 << i)))
+			continue;
+
+		topped_up &= ~(1 << i);
+		pEndpoint = &target->endpoint[i];
+		UNLOCK_HTC_TX(target);
+#ifdef ATH_11AC_TXCOMPACT
+		htc_try_send(target, pEndpoint, NULL);
+#else
+		if (pEndpoint->service_id == HTT_DATA_MSG_SVC)
+			htc_send_data_pkt(target, NULL, 0);
+		else
+			htc_try_send(target, pEndpoint, NULL);
+#endif
+		LOCK_HTC_TX(target);
+	}
+
 	UNLOCK_HTC_TX(target);
 
 	AR_DEBUG_PRINTF(ATH_DEBUG_SEND, ("-htc_process_credit_rpt \n"));
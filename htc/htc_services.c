@@ -97,6 +97,31 @@ htc_alt_data_credit_size_update(HTC_TARGET *target,
 }
 #endif
 
+/**
+ * htc_tx_sched_default_weight() - default tx scheduler weight of a service
+ * @service_id: service the endpoint is connected to
+ *
+ * Control and voice get the largest share of a shared UL pipe so bulk
+ * best effort traffic cannot starve them.
+ *
+ * Return: packets per scheduler round
+ */
+static uint32_t htc_tx_sched_default_weight(HTC_SERVICE_ID service_id)
+{
+	switch (service_id) {
+	case WMI_CONTROL_SVC:
+	case WMI_DATA_VO_SVC:
+		return 4 * HTC_TX_SCHED_WEIGHT_DEFAULT;
+	case WMI_DATA_VI_SVC:
+	case HTT_DATA_MSG_SVC:
+		return 2 * HTC_TX_SCHED_WEIGHT_DEFAULT;
+	case WMI_DATA_BK_SVC:
+		return HTC_TX_SCHED_WEIGHT_DEFAULT / 2;
+	default:
+		return HTC_TX_SCHED_WEIGHT_DEFAULT;
+	}
+}
+
 A_STATUS htc_connect_service(HTC_HANDLE HTCHandle,
 			     HTC_SERVICE_CONNECT_REQ *pConnectReq,
 			     HTC_SERVICE_CONNECT_RESP *pConnectResp)
@@ -343,6 +368,7 @@ A_STATUS htc_connect_service(HTC_HANDLE HTCHandle,
 		pEndpoint->MaxTxQueueDepth = pConnectReq->MaxSendQueueDepth;
 		pEndpoint->MaxMsgLength = maxMsgSize;
 		pEndpoint->TxCredits = txAlloc;
+		htc_credit_policy_apply(target, pEndpoint, txAlloc);
 		pEndpoint->TxCreditSize = target->TargetCreditSize;
 		pEndpoint->TxCreditsPerMaxMsg =
 			maxMsgSize / target->TargetCreditSize;
@@ -357,6 +383,13 @@ A_STATUS htc_connect_service(HTC_HANDLE HTCHandle,
 
 		/* copy all the callbacks */
 		pEndpoint->EpCallBacks = pConnectReq->EpCallbacks;
+		pEndpoint->tx_sched_weight =
+			htc_tx_sched_default_weight(pEndpoint->service_id);
+		pEndpoint->tx_sched_deficit = 0;
+#ifdef RX_SG_SUPPORT
+		pEndpoint->rx_sg_chain = !!(pConnectReq->LocalConnectionFlags &
+					    HTC_LOCAL_CONN_FLAGS_RX_SG_CHAIN);
+#endif
 
 		status = hif_map_service_to_pipe(target->hif_dev,
 						 pEndpoint->service_id,
@@ -47,6 +47,13 @@
 #define QDF_TIMER_STATE_COOKIE (0x12)
 #define QDF_MC_TIMER_TO_MS_UNIT (1000)
 #define QDF_MC_TIMER_TO_SEC_UNIT (1000000)
+/*
+ * Slack given to QDF_TIMER_TYPE_SW timers started with qdf_mc_timer_start()
+ * in FEATURE_QDF_MC_HRTIMER mode, as a right shift of the expiry: the
+ * timer may fire up to 1/8 of its interval late, so it can be batched
+ * with other timers expiring in that window.
+ */
+#define QDF_MC_TIMER_SW_SLACK_SHIFT (3)
 
 /* Type declarations */
 /* qdf Timer callback function prototype (well, actually a prototype for
@@ -209,6 +216,25 @@ QDF_STATUS qdf_mc_timer_destroy(qdf_mc_timer_t *timer);
  */
 QDF_STATUS qdf_mc_timer_start(qdf_mc_timer_t *timer, uint32_t expiration_time);
 
+/**
+ * qdf_mc_timer_start_us() - start a QDF Timer object with usec resolution
+ * @timer: Pointer to timer object
+ * @expiration_us: Time to expire, in microseconds
+ * @slack_us: How much later than @expiration_us the timer may expire
+ *
+ * Like qdf_mc_timer_start(), but without the 10 ms lower bound. With
+ * FEATURE_QDF_MC_HRTIMER the timer expires anywhere in
+ * [@expiration_us, @expiration_us + @slack_us], which lets the kernel
+ * serve timers with overlapping windows from a single wakeup. Without
+ * it, the expiry is rounded up to whole jiffies and @slack_us is ignored.
+ *
+ * Return:
+ * QDF_STATUS_SUCCESS - Timer is initialized successfully
+ * QDF failure status - Timer initialization failed
+ */
+QDF_STATUS qdf_mc_timer_start_us(qdf_mc_timer_t *timer, uint32_t expiration_us,
+				 uint32_t slack_us);
+
 /**
  * qdf_mc_timer_stop() - stop a QDF Timer
  * @timer: Pointer to timer object
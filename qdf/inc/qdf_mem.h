@@ -67,6 +67,10 @@ struct qdf_mem_multi_page_t {
 /* Preprocessor definitions and constants */
 
 typedef __qdf_mempool_t qdf_mempool_t;
+typedef struct __qdf_mempool_stats qdf_mempool_stats_t;
+
+/* qdf_mempool_init flag: cache free elements in per cpu magazines */
+#define QDF_MEMPOOL_F_PERCPU __QDF_MEMPOOL_F_PERCPU
 #ifdef MEMORY_DEBUG
 void qdf_mem_clean(void);
 
@@ -225,7 +229,7 @@ static inline void qdf_mem_unmap_nbytes_single(qdf_device_t osdev,
  * @pool_addr: address of the pool created
  * @elem_cnt: no. of elements in pool
  * @elem_size: size of each pool element in bytes
- * @flags: flags
+ * @flags: flags, QDF_MEMPOOL_F_PERCPU to add per cpu magazines
  * Return: Handle to memory pool or NULL if allocation failed
  */
 static inline int qdf_mempool_init(qdf_device_t osdev,
@@ -271,6 +275,48 @@ static inline void qdf_mempool_free(qdf_device_t osdev, qdf_mempool_t pool,
 	__qdf_mempool_free(osdev, pool, buf);
 }
 
+/**
+ * qdf_mempool_alloc_batch - Allocate several elements from a memory pool
+ * @osdev: platform device object
+ * @pool: Handle to memory pool
+ * @bufs: filled with the allocated elements
+ * @num: number of elements wanted
+ * Return: number of elements allocated, less than @num if the pool ran dry
+ */
+static inline int qdf_mempool_alloc_batch(qdf_device_t osdev,
+					  qdf_mempool_t pool,
+					  void **bufs, int num)
+{
+	return __qdf_mempool_alloc_batch(osdev, pool, bufs, num);
+}
+
+/**
+ * qdf_mempool_free_batch - Free several memory pool elements
+ * @osdev: Platform device object
+ * @pool: Handle to memory pool
+ * @bufs: Elements to be freed
+ * @num: number of elements in @bufs
+ * Return: none
+ */
+static inline void qdf_mempool_free_batch(qdf_device_t osdev,
+					  qdf_mempool_t pool,
+					  void **bufs, int num)
+{
+	__qdf_mempool_free_batch(osdev, pool, bufs, num);
+}
+
+/**
+ * qdf_mempool_get_stats - Get the statistics of a memory pool
+ * @pool: Handle to memory pool
+ * @stats: filled with the pool statistics
+ * Return: none
+ */
+static inline void qdf_mempool_get_stats(qdf_mempool_t pool,
+					 qdf_mempool_stats_t *stats)
+{
+	__qdf_mempool_get_stats(pool, stats);
+}
+
 void qdf_mem_dma_sync_single_for_device(qdf_device_t osdev,
 					qdf_dma_addr_t bus_addr,
 					qdf_size_t size,
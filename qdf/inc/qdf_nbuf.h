@@ -1819,6 +1819,23 @@ static inline uint32_t qdf_nbuf_get_tso_info(qdf_device_t osdev,
 	return __qdf_nbuf_get_tso_info(osdev, nbuf, tso_info);
 }
 
+/**
+ * qdf_nbuf_unmap_tso_info() - release the DMA mappings of a jumbo
+ * TSO network buffer
+ * @osdev: qdf device handle
+ * @nbuf: network buffer passed to qdf_nbuf_get_tso_info()
+ * @tso_info: TSO information filled by qdf_nbuf_get_tso_info()
+ *
+ * Call once all the TSO segments have been transmitted.
+ *
+ * Return: none
+ */
+static inline void qdf_nbuf_unmap_tso_info(qdf_device_t osdev,
+		 qdf_nbuf_t nbuf, struct qdf_tso_info_t *tso_info)
+{
+	__qdf_nbuf_unmap_tso_info(osdev, nbuf, tso_info);
+}
+
 /**
  * qdf_nbuf_get_tso_num_seg() - function to calculate the number
  * of TCP segments within the TSO jumbo packet
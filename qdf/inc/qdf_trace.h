@@ -102,6 +102,8 @@ typedef enum {
 #define MAX_QDF_TRACE_RECORDS 4000
 #define INVALID_QDF_TRACE_ADDR 0xffffffff
 #define DEFAULT_QDF_TRACE_DUMP_COUNT 0
+/* per cpu ring size with FEATURE_QDF_TRACE_PER_CPU, must be a power of 2 */
+#define MAX_QDF_TRACE_CPU_RECORDS 1024
 
 #include  <i_qdf_trace.h>
 
@@ -166,6 +168,8 @@ typedef struct s_qdf_trace_data {
 
 #define MAX_QDF_DP_TRACE_RECORDS       4000
 #define QDF_DP_TRACE_RECORD_SIZE       16
+/* per cpu ring size with FEATURE_DP_TRACE_PER_CPU, must be a power of 2 */
+#define MAX_QDF_DP_TRACE_CPU_RECORDS   512
 #define INVALID_QDF_DP_TRACE_ADDR      0xffffffff
 #define QDF_DP_TRACE_VERBOSITY_HIGH    3
 #define QDF_DP_TRACE_VERBOSITY_MEDIUM  2
@@ -507,6 +507,9 @@ struct qdf_tso_seg_elem_t {
 	struct qdf_tso_seg_elem_t *next;
 };
 
+/* DMA mappings of a jumbo packet: linear area and up to 17 page frags */
+#define QDF_TSO_MAPS_MAX 18
+
 /**
  * struct qdf_tso_info_t - TSO information extracted
  * @is_tso: is this is a TSO frame
@@ -514,6 +517,8 @@ struct qdf_tso_seg_elem_t {
  * @total_len: total length of the packet
  * @tso_seg_list: list of TSO segments for this jumbo packet
  * @curr_seg: segment that is currently being processed
+ * @num_maps: number of DMA mappings held for the jumbo packet
+ * @maps: DMA address of the linear area followed by each page fragment
  *
  * This structure holds the TSO information extracted after parsing the TSO
  * jumbo network buffer. It contains a chain of the TSO segments belonging to
@@ -525,6 +530,8 @@ struct qdf_tso_info_t {
 	uint32_t total_len;
 	struct qdf_tso_seg_elem_t *tso_seg_list;
 	struct qdf_tso_seg_elem_t *curr_seg;
+	uint32_t num_maps;
+	qdf_dma_addr_t maps[QDF_TSO_MAPS_MAX];
 };
 
 /**
@@ -39,16 +39,46 @@
 #include <linux/timer.h>
 #include <linux/time.h>
 #include <linux/jiffies.h>
+#ifdef FEATURE_QDF_MC_HRTIMER
+#include <linux/version.h>
+#include <linux/hrtimer.h>
+#endif
 
 /* Preprocessor definitions and constants */
+#ifdef FEATURE_QDF_MC_HRTIMER
+/* expire in softirq context, as timer_list callbacks do, where supported */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 16, 0)
+#define QDF_MC_HRTIMER_MODE HRTIMER_MODE_REL_SOFT
+#else
+#define QDF_MC_HRTIMER_MODE HRTIMER_MODE_REL
+#endif
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 /* Type declarations */
 
+/**
+ * typedef qdf_mc_timer_platform_t - OS part of a QDF MC timer
+ * @timer: OS timer
+ * @function: expiry handler, called with @data (FEATURE_QDF_MC_HRTIMER)
+ * @data: argument of @function (FEATURE_QDF_MC_HRTIMER)
+ * @thread_id: pid of the thread which started the timer
+ * @cookie: LINUX_TIMER_COOKIE while the timer is initialized
+ * @spinlock: serializes timer state changes
+ *
+ * With FEATURE_QDF_MC_HRTIMER @timer is an hrtimer; @function and @data
+ * then take the place of the timer_list members of the same name.
+ */
 typedef struct qdf_mc_timer_platform_s {
+#ifdef FEATURE_QDF_MC_HRTIMER
+	struct hrtimer timer;
+	void (*function)(unsigned long data);
+	unsigned long data;
+#else
 	struct timer_list timer;
+#endif
 	int thread_id;
 	uint32_t cookie;
 	qdf_spinlock_t spinlock;
@@ -45,6 +45,7 @@
 #include <linux/hardirq.h>
 #include <linux/vmalloc.h>
 #include <linux/pci.h> /* pci_alloc_consistent */
+#include <linux/percpu.h>
 #if CONFIG_MCL
 #include <cds_queue.h>
 #else
@@ -66,11 +67,52 @@
 #endif /* __KERNEL__ */
 #include <qdf_status.h>
 
+/* mempool init flags */
+#define __QDF_MEMPOOL_F_PERCPU 0x1
+
 #ifdef __KERNEL__
 typedef struct mempool_elem {
 	STAILQ_ENTRY(mempool_elem) mempool_entry;
 } mempool_elem_t;
 
+/* per cpu magazine capacity and the batch moved to/from the shared list */
+#define __QDF_MEMPOOL_MAG_SIZE 32
+#define __QDF_MEMPOOL_MAG_BATCH (__QDF_MEMPOOL_MAG_SIZE / 2)
+
+/**
+ * struct __qdf_mempool_mag - per cpu LIFO cache of free pool elements
+ * @cnt: number of elements in @elems
+ * @hits: allocs and frees served without touching the shared list
+ * @refills: batches taken from the shared list
+ * @drains: batches given back to the shared list
+ * @elems: cached elements, most recently freed last
+ */
+struct __qdf_mempool_mag {
+	u_int32_t cnt;
+	u_int32_t hits;
+	u_int32_t refills;
+	u_int32_t drains;
+	void *elems[__QDF_MEMPOOL_MAG_SIZE];
+};
+
+/**
+ * struct __qdf_mempool_stats - memory pool statistics
+ * @free_cnt: elements on the shared free list
+ * @cached_cnt: elements held in per cpu magazines
+ * @hits: magazine hits, summed over all cpus
+ * @refills: magazine refills, summed over all cpus
+ * @drains: magazine drains, summed over all cpus
+ * @lock_contention: shared list lock acquisitions that had to spin
+ */
+struct __qdf_mempool_stats {
+	u_int32_t free_cnt;
+	u_int32_t cached_cnt;
+	u_int32_t hits;
+	u_int32_t refills;
+	u_int32_t drains;
+	u_int32_t lock_contention;
+};
+
 /**
  * typedef __qdf_mempool_ctxt_t - Memory pool context
  * @pool_id: pool identifier
@@ -81,7 +123,9 @@ typedef struct mempool_elem {
  * @free_list: free pool list
  * @lock: spinlock object
  * @max_elem: Maximum number of elements in tha pool
- * @free_cnt: Number of free elements available
+ * @free_cnt: Number of free elements available on free_list
+ * @lock_contention: times @lock was found already taken
+ * @mag: per cpu magazines, NULL unless __QDF_MEMPOOL_F_PERCPU is in effect
  */
 typedef struct __qdf_mempool_ctxt {
 	int pool_id;
@@ -93,6 +137,8 @@ typedef struct __qdf_mempool_ctxt {
 	spinlock_t lock;
 	u_int32_t max_elem;
 	u_int32_t free_cnt;
+	u_int32_t lock_contention;
+	struct __qdf_mempool_mag __percpu *mag;
 } __qdf_mempool_ctxt_t;
 
 #endif /* __KERNEL__ */
@@ -174,6 +220,12 @@ int __qdf_mempool_init(qdf_device_t osdev, __qdf_mempool_t *pool, int pool_cnt,
 void __qdf_mempool_destroy(qdf_device_t osdev, __qdf_mempool_t pool);
 void *__qdf_mempool_alloc(qdf_device_t osdev, __qdf_mempool_t pool);
 void __qdf_mempool_free(qdf_device_t osdev, __qdf_mempool_t pool, void *buf);
+int __qdf_mempool_alloc_batch(qdf_device_t osdev, __qdf_mempool_t pool,
+			      void **bufs, int num);
+void __qdf_mempool_free_batch(qdf_device_t osdev, __qdf_mempool_t pool,
+			      void **bufs, int num);
+void __qdf_mempool_get_stats(__qdf_mempool_t pool,
+			     struct __qdf_mempool_stats *stats);
 
 #define __qdf_mempool_elem_size(_pool) ((_pool)->elem_size);
 #endif
@@ -1029,6 +1029,9 @@ void __qdf_dmaaddr_to_32s(qdf_dma_addr_t dmaaddr,
 uint32_t __qdf_nbuf_get_tso_info(qdf_device_t osdev, struct sk_buff *skb,
 	struct qdf_tso_info_t *tso_info);
 
+void __qdf_nbuf_unmap_tso_info(qdf_device_t osdev, struct sk_buff *skb,
+	struct qdf_tso_info_t *tso_info);
+
 uint32_t __qdf_nbuf_get_tso_num_seg(struct sk_buff *skb);
 
 static inline bool __qdf_nbuf_is_tso(struct sk_buff *skb)
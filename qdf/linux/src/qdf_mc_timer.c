@@ -45,6 +45,12 @@
 #define LINUX_INVALID_TIMER_COOKIE 0xfeedface
 #define TMR_INVALID_ID (0)
 
+#ifdef CONFIG_MCL
+#define QDF_MC_TIMER_EXPIRY_HANDLER cds_linux_timer_callback
+#else
+#define QDF_MC_TIMER_EXPIRY_HANDLER NULL
+#endif
+
 /* Type declarations */
 
 /* Static Variable Definitions */
@@ -197,6 +203,104 @@ void qdf_mc_timer_manager_exit(void)
 EXPORT_SYMBOL(qdf_mc_timer_manager_exit);
 #endif
 
+#ifdef FEATURE_QDF_MC_HRTIMER
+/**
+ * qdf_mc_hrtimer_expired() - hrtimer expiry handler of a QDF MC timer
+ * @hrtimer: the expired hrtimer
+ *
+ * Hands the expiry to the handler a timer_list would have called.
+ *
+ * Return: HRTIMER_NORESTART, QDF MC timers are one-shot
+ */
+static enum hrtimer_restart qdf_mc_hrtimer_expired(struct hrtimer *hrtimer)
+{
+	qdf_mc_timer_platform_t *platform_info =
+		container_of(hrtimer, qdf_mc_timer_platform_t, timer);
+
+	if (platform_info->function)
+		platform_info->function(platform_info->data);
+
+	return HRTIMER_NORESTART;
+}
+
+/**
+ * qdf_mc_timer_platform_init() - initialize the OS timer of a QDF timer
+ * @timer: Pointer to timer object
+ * @timer_type: Type of timer
+ *
+ * An hrtimer cannot be deferrable, QDF_TIMER_TYPE_SW timers get slack
+ * from qdf_mc_timer_start() instead.
+ *
+ * Return: none
+ */
+static void qdf_mc_timer_platform_init(qdf_mc_timer_t *timer,
+				       QDF_TIMER_TYPE timer_type)
+{
+	hrtimer_init(&timer->platform_info.timer, CLOCK_MONOTONIC,
+		     QDF_MC_HRTIMER_MODE);
+	timer->platform_info.timer.function = qdf_mc_hrtimer_expired;
+	timer->platform_info.function = QDF_MC_TIMER_EXPIRY_HANDLER;
+	timer->platform_info.data = (unsigned long)timer;
+}
+
+/**
+ * qdf_mc_timer_platform_arm() - arm the OS timer of a QDF timer
+ * @timer: Pointer to timer object
+ * @expiration_us: Time to expire, in microseconds
+ * @slack_us: How much later the timer may expire, in microseconds
+ *
+ * Return: none
+ */
+static void qdf_mc_timer_platform_arm(qdf_mc_timer_t *timer,
+				      uint64_t expiration_us,
+				      uint64_t slack_us)
+{
+	hrtimer_start_range_ns(&timer->platform_info.timer,
+			       ns_to_ktime(expiration_us * NSEC_PER_USEC),
+			       slack_us * NSEC_PER_USEC, QDF_MC_HRTIMER_MODE);
+}
+
+/**
+ * qdf_mc_timer_platform_cancel() - cancel the OS timer of a QDF timer
+ * @timer: Pointer to timer object
+ *
+ * Does not wait for a running expiry handler, like del_timer().
+ *
+ * Return: none
+ */
+static void qdf_mc_timer_platform_cancel(qdf_mc_timer_t *timer)
+{
+	hrtimer_try_to_cancel(&timer->platform_info.timer);
+}
+#else
+static void qdf_mc_timer_platform_init(qdf_mc_timer_t *timer,
+				       QDF_TIMER_TYPE timer_type)
+{
+	if (QDF_TIMER_TYPE_SW == timer_type)
+		init_timer_deferrable(&(timer->platform_info.timer));
+	else
+		init_timer(&(timer->platform_info.timer));
+	timer->platform_info.timer.function = QDF_MC_TIMER_EXPIRY_HANDLER;
+	timer->platform_info.timer.data = (unsigned long)timer;
+}
+
+static void qdf_mc_timer_platform_arm(qdf_mc_timer_t *timer,
+				      uint64_t expiration_us,
+				      uint64_t slack_us)
+{
+	unsigned int expiration_ms = DIV_ROUND_UP_ULL(expiration_us,
+						      QDF_MC_TIMER_TO_MS_UNIT);
+
+	mod_timer(&(timer->platform_info.timer),
+		  jiffies + msecs_to_jiffies(expiration_ms));
+}
+
+static void qdf_mc_timer_platform_cancel(qdf_mc_timer_t *timer)
+{
+	del_timer(&(timer->platform_info.timer));
+}
+#endif /* FEATURE_QDF_MC_HRTIMER */
+
 /**
  * qdf_mc_timer_init() - initialize a QDF timer
  * @timer: Pointer to timer object
@@ -275,16 +379,7 @@ QDF_STATUS qdf_mc_timer_init_debug(qdf_mc_timer_t *timer,
 	 * with arguments passed or with default values
 	 */
 	qdf_spinlock_create(&timer->platform_info.spinlock);
-	if (QDF_TIMER_TYPE_SW == timer_type)
-		init_timer_deferrable(&(timer->platform_info.timer));
-	else
-		init_timer(&(timer->platform_info.timer));
-#ifdef CONFIG_MCL
-	timer->platform_info.timer.function = cds_linux_timer_callback;
-#else
-	timer->platform_info.timer.function = NULL;
-#endif
-	timer->platform_info.timer.data = (unsigned long)timer;
+	qdf_mc_timer_platform_init(timer, timer_type);
 	timer->callback = callback;
 	timer->user_data = user_data;
 	timer->type = timer_type;
@@ -311,16 +406,7 @@ QDF_STATUS qdf_mc_timer_init(qdf_mc_timer_t *timer, QDF_TIMER_TYPE timer_type,
 	 * with arguments passed or with default values
 	 */
 	qdf_spinlock_create(&timer->platform_info.spinlock);
-	if (QDF_TIMER_TYPE_SW == timer_type)
-		init_timer_deferrable(&(timer->platform_info.timer));
-	else
-		init_timer(&(timer->platform_info.timer));
-#ifdef CONFIG_MCL
-	timer->platform_info.timer.function = cds_linux_timer_callback;
-#else
-	timer->platform_info.timer.function = NULL;
-#endif
-	timer->platform_info.timer.data = (unsigned long)timer;
+	qdf_mc_timer_platform_init(timer, timer_type);
 	timer->callback = callback;
 	timer->user_data = user_data;
 	timer->type = timer_type;
@@ -394,7 +480,7 @@ QDF_STATUS qdf_mc_timer_destroy(qdf_mc_timer_t *timer)
 
 	case QDF_TIMER_STATE_RUNNING:
 		/* Stop the timer first */
-		del_timer(&(timer->platform_info.timer));
+		qdf_mc_timer_platform_cancel(timer);
 		v_status = QDF_STATUS_SUCCESS;
 		break;
 	case QDF_TIMER_STATE_STOPPED:
@@ -480,7 +566,7 @@ QDF_STATUS qdf_mc_timer_destroy(qdf_mc_timer_t *timer)
 
 	case QDF_TIMER_STATE_RUNNING:
 		/* Stop the timer first */
-		del_timer(&(timer->platform_info.timer));
+		qdf_mc_timer_platform_cancel(timer);
 		v_status = QDF_STATUS_SUCCESS;
 		break;
 
@@ -516,6 +602,57 @@ QDF_STATUS qdf_mc_timer_destroy(qdf_mc_timer_t *timer)
 EXPORT_SYMBOL(qdf_mc_timer_destroy);
 #endif
 
+/**
+ * __qdf_mc_timer_start() - arm a QDF timer object
+ * @timer: Pointer to timer object
+ * @expiration_us: Time to expire, in microseconds
+ * @slack_us: How much later the timer may expire, in microseconds
+ *
+ * Common part of qdf_mc_timer_start() and qdf_mc_timer_start_us().
+ *
+ * Return:
+ * QDF_STATUS_SUCCESS: timer is initialized successfully
+ * QDF failure status: timer initialization failed
+ */
+static QDF_STATUS __qdf_mc_timer_start(qdf_mc_timer_t *timer,
+				       uint64_t expiration_us,
+				       uint64_t slack_us)
+{
+	/* make sure the remainer of the logic isn't interrupted */
+	qdf_spin_lock_irqsave(&timer->platform_info.spinlock);
+
+	/* ensure if the timer can be started */
+	if (QDF_TIMER_STATE_STOPPED != timer->state) {
+		qdf_spin_unlock_irqrestore(&timer->platform_info.spinlock);
+		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_ERROR,
+			  "%s: Cannot start timer in state = %d ", __func__,
+			  timer->state);
+		return QDF_STATUS_E_ALREADY;
+	}
+
+	/* start the timer */
+	qdf_mc_timer_platform_arm(timer, expiration_us, slack_us);
+
+	timer->state = QDF_TIMER_STATE_RUNNING;
+
+	/* get the thread ID on which the timer is being started */
+	timer->platform_info.thread_id = current->pid;
+
+	if (QDF_TIMER_TYPE_WAKE_APPS == timer->type) {
+		persistent_timer_count++;
+		if (1 == persistent_timer_count) {
+			/* since we now have one persistent timer,
+			 * we need to disallow sleep
+			 * sleep_negate_okts(sleep_client_handle);
+			 */
+		}
+	}
+
+	qdf_spin_unlock_irqrestore(&timer->platform_info.spinlock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
 /**
  * qdf_mc_timer_start() - start a QDF timer object
  * @timer: Pointer to timer object
@@ -529,12 +666,18 @@ EXPORT_SYMBOL(qdf_mc_timer_destroy);
  * timer, qdf_mc_timer_start() has to be called after the timer runs
  * or has been cancelled.
  *
+ * With FEATURE_QDF_MC_HRTIMER any non-zero expiration is accepted and
+ * QDF_TIMER_TYPE_SW timers get QDF_MC_TIMER_SW_SLACK_SHIFT worth of slack.
+ *
  * Return:
  * QDF_STATUS_SUCCESS: timer is initialized successfully
  * QDF failure status: timer initialization failed
  */
 QDF_STATUS qdf_mc_timer_start(qdf_mc_timer_t *timer, uint32_t expiration_time)
 {
+	uint64_t expiration_us;
+	uint64_t slack_us = 0;
+
 	/* check for invalid pointer */
 	if (NULL == timer) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_ERROR,
@@ -552,6 +695,15 @@ QDF_STATUS qdf_mc_timer_start(qdf_mc_timer_t *timer, uint32_t expiration_time)
 		return QDF_STATUS_E_INVAL;
 	}
 
+#ifdef FEATURE_QDF_MC_HRTIMER
+	if (0 == expiration_time) {
+		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_ERROR,
+			  "%s: Cannot start a timer with zero expiration",
+			  __func__);
+		QDF_ASSERT(0);
+		return QDF_STATUS_E_INVAL;
+	}
+#else
 	/* check if timer has expiration time less than 10 ms */
 	if (expiration_time < 10) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_ERROR,
@@ -560,43 +712,57 @@ QDF_STATUS qdf_mc_timer_start(qdf_mc_timer_t *timer, uint32_t expiration_time)
 		QDF_ASSERT(0);
 		return QDF_STATUS_E_INVAL;
 	}
+#endif
 
-	/* make sure the remainer of the logic isn't interrupted */
-	qdf_spin_lock_irqsave(&timer->platform_info.spinlock);
+	expiration_us = (uint64_t)expiration_time * QDF_MC_TIMER_TO_MS_UNIT;
+	if (QDF_TIMER_TYPE_SW == timer->type)
+		slack_us = expiration_us >> QDF_MC_TIMER_SW_SLACK_SHIFT;
 
-	/* ensure if the timer can be started */
-	if (QDF_TIMER_STATE_STOPPED != timer->state) {
-		qdf_spin_unlock_irqrestore(&timer->platform_info.spinlock);
+	return __qdf_mc_timer_start(timer, expiration_us, slack_us);
+}
+EXPORT_SYMBOL(qdf_mc_timer_start);
+
+/**
+ * qdf_mc_timer_start_us() - start a QDF timer object with usec resolution
+ * @timer: Pointer to timer object
+ * @expiration_us: Time to expire, in microseconds
+ * @slack_us: How much later than @expiration_us the timer may expire
+ *
+ * Return:
+ * QDF_STATUS_SUCCESS: timer is initialized successfully
+ * QDF failure status: timer initialization failed
+ */
+QDF_STATUS qdf_mc_timer_start_us(qdf_mc_timer_t *timer, uint32_t expiration_us,
+				 uint32_t slack_us)
+{
+	/* check for invalid pointer */
+	if (NULL == timer) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_ERROR,
-			  "%s: Cannot start timer in state = %d ", __func__,
-			  timer->state);
-		return QDF_STATUS_E_ALREADY;
+			  "%s Null timer pointer being passed", __func__);
+		QDF_ASSERT(0);
+		return QDF_STATUS_E_INVAL;
 	}
 
-	/* start the timer */
-	mod_timer(&(timer->platform_info.timer),
-		  jiffies + msecs_to_jiffies(expiration_time));
-
-	timer->state = QDF_TIMER_STATE_RUNNING;
-
-	/* get the thread ID on which the timer is being started */
-	timer->platform_info.thread_id = current->pid;
+	/* check if timer refers to an uninitialized object */
+	if (LINUX_TIMER_COOKIE != timer->platform_info.cookie) {
+		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_ERROR,
+			  "%s: Cannot start uninitialized timer", __func__);
+		QDF_ASSERT(0);
 
-	if (QDF_TIMER_TYPE_WAKE_APPS == timer->type) {
-		persistent_timer_count++;
-		if (1 == persistent_timer_count) {
-			/* since we now have one persistent timer,
-			 * we need to disallow sleep
-			 * sleep_negate_okts(sleep_client_handle);
-			 */
-		}
+		return QDF_STATUS_E_INVAL;
 	}
 
-	qdf_spin_unlock_irqrestore(&timer->platform_info.spinlock);
+	if (0 == expiration_us) {
+		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_ERROR,
+			  "%s: Cannot start a timer with zero expiration",
+			  __func__);
+		QDF_ASSERT(0);
+		return QDF_STATUS_E_INVAL;
+	}
 
-	return QDF_STATUS_SUCCESS;
+	return __qdf_mc_timer_start(timer, expiration_us, slack_us);
 }
-EXPORT_SYMBOL(qdf_mc_timer_start);
+EXPORT_SYMBOL(qdf_mc_timer_start_us);
 
 /**
  * qdf_mc_timer_stop() - stop a QDF timer
@@ -643,7 +809,7 @@ QDF_STATUS qdf_mc_timer_stop(qdf_mc_timer_t *timer)
 
 	timer->state = QDF_TIMER_STATE_STOPPED;
 
-	del_timer(&(timer->platform_info.timer));
+	qdf_mc_timer_platform_cancel(timer);
 
 	qdf_spin_unlock_irqrestore(&timer->platform_info.spinlock);
 
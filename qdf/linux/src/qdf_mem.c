@@ -83,6 +83,145 @@ u_int8_t prealloc_disabled = 1;
 qdf_declare_param(prealloc_disabled, byte);
 EXPORT_SYMBOL(prealloc_disabled);
 
+/**
+ * qdf_mempool_lock() - take the shared free list lock of a pool
+ * @pool: memory pool
+ *
+ * Counts acquisitions that found the lock already taken. Caller must have
+ * bottom halves disabled.
+ *
+ * Return: none
+ */
+static inline void qdf_mempool_lock(__qdf_mempool_t pool)
+{
+	if (!spin_trylock(&pool->lock)) {
+		spin_lock(&pool->lock);
+		pool->lock_contention++;
+	}
+}
+
+/**
+ * qdf_mempool_get_shared() - take elements off the shared free list
+ * @pool: memory pool
+ * @bufs: filled with the elements taken
+ * @num: number of elements wanted
+ *
+ * Caller must hold the pool lock.
+ *
+ * Return: number of elements taken
+ */
+static int qdf_mempool_get_shared(__qdf_mempool_t pool, void **bufs, int num)
+{
+	mempool_elem_t *elem;
+	int i;
+
+	for (i = 0; i < num; i++) {
+		elem = STAILQ_FIRST(&pool->free_list);
+		if (!elem)
+			break;
+		STAILQ_REMOVE_HEAD(&pool->free_list, mempool_entry);
+		bufs[i] = elem;
+	}
+	pool->free_cnt -= i;
+
+	return i;
+}
+
+/**
+ * qdf_mempool_put_shared() - return elements to the shared free list
+ * @pool: memory pool
+ * @bufs: elements to return
+ * @num: number of elements in @bufs
+ *
+ * Caller must hold the pool lock.
+ *
+ * Return: none
+ */
+static void qdf_mempool_put_shared(__qdf_mempool_t pool, void **bufs, int num)
+{
+	int i;
+
+	for (i = 0; i < num; i++)
+		STAILQ_INSERT_TAIL(&pool->free_list,
+				   (mempool_elem_t *)bufs[i], mempool_entry);
+	pool->free_cnt += num;
+}
+
+/**
+ * qdf_mempool_mag_alloc() - allocate elements through the local magazine
+ * @pool: memory pool with per cpu magazines
+ * @bufs: filled with the allocated elements
+ * @num: number of elements wanted
+ *
+ * An empty magazine is refilled with a batch from the shared free list,
+ * so the pool lock is taken about once per __QDF_MEMPOOL_MAG_BATCH
+ * elements.
+ *
+ * Return: number of elements allocated
+ */
+static int qdf_mempool_mag_alloc(__qdf_mempool_t pool, void **bufs, int num)
+{
+	struct __qdf_mempool_mag *mag;
+	int i = 0;
+
+	local_bh_disable();
+	mag = this_cpu_ptr(pool->mag);
+	while (i < num) {
+		if (!mag->cnt) {
+			qdf_mempool_lock(pool);
+			mag->cnt = qdf_mempool_get_shared(pool, mag->elems,
+						__QDF_MEMPOOL_MAG_BATCH);
+			spin_unlock(&pool->lock);
+			if (!mag->cnt)
+				break;
+			mag->refills++;
+		} else {
+			mag->hits++;
+		}
+		bufs[i++] = mag->elems[--mag->cnt];
+	}
+	local_bh_enable();
+
+	return i;
+}
+
+/**
+ * qdf_mempool_mag_free() - free elements through the local magazine
+ * @pool: memory pool with per cpu magazines
+ * @bufs: elements to free
+ * @num: number of elements in @bufs
+ *
+ * A full magazine gives its __QDF_MEMPOOL_MAG_BATCH least recently freed
+ * elements back to the shared free list and keeps the cache hot ones.
+ *
+ * Return: none
+ */
+static void qdf_mempool_mag_free(__qdf_mempool_t pool, void **bufs, int num)
+{
+	struct __qdf_mempool_mag *mag;
+	int i;
+
+	local_bh_disable();
+	mag = this_cpu_ptr(pool->mag);
+	for (i = 0; i < num; i++) {
+		if (mag->cnt == __QDF_MEMPOOL_MAG_SIZE) {
+			qdf_mempool_lock(pool);
+			qdf_mempool_put_shared(pool, mag->elems,
+					       __QDF_MEMPOOL_MAG_BATCH);
+			spin_unlock(&pool->lock);
+			mag->cnt -= __QDF_MEMPOOL_MAG_BATCH;
+			memmove(mag->elems,
+				&mag->elems[__QDF_MEMPOOL_MAG_BATCH],
+				mag->cnt * sizeof(mag->elems[0]));
+			mag->drains++;
+		} else {
+			mag->hits++;
+		}
+		mag->elems[mag->cnt++] = bufs[i];
+	}
+	local_bh_enable();
+}
+
 /**
  * __qdf_mempool_init() - Create and initialize memory pool
  *
@@ -92,6 +231,11 @@ EXPORT_SYMBOL(prealloc_disabled);
  * @elem_size: size of each pool element in bytes
  * @flags: flags
  *
+ * With __QDF_MEMPOOL_F_PERCPU, free elements are also cached in per cpu
+ * magazines in front of the shared free list. This is only done for pools
+ * large enough that the magazines cannot strand a significant share of
+ * the elements on idle cpus.
+ *
  * return: Handle to memory pool or NULL if allocation failed
  */
 int __qdf_mempool_init(qdf_device_t osdev, __qdf_mempool_t *pool_addr,
@@ -167,6 +311,16 @@ int __qdf_mempool_init(qdf_device_t osdev, __qdf_mempool_t *pool_addr,
 
 
 	new_pool->free_cnt = elem_cnt;
+
+	if ((flags & __QDF_MEMPOOL_F_PERCPU) &&
+	    elem_cnt >= 4 * num_possible_cpus() * __QDF_MEMPOOL_MAG_SIZE) {
+		new_pool->mag = alloc_percpu(struct __qdf_mempool_mag);
+		if (!new_pool->mag)
+			QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_WARN,
+				  "%s: pool %d: no per cpu magazines",
+				  __func__, pool_id);
+	}
+
 	*pool_addr = new_pool;
 	return 0;
 }
@@ -194,6 +348,8 @@ void __qdf_mempool_destroy(qdf_device_t osdev, __qdf_mempool_t pool)
 	pool_id = pool->pool_id;
 
 	/* TBD: Check if free count matches elem_cnt if debug is enabled */
+	if (pool->mag)
+		free_percpu(pool->mag);
 	kfree(pool->pool_mem);
 	kfree(pool);
 	osdev->mem_pool[pool_id] = NULL;
@@ -218,7 +374,13 @@ void *__qdf_mempool_alloc(qdf_device_t osdev, __qdf_mempool_t pool)
 	if (prealloc_disabled)
 		return  qdf_mem_malloc(pool->elem_size);
 
-	spin_lock_bh(&pool->lock);
+	if (pool->mag) {
+		qdf_mempool_mag_alloc(pool, &buf, 1);
+		return buf;
+	}
+
+	local_bh_disable();
+	qdf_mempool_lock(pool);
 
 	buf = STAILQ_FIRST(&pool->free_list);
 	if (buf != NULL) {
@@ -250,7 +412,11 @@ void __qdf_mempool_free(qdf_device_t osdev, __qdf_mempool_t pool, void *buf)
 	if (prealloc_disabled)
 		return qdf_mem_free(buf);
 
-	spin_lock_bh(&pool->lock);
+	if (pool->mag)
+		return qdf_mempool_mag_free(pool, &buf, 1);
+
+	local_bh_disable();
+	qdf_mempool_lock(pool);
 	pool->free_cnt++;
 
 	STAILQ_INSERT_TAIL
@@ -259,6 +425,112 @@ void __qdf_mempool_free(qdf_device_t osdev, __qdf_mempool_t pool, void *buf)
 }
 EXPORT_SYMBOL(__qdf_mempool_free);
 
+/**
+ * __qdf_mempool_alloc_batch() - Allocate several elements from a memory pool
+ * @osdev: platform device object
+ * @pool: Handle to memory pool
+ * @bufs: filled with the allocated elements
+ * @num: number of elements wanted
+ *
+ * Return: number of elements allocated, less than @num if the pool ran dry
+ */
+int __qdf_mempool_alloc_batch(qdf_device_t osdev, __qdf_mempool_t pool,
+			      void **bufs, int num)
+{
+	int i;
+
+	if (!pool || num <= 0)
+		return 0;
+
+	if (prealloc_disabled) {
+		for (i = 0; i < num; i++) {
+			bufs[i] = qdf_mem_malloc(pool->elem_size);
+			if (!bufs[i])
+				break;
+		}
+		return i;
+	}
+
+	if (pool->mag)
+		return qdf_mempool_mag_alloc(pool, bufs, num);
+
+	local_bh_disable();
+	qdf_mempool_lock(pool);
+	i = qdf_mempool_get_shared(pool, bufs, num);
+	spin_unlock_bh(&pool->lock);
+
+	return i;
+}
+EXPORT_SYMBOL(__qdf_mempool_alloc_batch);
+
+/**
+ * __qdf_mempool_free_batch() - Free several memory pool elements
+ * @osdev: Platform device object
+ * @pool: Handle to memory pool
+ * @bufs: Elements to be freed
+ * @num: number of elements in @bufs
+ *
+ * Returns: none
+ */
+void __qdf_mempool_free_batch(qdf_device_t osdev, __qdf_mempool_t pool,
+			      void **bufs, int num)
+{
+	int i;
+
+	if (!pool || num <= 0)
+		return;
+
+	if (prealloc_disabled) {
+		for (i = 0; i < num; i++)
+			qdf_mem_free(bufs[i]);
+		return;
+	}
+
+	if (pool->mag)
+		return qdf_mempool_mag_free(pool, bufs, num);
+
+	local_bh_disable();
+	qdf_mempool_lock(pool);
+	qdf_mempool_put_shared(pool, bufs, num);
+	spin_unlock_bh(&pool->lock);
+}
+EXPORT_SYMBOL(__qdf_mempool_free_batch);
+
+/**
+ * __qdf_mempool_get_stats() - Get the statistics of a memory pool
+ * @pool: Handle to memory pool
+ * @stats: filled with the pool statistics
+ *
+ * Magazine counters are summed over all possible cpus without stopping
+ * them, so the result is only a snapshot.
+ *
+ * Returns: none
+ */
+void __qdf_mempool_get_stats(__qdf_mempool_t pool,
+			     struct __qdf_mempool_stats *stats)
+{
+	struct __qdf_mempool_mag *mag;
+	int cpu;
+
+	memset(stats, 0, sizeof(*stats));
+	if (!pool)
+		return;
+
+	stats->free_cnt = pool->free_cnt;
+	stats->lock_contention = pool->lock_contention;
+	if (!pool->mag)
+		return;
+
+	for_each_possible_cpu(cpu) {
+		mag = per_cpu_ptr(pool->mag, cpu);
+		stats->cached_cnt += mag->cnt;
+		stats->hits += mag->hits;
+		stats->refills += mag->refills;
+		stats->drains += mag->drains;
+	}
+}
+EXPORT_SYMBOL(__qdf_mempool_get_stats);
+
 /**
  * qdf_mem_alloc_outline() - allocation QDF memory
  * @osdev: platform device object
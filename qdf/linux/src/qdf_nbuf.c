@@ -1607,6 +1607,82 @@ void __qdf_dmaaddr_to_32s(qdf_dma_addr_t dmaaddr,
 	}
 }
 
+/**
+ * __qdf_nbuf_unmap_tso_info() - release the DMA mappings of a jumbo
+ * TSO network buffer
+ * @osdev: qdf device handle
+ * @skb: network buffer the mappings were made for
+ * @tso_info: TSO information holding the mappings
+ *
+ * Return: none
+ */
+void __qdf_nbuf_unmap_tso_info(qdf_device_t osdev, struct sk_buff *skb,
+		struct qdf_tso_info_t *tso_info)
+{
+	uint32_t i;
+
+	if (!tso_info->num_maps)
+		return;
+
+	dma_unmap_single(osdev->dev, tso_info->maps[0], skb_headlen(skb),
+			 DMA_TO_DEVICE);
+	for (i = 1; i < tso_info->num_maps; i++)
+		dma_unmap_page(osdev->dev, tso_info->maps[i],
+			       skb_frag_size(&skb_shinfo(skb)->frags[i - 1]),
+			       DMA_TO_DEVICE);
+	tso_info->num_maps = 0;
+}
+EXPORT_SYMBOL(__qdf_nbuf_unmap_tso_info);
+
+/**
+ * __qdf_nbuf_map_tso() - DMA map a jumbo TSO network buffer
+ * @osdev: qdf device handle
+ * @skb: network buffer to be mapped
+ * @tso_info: TSO information to record the mappings in
+ *
+ * The linear area and each page fragment are mapped once, the segments
+ * then address into these mappings by offset.
+ *
+ * Return: 0 - success 1 - failure
+ */
+static uint8_t __qdf_nbuf_map_tso(qdf_device_t osdev, struct sk_buff *skb,
+		struct qdf_tso_info_t *tso_info)
+{
+	uint32_t nr_frags = skb_shinfo(skb)->nr_frags;
+	qdf_dma_addr_t paddr;
+	uint32_t i;
+
+	tso_info->num_maps = 0;
+	if (qdf_unlikely(nr_frags + 1 > QDF_TSO_MAPS_MAX)) {
+		qdf_print("TSO: %u frags exceed the mapping table\n",
+			  nr_frags);
+		return 1;
+	}
+
+	paddr = dma_map_single(osdev->dev, skb->data, skb_headlen(skb),
+			       DMA_TO_DEVICE);
+	if (qdf_unlikely(dma_mapping_error(osdev->dev, paddr)))
+		goto map_err;
+	tso_info->maps[tso_info->num_maps++] = paddr;
+
+	for (i = 0; i < nr_frags; i++) {
+		const struct skb_frag_struct *frag = &skb_shinfo(skb)->frags[i];
+
+		paddr = skb_frag_dma_map(osdev->dev, frag, 0,
+					 skb_frag_size(frag), DMA_TO_DEVICE);
+		if (qdf_unlikely(dma_mapping_error(osdev->dev, paddr)))
+			goto map_err;
+		tso_info->maps[tso_info->num_maps++] = paddr;
+	}
+
+	return 0;
+
+map_err:
+	qdf_print("TSO: DMA mapping failed\n");
+	__qdf_nbuf_unmap_tso_info(osdev, skb, tso_info);
+	return 1;
+}
+
 /**
  * __qdf_nbuf_get_tso_info() - function to divide a TSO nbuf
  * into segments
@@ -1618,6 +1694,9 @@ void __qdf_dmaaddr_to_32s(qdf_dma_addr_t dmaaddr,
  * segments to be transmitted by the driver. It chains the TSO
  * segments created into a list.
  *
+ * The network buffer is DMA mapped once per contiguous area, the
+ * mappings are kept in @tso_info until qdf_nbuf_unmap_tso_info().
+ *
  * Return: number of TSO segments
  */
 uint32_t __qdf_nbuf_get_tso_info(qdf_device_t osdev, struct sk_buff *skb,
@@ -1627,15 +1706,14 @@ uint32_t __qdf_nbuf_get_tso_info(qdf_device_t osdev, struct sk_buff *skb,
 	struct qdf_tso_cmn_seg_info_t tso_cmn_info;
 
 	/* segment specific */
-	char *tso_frag_vaddr;
-	qdf_dma_addr_t tso_frag_paddr = 0;
 	uint32_t num_seg = 0;
 	struct qdf_tso_seg_elem_t *curr_seg;
-	const struct skb_frag_struct *frag = NULL;
-	uint32_t tso_frag_len = 0; /* tso segment's fragment length*/
-	uint32_t skb_frag_len = 0; /* skb's fragment length (continous memory)*/
-	uint32_t foffset = 0; /* offset into the skb's fragment */
-	uint32_t skb_proc = 0; /* bytes of the skb that have been processed*/
+	struct qdf_tso_seg_elem_t *last_seg = NULL;
+	uint32_t map_idx = 0; /* mapping the payload is taken from */
+	uint32_t map_off; /* offset into the current mapping */
+	uint32_t map_len; /* length of the current mapping */
+	unsigned char *map_vaddr; /* virtual address of the current mapping */
+	uint32_t skb_proc; /* payload bytes of the skb left to segment */
 	uint32_t tso_seg_size = skb_shinfo(skb)->gso_size;
 
 	memset(&tso_cmn_info, 0x0, sizeof(tso_cmn_info));
@@ -1644,32 +1722,25 @@ uint32_t __qdf_nbuf_get_tso_info(qdf_device_t osdev, struct sk_buff *skb,
 		qdf_print("TSO: error getting common segment info\n");
 		return 0;
 	}
-	curr_seg = tso_info->tso_seg_list;
 
-	/* length of the first chunk of data in the skb */
-	skb_proc = skb_frag_len = skb_headlen(skb);
+	if (qdf_unlikely(__qdf_nbuf_map_tso(osdev, skb, tso_info)))
+		return 0;
 
-	/* the 0th tso segment's 0th fragment always contains the EIT header */
-	/* update the remaining skb fragment length and TSO segment length */
-	skb_frag_len -= tso_cmn_info.eit_hdr_len;
-	skb_proc -= tso_cmn_info.eit_hdr_len;
+	curr_seg = tso_info->tso_seg_list;
 
-	/* get the address to the next tso fragment */
-	tso_frag_vaddr = skb->data + tso_cmn_info.eit_hdr_len;
-	/* get the length of the next tso fragment */
-	tso_frag_len = min(skb_frag_len, tso_seg_size);
-	tso_frag_paddr = dma_map_single(osdev->dev,
-		 tso_frag_vaddr, tso_frag_len, DMA_TO_DEVICE);
+	/* the payload starts in the linear area right after the EIT header */
+	map_vaddr = skb->data;
+	map_len = skb_headlen(skb);
+	map_off = tso_cmn_info.eit_hdr_len;
+	skb_proc = skb->len - tso_cmn_info.eit_hdr_len;
 
 	num_seg = tso_info->num_segs;
 	tso_info->num_segs = 0;
 	tso_info->is_tso = 1;
 
-	while (num_seg && curr_seg) {
+	while (num_seg && curr_seg && skb_proc) {
+		uint32_t seg_left = tso_seg_size;
 		int i = 1; /* tso fragment index */
-		int j = 0; /* skb fragment index */
-		uint8_t more_tso_frags = 1;
-		uint8_t from_frag_table = 0;
 
 		/* Initialize the flags to 0 */
 		memset(&curr_seg->seg, 0x0, sizeof(curr_seg->seg));
@@ -1707,88 +1778,67 @@ uint32_t __qdf_nbuf_get_tso_info(qdf_device_t osdev, struct sk_buff *skb,
 		IP and TCP header */
 		curr_seg->seg.tso_frags[0].vaddr = tso_cmn_info.eit_hdr;
 		curr_seg->seg.tso_frags[0].length = tso_cmn_info.eit_hdr_len;
+		curr_seg->seg.tso_frags[0].paddr = tso_info->maps[0];
 		tso_info->total_len = curr_seg->seg.tso_frags[0].length;
-		{
-			qdf_dma_addr_t mapped;
-
-			mapped = dma_map_single(osdev->dev,
-				tso_cmn_info.eit_hdr,
-				tso_cmn_info.eit_hdr_len, DMA_TO_DEVICE);
-			curr_seg->seg.tso_frags[0].paddr = mapped;
-		}
 		curr_seg->seg.tso_flags.ip_len = tso_cmn_info.ip_tcp_hdr_len;
 		curr_seg->seg.num_frags++;
 
-		while (more_tso_frags) {
-			curr_seg->seg.tso_frags[i].vaddr = tso_frag_vaddr;
+		while (seg_left && skb_proc) {
+			uint32_t tso_frag_len;
+
+			/* move on to the next page fragment */
+			if (map_off == map_len) {
+				const struct skb_frag_struct *frag;
+
+				if (qdf_unlikely(map_idx + 1 >=
+						 tso_info->num_maps))
+					goto seg_err;
+				frag = &skb_shinfo(skb)->frags[map_idx];
+				map_idx++;
+				map_vaddr = skb_frag_address(frag);
+				map_len = skb_frag_size(frag);
+				map_off = 0;
+				continue;
+			}
+
+			if (qdf_unlikely(i == FRAG_NUM_MAX))
+				goto seg_err;
+
+			tso_frag_len = min(map_len - map_off, seg_left);
+			tso_frag_len = min(tso_frag_len, skb_proc);
+
+			curr_seg->seg.tso_frags[i].vaddr = map_vaddr + map_off;
+			curr_seg->seg.tso_frags[i].paddr =
+				tso_info->maps[map_idx] + map_off;
 			curr_seg->seg.tso_frags[i].length = tso_frag_len;
-			tso_info->total_len +=
-				 curr_seg->seg.tso_frags[i].length;
-			curr_seg->seg.tso_flags.ip_len +=
-				 curr_seg->seg.tso_frags[i].length;
+			tso_info->total_len += tso_frag_len;
+			curr_seg->seg.tso_flags.ip_len += tso_frag_len;
 			curr_seg->seg.num_frags++;
-			skb_proc = skb_proc - curr_seg->seg.tso_frags[i].length;
 
 			/* increment the TCP sequence number */
 			tso_cmn_info.tcp_seq_num += tso_frag_len;
-			curr_seg->seg.tso_frags[i].paddr = tso_frag_paddr;
-
-			/* if there is no more data left in the skb */
-			if (!skb_proc)
-				return tso_info->num_segs;
-
-			/* get the next payload fragment information */
-			/* check if there are more fragments in this segment */
-			if ((tso_seg_size - tso_frag_len)) {
-				more_tso_frags = 1;
-				i++;
-			} else {
-				more_tso_frags = 0;
-				/* reset i and the tso payload size */
-				i = 1;
-				tso_seg_size = skb_shinfo(skb)->gso_size;
-			}
-
-			/* if the next fragment is contiguous */
-			if (tso_frag_len < skb_frag_len) {
-				skb_frag_len = skb_frag_len - tso_frag_len;
-				tso_frag_len = min(skb_frag_len, tso_seg_size);
-				tso_frag_vaddr = tso_frag_vaddr + tso_frag_len;
-				if (from_frag_table) {
-					tso_frag_paddr =
-						 skb_frag_dma_map(osdev->dev,
-							 frag, foffset,
-							 tso_frag_len,
-							 DMA_TO_DEVICE);
-				} else {
-					tso_frag_paddr =
-						 dma_map_single(osdev->dev,
-							 tso_frag_vaddr,
-							 tso_frag_len,
-							 DMA_TO_DEVICE);
-				}
-			} else { /* the next fragment is not contiguous */
-				tso_frag_len = min(skb_frag_len, tso_seg_size);
-				frag = &skb_shinfo(skb)->frags[j];
-				skb_frag_len = skb_frag_size(frag);
-
-				tso_frag_vaddr = skb_frag_address(frag);
-				tso_frag_paddr = skb_frag_dma_map(osdev->dev,
-					 frag, 0, tso_frag_len,
-					 DMA_TO_DEVICE);
-				foffset += tso_frag_len;
-				from_frag_table = 1;
-				j++;
-			}
+			map_off += tso_frag_len;
+			seg_left -= tso_frag_len;
+			skb_proc -= tso_frag_len;
+			i++;
 		}
-		num_seg--;
-		/* if TCP FIN flag was set, set it in the last segment */
-		if (!num_seg)
-			curr_seg->seg.tso_flags.fin = tso_cmn_info.tcphdr->fin;
 
+		num_seg--;
+		last_seg = curr_seg;
 		curr_seg = curr_seg->next;
 	}
+
+	/* if TCP FIN flag was set, set it in the last segment */
+	if (last_seg)
+		last_seg->seg.tso_flags.fin = tso_cmn_info.tcphdr->fin;
+
 	return tso_info->num_segs;
+
+seg_err:
+	qdf_print("TSO: payload does not fit the segment fragments\n");
+	__qdf_nbuf_unmap_tso_info(osdev, skb, tso_info);
+	tso_info->num_segs = 0;
+	return 0;
 }
 EXPORT_SYMBOL(__qdf_nbuf_get_tso_info);
 
@@ -36,6 +36,10 @@
 #include <ani_global.h>
 #include <wlan_logging_sock_svc.h>
 #include "qdf_time.h"
+#if defined(FEATURE_QDF_TRACE_PER_CPU) || defined(FEATURE_DP_TRACE_PER_CPU)
+#include <qdf_util.h>
+#include <asm/local.h>
+#endif
 /* Preprocessor definitions and constants */
 
 #define QDF_TRACE_BUFFER_SIZE (512)
@@ -103,6 +107,155 @@ static t_qdf_trace_data g_qdf_trace_data;
 static tp_qdf_trace_cb qdf_trace_cb_table[QDF_MODULE_ID_MAX];
 static tp_qdf_trace_cb qdf_trace_restore_cb_table[QDF_MODULE_ID_MAX];
 
+#ifdef FEATURE_QDF_TRACE_PER_CPU
+/**
+ * struct qdf_trace_cpu_ring - MTRACE ring owned by a single cpu
+ * @widx: number of records ever written to this ring
+ * @rec: the records, slot is widx modulo MAX_QDF_TRACE_CPU_RECORDS
+ *
+ * Only the owning cpu writes to the ring, so a record needs no lock; the
+ * local_t index keeps a record written from an interrupt from landing on
+ * the slot of the one it interrupted.
+ */
+struct qdf_trace_cpu_ring {
+	local_t widx;
+	qdf_trace_record_t rec[MAX_QDF_TRACE_CPU_RECORDS];
+} ____cacheline_aligned;
+
+static struct qdf_trace_cpu_ring g_qdf_trace_cpu_ring[QDF_MAX_AVAILABLE_CPU];
+#endif /* FEATURE_QDF_TRACE_PER_CPU */
+
+#if defined(FEATURE_QDF_TRACE_PER_CPU) || defined(FEATURE_DP_TRACE_PER_CPU)
+/**
+ * struct qdf_trace_dump_src - one ring taking part in a merged dump
+ * @tbl: record table of the ring
+ * @size: number of entries in @tbl
+ * @base: slot of the record with sequence number 0
+ * @oldest: sequence number of the oldest record still in the ring
+ * @first: sequence number of the oldest record picked for the dump
+ * @end: sequence number one past the newest record
+ * @widx: write index of a per cpu ring, NULL for the global ring
+ */
+struct qdf_trace_dump_src {
+	void *tbl;
+	uint32_t size;
+	uint32_t base;
+	uint32_t oldest;
+	uint32_t first;
+	uint32_t end;
+	local_t *widx;
+};
+
+/* the global ring plus one ring per cpu */
+#define QDF_TRACE_DUMP_SRC_MAX (QDF_MAX_AVAILABLE_CPU + 1)
+
+/**
+ * struct qdf_trace_dump_ops - record layout and sink of a merged dump
+ * @rec_size: size of one record in the ring tables
+ * @rec_time: returns the timestamp of a record
+ * @emit: hands a copy of a dumped record to the trace's callbacks
+ */
+struct qdf_trace_dump_ops {
+	size_t rec_size;
+	uint64_t (*rec_time)(const void *rec);
+	void (*emit)(void *ctx, void *rec, uint16_t index);
+};
+
+static inline void *
+qdf_trace_dump_src_rec(const struct qdf_trace_dump_ops *ops,
+		       struct qdf_trace_dump_src *src, uint32_t seq)
+{
+	return (uint8_t *)src->tbl +
+		((src->base + seq) % src->size) * ops->rec_size;
+}
+
+static inline uint64_t
+qdf_trace_dump_src_time(const struct qdf_trace_dump_ops *ops,
+			struct qdf_trace_dump_src *src, uint32_t seq)
+{
+	return ops->rec_time(qdf_trace_dump_src_rec(ops, src, seq));
+}
+
+/**
+ * qdf_trace_dump_merge() - dump snapshotted rings merged by timestamp
+ * @srcs: the rings, as snapshotted by the caller
+ * @nsrc: number of entries in @srcs
+ * @count: number of newest records to dump, 0 for all
+ * @ops: record layout and sink
+ * @ctx: passed to @ops->emit
+ * @rec: buffer of @ops->rec_size bytes a record is copied to
+ *
+ * The newest @count records over all rings are picked walking backwards
+ * by timestamp and then handed to @ops->emit oldest first. The rings are
+ * read in place while writers keep going: a per cpu ring record is copied
+ * out and then checked against the ring's write index, and skipped if a
+ * writer wrapped onto its slot meanwhile. Records of the global ring are
+ * not checked, and the newest record of a ring may still be being
+ * written when it is copied.
+ *
+ * Return: None
+ */
+static void qdf_trace_dump_merge(struct qdf_trace_dump_src *srcs, int nsrc,
+				 uint32_t count,
+				 const struct qdf_trace_dump_ops *ops,
+				 void *ctx, void *rec)
+{
+	struct qdf_trace_dump_src *src;
+	uint32_t seq, picked = 0, dumped = 0;
+	int i, best;
+
+	/* walk back from the newest records until count of them are picked */
+	while (!count || picked < count) {
+		best = -1;
+		for (i = 0; i < nsrc; i++) {
+			src = &srcs[i];
+			if (src->first == src->oldest)
+				continue;
+			if (best < 0 ||
+			    qdf_trace_dump_src_time(ops, src, src->first - 1) >
+			    qdf_trace_dump_src_time(ops, &srcs[best],
+						    srcs[best].first - 1))
+				best = i;
+		}
+		if (best < 0)
+			break;
+		srcs[best].first--;
+		picked++;
+	}
+
+	/* and replay them oldest first */
+	while (dumped < picked) {
+		best = -1;
+		for (i = 0; i < nsrc; i++) {
+			src = &srcs[i];
+			if (src->first == src->end)
+				continue;
+			if (best < 0 ||
+			    qdf_trace_dump_src_time(ops, src, src->first) <
+			    qdf_trace_dump_src_time(ops, &srcs[best],
+						    srcs[best].first))
+				best = i;
+		}
+		if (best < 0)
+			break;
+		src = &srcs[best];
+		seq = src->first++;
+		qdf_mem_copy(rec, qdf_trace_dump_src_rec(ops, src, seq),
+			     ops->rec_size);
+		if (src->widx) {
+			smp_rmb();
+			if ((uint32_t)local_read(src->widx) - seq > src->size) {
+				/* overwritten while it was being dumped */
+				dumped++;
+				continue;
+			}
+		}
+		ops->emit(ctx, rec, (uint16_t)dumped);
+		dumped++;
+	}
+}
+#endif
+
 #ifdef FEATURE_DP_TRACE
 /* Static and Global variables */
 static spinlock_t l_dp_trace_lock;
@@ -120,6 +273,44 @@ static struct s_qdf_dp_trace_data g_qdf_dp_trace_data;
  * are stored in qdf_dp_trace_cb_table, callbacks are initialized during init
  */
 static tp_qdf_dp_trace_cb qdf_dp_trace_cb_table[QDF_DP_TRACE_MAX];
+
+#ifdef FEATURE_DP_TRACE_PER_CPU
+/**
+ * struct qdf_dp_trace_cpu_ring - DP trace ring owned by a single cpu
+ * @widx: number of records ever written to this ring
+ * @tx_count: tx packets seen by qdf_dp_trace_set_track() on this cpu
+ * @rx_count: rx packets seen by qdf_dp_trace_set_track() on this cpu
+ * @rec: the records, slot is widx modulo MAX_QDF_DP_TRACE_CPU_RECORDS
+ *
+ * Same scheme as struct qdf_trace_cpu_ring: only the owning cpu writes,
+ * so neither the records nor the sampling counters need a lock.
+ */
+struct qdf_dp_trace_cpu_ring {
+	local_t widx;
+	local_t tx_count;
+	local_t rx_count;
+	struct qdf_dp_trace_record_s rec[MAX_QDF_DP_TRACE_CPU_RECORDS];
+} ____cacheline_aligned;
+
+static struct qdf_dp_trace_cpu_ring
+			g_qdf_dp_trace_cpu_ring[QDF_MAX_AVAILABLE_CPU];
+
+/**
+ * qdf_dp_trace_cpu_reset() - forget all records and counts of the cpu rings
+ *
+ * Return: None
+ */
+static void qdf_dp_trace_cpu_reset(void)
+{
+	int i;
+
+	for (i = 0; i < QDF_MAX_AVAILABLE_CPU; i++) {
+		local_set(&g_qdf_dp_trace_cpu_ring[i].widx, 0);
+		local_set(&g_qdf_dp_trace_cpu_ring[i].tx_count, 0);
+		local_set(&g_qdf_dp_trace_cpu_ring[i].rx_count, 0);
+	}
+}
+#endif /* FEATURE_DP_TRACE_PER_CPU */
 #endif
 /**
  * qdf_trace_set_level() - Set the trace level for a particular module
@@ -503,6 +694,10 @@ void qdf_trace_init(void)
 	g_qdf_trace_data.enable = true;
 	g_qdf_trace_data.dump_count = DEFAULT_QDF_TRACE_DUMP_COUNT;
 	g_qdf_trace_data.num_since_last_dump = 0;
+#ifdef FEATURE_QDF_TRACE_PER_CPU
+	for (i = 0; i < QDF_MAX_AVAILABLE_CPU; i++)
+		local_set(&g_qdf_trace_cpu_ring[i].widx, 0);
+#endif
 
 	for (i = 0; i < QDF_MODULE_ID_MAX; i++) {
 		qdf_trace_cb_table[i] = NULL;
@@ -511,6 +706,49 @@ void qdf_trace_init(void)
 }
 EXPORT_SYMBOL(qdf_trace_init);
 
+#ifdef FEATURE_QDF_TRACE_PER_CPU
+/**
+ * qdf_trace_cpu_record() - record an MTRACE message in the local cpu ring
+ * @module: Enum of module, basically module id.
+ * @code: Code to be recorded
+ * @session: Session ID of the log
+ * @data: Actual message contents
+ *
+ * Runs with only preemption disabled. CPUs without a ring of their own
+ * (id beyond QDF_MAX_AVAILABLE_CPU) are left to the global ring.
+ *
+ * Return: true if the record was taken, false otherwise
+ */
+static bool qdf_trace_cpu_record(uint8_t module, uint8_t code,
+				 uint16_t session, uint32_t data)
+{
+	struct qdf_trace_cpu_ring *ring;
+	tp_qdf_trace_record rec;
+	int cpu;
+
+	cpu = get_cpu();
+	if (qdf_unlikely(cpu >= QDF_MAX_AVAILABLE_CPU)) {
+		put_cpu();
+		return false;
+	}
+
+	ring = &g_qdf_trace_cpu_ring[cpu];
+	rec = &ring->rec[(local_inc_return(&ring->widx) - 1) &
+			 (MAX_QDF_TRACE_CPU_RECORDS - 1)];
+	/* order the index update before the record, for the dump check */
+	smp_wmb();
+	rec->code = code;
+	rec->session = session;
+	rec->data = data;
+	rec->time = qdf_get_log_timestamp();
+	rec->module = module;
+	rec->pid = (in_interrupt() ? 0 : current->pid);
+	put_cpu();
+
+	return true;
+}
+#endif /* FEATURE_QDF_TRACE_PER_CPU */
+
 /**
  * qdf_trace() - puts the messages in to ring-buffer
  * @module: Enum of module, basically module id.
@@ -536,6 +774,11 @@ void qdf_trace(uint8_t module, uint8_t code, uint16_t session, uint32_t data)
 	if (NULL == qdf_trace_cb_table[module])
 		return;
 
+#ifdef FEATURE_QDF_TRACE_PER_CPU
+	if (qdf_trace_cpu_record(module, code, session, data))
+		return;
+#endif
+
 	/* Aquire the lock so that only one thread at a time can fill the ring
 	 * buffer
 	 */
@@ -613,6 +856,107 @@ void qdf_trace_register(QDF_MODULE_ID module_iD,
 }
 EXPORT_SYMBOL(qdf_trace_register);
 
+#ifdef FEATURE_QDF_TRACE_PER_CPU
+/**
+ * struct qdf_trace_dump_filter - what qdf_trace_dump_all() was asked for
+ * @p_mac: Context of particular module
+ * @code: Reason code, 0 for all
+ * @bitmask_of_module: modules to dump, 0 for all
+ */
+struct qdf_trace_dump_filter {
+	void *p_mac;
+	uint8_t code;
+	uint32_t bitmask_of_module;
+};
+
+static uint64_t qdf_trace_rec_time(const void *rec)
+{
+	return ((const qdf_trace_record_t *)rec)->time;
+}
+
+static void qdf_trace_dump_emit(void *ctx, void *rec, uint16_t index)
+{
+	struct qdf_trace_dump_filter *filter = ctx;
+	tp_qdf_trace_record p_record = rec;
+
+	if ((filter->code == 0 || (filter->code == p_record->code)) &&
+	    (qdf_trace_cb_table[p_record->module] != NULL) &&
+	    (0 == filter->bitmask_of_module ||
+	     (filter->bitmask_of_module & (1 << p_record->module))))
+		qdf_trace_cb_table[p_record->module](filter->p_mac, p_record,
+						     index);
+}
+
+static const struct qdf_trace_dump_ops qdf_trace_dump_ops = {
+	.rec_size = sizeof(qdf_trace_record_t),
+	.rec_time = qdf_trace_rec_time,
+	.emit = qdf_trace_dump_emit,
+};
+
+/**
+ * qdf_trace_dump_merged() - dump the per cpu and global rings by timestamp
+ * @p_mac: Context of particular module
+ * @code: Reason code
+ * @count: Number of newest records to dump, 0 for all
+ * @bitmask_of_module: modules to dump, 0 for all
+ *
+ * Snapshots every ring and merges them with qdf_trace_dump_merge().
+ *
+ * Return: None
+ */
+static void qdf_trace_dump_merged(void *p_mac, uint8_t code, uint32_t count,
+				  uint32_t bitmask_of_module)
+{
+	struct qdf_trace_dump_src srcs[QDF_TRACE_DUMP_SRC_MAX];
+	struct qdf_trace_dump_src *src;
+	struct qdf_trace_dump_filter filter = {
+		.p_mac = p_mac,
+		.code = code,
+		.bitmask_of_module = bitmask_of_module,
+	};
+	qdf_trace_record_t p_record;
+	uint32_t widx, num, total = 0;
+	int nsrc = 0, i;
+
+	for (i = 0; i < QDF_MAX_AVAILABLE_CPU; i++) {
+		widx = (uint32_t)local_read(&g_qdf_trace_cpu_ring[i].widx);
+		if (!widx)
+			continue;
+		num = min_t(uint32_t, widx, MAX_QDF_TRACE_CPU_RECORDS);
+		src = &srcs[nsrc++];
+		src->tbl = g_qdf_trace_cpu_ring[i].rec;
+		src->size = MAX_QDF_TRACE_CPU_RECORDS;
+		src->base = 0;
+		src->oldest = widx - num;
+		src->first = widx;
+		src->end = widx;
+		src->widx = &g_qdf_trace_cpu_ring[i].widx;
+		total += num;
+	}
+
+	spin_lock(&ltrace_lock);
+	if (g_qdf_trace_data.head != INVALID_QDF_TRACE_ADDR) {
+		src = &srcs[nsrc++];
+		src->tbl = g_qdf_trace_tbl;
+		src->size = MAX_QDF_TRACE_RECORDS;
+		src->base = g_qdf_trace_data.head;
+		src->oldest = 0;
+		src->first = g_qdf_trace_data.num;
+		src->end = g_qdf_trace_data.num;
+		src->widx = NULL;
+		total += g_qdf_trace_data.num;
+	}
+	g_qdf_trace_data.num_since_last_dump = 0;
+	spin_unlock(&ltrace_lock);
+
+	QDF_TRACE(QDF_MODULE_ID_SYS, QDF_TRACE_LEVEL_INFO,
+		  "Total Records: %d, Rings: %d", total, nsrc);
+
+	qdf_trace_dump_merge(srcs, nsrc, count, &qdf_trace_dump_ops, &filter,
+			     &p_record);
+}
+#endif /* FEATURE_QDF_TRACE_PER_CPU */
+
 /**
  * qdf_trace_dump_all() - Dump data from ring buffer via call back functions
  * registered with QDF
@@ -636,8 +980,10 @@ EXPORT_SYMBOL(qdf_trace_register);
 void qdf_trace_dump_all(void *p_mac, uint8_t code, uint8_t session,
 			uint32_t count, uint32_t bitmask_of_module)
 {
+#ifndef FEATURE_QDF_TRACE_PER_CPU
 	qdf_trace_record_t p_record;
 	int32_t i, tail;
+#endif
 
 	if (!g_qdf_trace_data.enable) {
 		QDF_TRACE(QDF_MODULE_ID_SYS,
@@ -645,6 +991,9 @@ void qdf_trace_dump_all(void *p_mac, uint8_t code, uint8_t session,
 		return;
 	}
 
+#ifdef FEATURE_QDF_TRACE_PER_CPU
+	qdf_trace_dump_merged(p_mac, code, count, bitmask_of_module);
+#else
 	QDF_TRACE(QDF_MODULE_ID_SYS, QDF_TRACE_LEVEL_INFO,
 		  "Total Records: %d, Head: %d, Tail: %d",
 		  g_qdf_trace_data.num, g_qdf_trace_data.head,
@@ -713,6 +1062,7 @@ void qdf_trace_dump_all(void *p_mac, uint8_t code, uint8_t session,
 	} else {
 		spin_unlock(&ltrace_lock);
 	}
+#endif /* FEATURE_QDF_TRACE_PER_CPU */
 }
 EXPORT_SYMBOL(qdf_trace_dump_all);
 
@@ -736,6 +1086,9 @@ void qdf_dp_trace_init(void)
 	g_qdf_dp_trace_data.no_of_record = 0;
 	g_qdf_dp_trace_data.verbosity    = QDF_DP_TRACE_VERBOSITY_LOW;
 	g_qdf_dp_trace_data.enable = true;
+#ifdef FEATURE_DP_TRACE_PER_CPU
+	qdf_dp_trace_cpu_reset();
+#endif
 
 	for (i = 0; i < QDF_DP_TRACE_MAX; i++)
 		qdf_dp_trace_cb_table[i] = qdf_dp_display_record;
@@ -819,17 +1172,65 @@ uint8_t qdf_dp_get_proto_bitmap(void)
 		return 0;
 }
 
+#ifdef FEATURE_DP_TRACE_PER_CPU
+/**
+ * qdf_dp_trace_cpu_count() - count a packet on the local cpu
+ * @dir: direction
+ * @count: filled with the packet number on this cpu for @dir
+ *
+ * Return: true if counted, false if the cpu has no ring of its own
+ */
+static bool qdf_dp_trace_cpu_count(enum qdf_proto_dir dir, uint32_t *count)
+{
+	struct qdf_dp_trace_cpu_ring *ring;
+	int cpu;
+
+	cpu = get_cpu();
+	if (qdf_unlikely(cpu >= QDF_MAX_AVAILABLE_CPU)) {
+		put_cpu();
+		return false;
+	}
+
+	ring = &g_qdf_dp_trace_cpu_ring[cpu];
+	if (QDF_TX == dir)
+		*count = (uint32_t)local_inc_return(&ring->tx_count);
+	else if (QDF_RX == dir)
+		*count = (uint32_t)local_inc_return(&ring->rx_count);
+	put_cpu();
+
+	return true;
+}
+#endif /* FEATURE_DP_TRACE_PER_CPU */
+
 /**
  * qdf_dp_trace_set_track() - Marks whether the packet needs to be traced
  * @nbuf: defines the netbuf
  * @dir: direction
  *
+ * With FEATURE_DP_TRACE_PER_CPU every cpu samples one in no_of_record of
+ * the packets it sees, without taking l_dp_trace_lock.
+ *
  * Return: None
  */
 void qdf_dp_trace_set_track(qdf_nbuf_t nbuf, enum qdf_proto_dir dir)
 {
 	uint32_t count = 0;
 
+#ifdef FEATURE_DP_TRACE_PER_CPU
+	if (g_qdf_dp_trace_data.no_of_record == 0)
+		return;
+
+	if (qdf_dp_trace_cpu_count(dir, &count)) {
+		if (count % g_qdf_dp_trace_data.no_of_record == 0) {
+			if (QDF_TX == dir)
+				QDF_NBUF_CB_TX_DP_TRACE(nbuf) = 1;
+			else if (QDF_RX == dir)
+				QDF_NBUF_CB_RX_DP_TRACE(nbuf) = 1;
+		}
+		return;
+	}
+#endif
+
 	spin_lock_bh(&l_dp_trace_lock);
 	if (QDF_TX == dir)
 		count = ++g_qdf_dp_trace_data.tx_count;
@@ -1054,6 +1455,63 @@ bool qdf_dp_enable_check(qdf_nbuf_t nbuf, enum QDF_DP_TRACE_ID code,
 }
 EXPORT_SYMBOL(qdf_dp_enable_check);
 
+#ifdef FEATURE_DP_TRACE_PER_CPU
+/**
+ * qdf_dp_trace_cpu_record() - add a dp trace record to the local cpu ring
+ * @code: dptrace code
+ * @data: data pointer
+ * @size: size of buffer
+ * @print: true to print it in kmsg
+ *
+ * Runs with only preemption disabled. A record to be printed is copied
+ * out first, so the print does not race with later writers on this cpu.
+ *
+ * Return: true if the record was taken, false if the cpu has no ring
+ */
+static bool qdf_dp_trace_cpu_record(enum QDF_DP_TRACE_ID code,
+				    uint8_t *data, uint8_t size, bool print)
+{
+	struct qdf_dp_trace_cpu_ring *ring;
+	struct qdf_dp_trace_record_s *rec;
+	struct qdf_dp_trace_record_s p_record;
+	uint32_t index;
+	int cpu;
+
+	cpu = get_cpu();
+	if (qdf_unlikely(cpu >= QDF_MAX_AVAILABLE_CPU)) {
+		put_cpu();
+		return false;
+	}
+
+	ring = &g_qdf_dp_trace_cpu_ring[cpu];
+	index = (uint32_t)(local_inc_return(&ring->widx) - 1) &
+		(MAX_QDF_DP_TRACE_CPU_RECORDS - 1);
+	rec = &ring->rec[index];
+	/* order the index update before the record, for the dump check */
+	smp_wmb();
+	rec->code = code;
+	rec->size = 0;
+	if (data != NULL && size > 0) {
+		if (size > QDF_DP_TRACE_RECORD_SIZE)
+			size = QDF_DP_TRACE_RECORD_SIZE;
+
+		rec->size = size;
+		qdf_mem_copy(rec->data, data, size);
+	}
+	rec->time = qdf_get_log_timestamp();
+	rec->pid = (in_interrupt() ? 0 : current->pid);
+	if (print)
+		p_record = *rec;
+	put_cpu();
+
+	if (print)
+		qdf_dp_trace_cb_table[p_record.code](&p_record,
+						     (uint16_t)index);
+
+	return true;
+}
+#endif /* FEATURE_DP_TRACE_PER_CPU */
+
 /**
  * qdf_dp_add_record() - add dp trace record
  * @code: dptrace code
@@ -1061,6 +1519,10 @@ EXPORT_SYMBOL(qdf_dp_enable_check);
  * @size: size of buffer
  * @print: true to print it in kmsg
  *
+ * With FEATURE_DP_TRACE_PER_CPU the record goes to the ring of the local
+ * cpu without taking l_dp_trace_lock; the global ring is only used by
+ * cpus without a ring of their own.
+ *
  * Return: none
  */
 void qdf_dp_add_record(enum QDF_DP_TRACE_ID code,
@@ -1068,6 +1530,13 @@ void qdf_dp_add_record(enum QDF_DP_TRACE_ID code,
 {
 	struct qdf_dp_trace_record_s *rec = NULL;
 	int index;
+
+#ifdef FEATURE_DP_TRACE_PER_CPU
+	if (qdf_dp_trace_cpu_record(code, data, size,
+				    g_qdf_dp_trace_data.live_mode || print))
+		return;
+#endif
+
 	spin_lock_bh(&l_dp_trace_lock);
 
 	g_qdf_dp_trace_data.num++;
@@ -1497,12 +1966,90 @@ void qdf_dp_trace_clear_buffer(void)
 	g_qdf_dp_trace_data.no_of_record = 0;
 	g_qdf_dp_trace_data.verbosity    = QDF_DP_TRACE_VERBOSITY_LOW;
 	g_qdf_dp_trace_data.enable = true;
+#ifdef FEATURE_DP_TRACE_PER_CPU
+	qdf_dp_trace_cpu_reset();
+#endif
 
 	memset(g_qdf_dp_trace_tbl, 0,
 	   MAX_QDF_DP_TRACE_RECORDS * sizeof(struct qdf_dp_trace_record_s));
 }
 EXPORT_SYMBOL(qdf_dp_trace_clear_buffer);
 
+#ifdef FEATURE_DP_TRACE_PER_CPU
+static uint64_t qdf_dp_trace_rec_time(const void *rec)
+{
+	return ((const struct qdf_dp_trace_record_s *)rec)->time;
+}
+
+static void qdf_dp_trace_dump_emit(void *ctx, void *rec, uint16_t index)
+{
+	struct qdf_dp_trace_record_s *p_record = rec;
+
+	if (p_record->code < QDF_DP_TRACE_MAX)
+		qdf_dp_trace_cb_table[p_record->code](p_record, index);
+}
+
+static const struct qdf_trace_dump_ops qdf_dp_trace_dump_ops = {
+	.rec_size = sizeof(struct qdf_dp_trace_record_s),
+	.rec_time = qdf_dp_trace_rec_time,
+	.emit = qdf_dp_trace_dump_emit,
+};
+
+/**
+ * qdf_dp_trace_dump_merged() - dump the per cpu and global rings by timestamp
+ * @count: Number of newest records to dump, 0 for all
+ *
+ * Snapshots every ring and merges them with qdf_trace_dump_merge(), as
+ * qdf_trace_dump_merged() does for MTRACE.
+ *
+ * Return: None
+ */
+static void qdf_dp_trace_dump_merged(uint32_t count)
+{
+	struct qdf_trace_dump_src srcs[QDF_TRACE_DUMP_SRC_MAX];
+	struct qdf_trace_dump_src *src;
+	struct qdf_dp_trace_record_s p_record;
+	uint32_t widx, num, total = 0;
+	int nsrc = 0, i;
+
+	for (i = 0; i < QDF_MAX_AVAILABLE_CPU; i++) {
+		widx = (uint32_t)local_read(&g_qdf_dp_trace_cpu_ring[i].widx);
+		if (!widx)
+			continue;
+		num = min_t(uint32_t, widx, MAX_QDF_DP_TRACE_CPU_RECORDS);
+		src = &srcs[nsrc++];
+		src->tbl = g_qdf_dp_trace_cpu_ring[i].rec;
+		src->size = MAX_QDF_DP_TRACE_CPU_RECORDS;
+		src->base = 0;
+		src->oldest = widx - num;
+		src->first = widx;
+		src->end = widx;
+		src->widx = &g_qdf_dp_trace_cpu_ring[i].widx;
+		total += num;
+	}
+
+	spin_lock_bh(&l_dp_trace_lock);
+	if (g_qdf_dp_trace_data.head != INVALID_QDF_DP_TRACE_ADDR) {
+		src = &srcs[nsrc++];
+		src->tbl = g_qdf_dp_trace_tbl;
+		src->size = MAX_QDF_DP_TRACE_RECORDS;
+		src->base = g_qdf_dp_trace_data.head;
+		src->oldest = 0;
+		src->first = g_qdf_dp_trace_data.num;
+		src->end = g_qdf_dp_trace_data.num;
+		src->widx = NULL;
+		total += g_qdf_dp_trace_data.num;
+	}
+	spin_unlock_bh(&l_dp_trace_lock);
+
+	QDF_TRACE(QDF_MODULE_ID_SYS, QDF_TRACE_LEVEL_ERROR,
+		  "Total Records: %d, Rings: %d", total, nsrc);
+
+	qdf_trace_dump_merge(srcs, nsrc, count, &qdf_dp_trace_dump_ops, NULL,
+			     &p_record);
+}
+#endif /* FEATURE_DP_TRACE_PER_CPU */
+
 /**
  * qdf_dp_trace_dump_all() - Dump data from ring buffer via call back functions
  * registered with QDF
@@ -1513,8 +2060,10 @@ EXPORT_SYMBOL(qdf_dp_trace_clear_buffer);
  */
 void qdf_dp_trace_dump_all(uint32_t count)
 {
+#ifndef FEATURE_DP_TRACE_PER_CPU
 	struct qdf_dp_trace_record_s p_record;
 	int32_t i, tail;
+#endif
 
 	if (!g_qdf_dp_trace_data.enable) {
 		QDF_TRACE(QDF_MODULE_ID_SYS,
@@ -1522,6 +2071,9 @@ void qdf_dp_trace_dump_all(uint32_t count)
 		return;
 	}
 
+#ifdef FEATURE_DP_TRACE_PER_CPU
+	qdf_dp_trace_dump_merged(count);
+#else
 	QDF_TRACE(QDF_MODULE_ID_SYS, QDF_TRACE_LEVEL_ERROR,
 		  "Total Records: %d, Head: %d, Tail: %d",
 		  g_qdf_dp_trace_data.num, g_qdf_dp_trace_data.head,
@@ -1566,6 +2118,7 @@ void qdf_dp_trace_dump_all(uint32_t count)
 	} else {
 		spin_unlock_bh(&l_dp_trace_lock);
 	}
+#endif /* FEATURE_DP_TRACE_PER_CPU */
 }
 EXPORT_SYMBOL(qdf_dp_trace_dump_all);
 #endif
@@ -175,6 +175,64 @@ int
 wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, uint32_t buflen,
 			uint32_t cmd_id);
 
+/*
+ * commands a batch holds before it is flushed on its own, kept well under
+ * WMI_MAX_CMDS as every queued command holds a pending_cmds reference
+ */
+#define WMI_CMD_BATCH_MAX_DEPTH 64
+
+/**
+ * struct wmi_cmd_batch - commands held back for one multi-packet HTC send
+ * @queue: HTC packets of prepared commands waiting for the commit
+ *
+ * Owned by the caller building the batch, usually on its stack; other
+ * contexts keep sending through wmi_unified_cmd_send() unaffected.
+ */
+struct wmi_cmd_batch {
+	HTC_PACKET_QUEUE queue;
+};
+
+/**
+ * wmi_unified_cmd_batch_begin() - start a batch of WMI commands
+ * @wmi_handle: handle to WMI.
+ * @batch: caller owned batch context
+ *
+ * Return: none
+ */
+void wmi_unified_cmd_batch_begin(wmi_unified_t wmi_handle,
+				 struct wmi_cmd_batch *batch);
+
+/**
+ * wmi_unified_cmd_batch_add() - queue a built WMI command in a batch
+ * @wmi_handle: handle to WMI.
+ * @batch: batch started with wmi_unified_cmd_batch_begin()
+ * @buf: wmi command buffer
+ * @buflen: wmi command buffer length
+ * @cmd_id: WMI cmd id
+ *
+ * The command is validated and queued in @batch. A batch already
+ * holding WMI_CMD_BATCH_MAX_DEPTH commands is sent first.
+ *
+ * Return: 0 on success, -ve if that flush failed or the command could
+ *	not be prepared; @buf is then still owned by the caller
+ */
+int wmi_unified_cmd_batch_add(wmi_unified_t wmi_handle,
+			      struct wmi_cmd_batch *batch, wmi_buf_t buf,
+			      uint32_t buflen, uint32_t cmd_id);
+
+/**
+ * wmi_unified_cmd_batch_commit() - send all queued WMI commands at once
+ * @wmi_handle: handle to WMI.
+ * @batch: batch started with wmi_unified_cmd_batch_begin()
+ *
+ * Hands the queued commands to htc_send_pkts_multiple() in one call and
+ * ends the batch. Commands HTC rejects are completed and freed here.
+ *
+ * Return: 0 on success and -ve on failure.
+ */
+int wmi_unified_cmd_batch_commit(wmi_unified_t wmi_handle,
+				 struct wmi_cmd_batch *batch);
+
 /**
  * wmi_unified_register_event_handler() - WMI event handler
  * registration function
@@ -1250,6 +1308,21 @@ QDF_STATUS wmi_extract_vdev_stats(void *wmi_hdl, void *evt_buf,
 QDF_STATUS wmi_extract_vdev_extd_stats(void *wmi_hdl, void *evt_buf,
 		uint32_t index, wmi_host_vdev_extd_stats *vdev_extd_stats);
 
+QDF_STATUS wmi_extract_stats_view(void *wmi_hdl, void *evt_buf,
+		struct wmi_host_stats_view *view);
+
+QDF_STATUS wmi_extract_vdev_stats_bulk(void *wmi_hdl, void *evt_buf,
+		uint32_t start, uint32_t num, wmi_host_vdev_stats *vdev_stats,
+		uint32_t *num_filled);
+
+QDF_STATUS wmi_extract_peer_stats_bulk(void *wmi_hdl, void *evt_buf,
+		uint32_t start, uint32_t num, wmi_host_peer_stats *peer_stats,
+		uint32_t *num_filled);
+
+QDF_STATUS wmi_extract_chan_stats_bulk(void *wmi_hdl, void *evt_buf,
+		uint32_t start, uint32_t num, wmi_host_chan_stats *chan_stats,
+		uint32_t *num_filled);
+
 QDF_STATUS wmi_unified_send_power_dbg_cmd(void *wmi_hdl,
 				struct wmi_power_dbg_params *param);
 QDF_STATUS wmi_unified_send_adapt_dwelltime_params_cmd(void *wmi_hdl,
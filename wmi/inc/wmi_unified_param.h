@@ -4566,6 +4566,40 @@ typedef struct {
 	uint32_t rx_duration_us;
 } wmi_host_chan_stats;
 
+/**
+ * struct wmi_host_stats_view - stats arrays of an update stats event
+ * @pdev: first pdev stats record
+ * @vdev: first vdev stats record
+ * @peer: first peer stats record
+ * @chan: first chan stats record
+ * @num_pdev_stats: number of pdev stats records
+ * @num_vdev_stats: number of vdev stats records
+ * @num_peer_stats: number of peer stats records
+ * @num_chan_stats: number of chan stats records
+ * @pdev_stats_size: size of one pdev stats record
+ * @vdev_stats_size: size of one vdev stats record
+ * @peer_stats_size: size of one peer stats record
+ * @chan_stats_size: size of one chan stats record
+ *
+ * Points into the event buffer, so it is only valid while the event is
+ * being handled. Records are in the target layout (wmi_peer_stats etc.)
+ * of the WMI flavour in use; step through them by the record sizes.
+ */
+struct wmi_host_stats_view {
+	const uint8_t *pdev;
+	const uint8_t *vdev;
+	const uint8_t *peer;
+	const uint8_t *chan;
+	uint32_t num_pdev_stats;
+	uint32_t num_vdev_stats;
+	uint32_t num_peer_stats;
+	uint32_t num_chan_stats;
+	uint32_t pdev_stats_size;
+	uint32_t vdev_stats_size;
+	uint32_t peer_stats_size;
+	uint32_t chan_stats_size;
+};
+
 #define WMI_EVENT_ID_INVALID 0
 /**
  * Host based ENUM IDs for events to abstract target enums for event_id
@@ -35,19 +35,154 @@
 #include "a_types.h"
 #include "wmi_unified_param.h"
 #include "qdf_atomic.h"
+#include <linux/seqlock.h>
 
 #define WMI_UNIFIED_MAX_EVENT 0x100
 #define WMI_MAX_CMDS  1024
 
+/* event dispatch hash table, kept at most half full */
+#define WMI_EVENT_DISPATCH_TBL_SIZE (WMI_UNIFIED_MAX_EVENT * 2)
+#define WMI_EVENT_DISPATCH_TBL_MASK (WMI_EVENT_DISPATCH_TBL_SIZE - 1)
+
+/**
+ * struct wmi_event_dispatch_tbl - WMI event id to handler index map
+ * @event_id: event id occupying each slot
+ * @handler_ix: handler index + 1 for the slot's event id, 0 if empty
+ *
+ * Open addressing hash table with linear probing.  Register/unregister
+ * rebuild it in place inside a write section of event_dispatch_seq;
+ * readers take no lock and retry a lookup that overlapped a rebuild.
+ */
+struct wmi_event_dispatch_tbl {
+	uint32_t event_id[WMI_EVENT_DISPATCH_TBL_SIZE];
+	uint16_t handler_ix[WMI_EVENT_DISPATCH_TBL_SIZE];
+};
+
 typedef qdf_nbuf_t wmi_buf_t;
 
+/* bytes reserved in the TLV arena for padding short event TLVs */
+#define WMITLV_ARENA_PAD_SIZE 1024
+
+/**
+ * struct wmitlv_arena - per wmi handle scratch memory for event TLV parsing
+ * @buf: arena memory
+ * @size: size of @buf in bytes
+ * @used: bytes carved from @buf for the event being parsed
+ * @in_use: set while an event parsed into the arena is being handled
+ * @hits: buffers carved from the arena
+ * @fallbacks: buffers allocated from the heap because the arena was busy
+ *	or out of room
+ */
+struct wmitlv_arena {
+	uint8_t *buf;
+	uint32_t size;
+	uint32_t used;
+	qdf_atomic_t in_use;
+	qdf_atomic_t hits;
+	qdf_atomic_t fallbacks;
+};
+
+/**
+ * struct wmi_htc_pkt_pool - per wmi handle pool of command HTC packets
+ * @pkts: WMI_MAX_CMDS preallocated packets
+ * @map: bitmap of packets in @pkts handed out to a pending command
+ * @hint: slot the next search for a free packet starts at
+ * @hits: packets taken from the pool
+ * @fallbacks: packets allocated from the heap because the pool was
+ *	missing or exhausted
+ */
+struct wmi_htc_pkt_pool {
+	HTC_PACKET *pkts;
+	unsigned long map[BITS_TO_LONGS(WMI_MAX_CMDS)];
+	qdf_atomic_t hint;
+	qdf_atomic_t hits;
+	qdf_atomic_t fallbacks;
+};
+
+/* number of rx work queues sharing events that are not time critical */
+#ifndef WMI_RX_BULK_QUEUE_NUM
+#define WMI_RX_BULK_QUEUE_NUM 2
+#endif
+/* rx work queue 0 carries time critical events, the bulk queues follow */
+#define WMI_RX_QUEUE_HIGH_PRI 0
+#define WMI_RX_QUEUE_NUM (1 + WMI_RX_BULK_QUEUE_NUM)
+/* enqueue timestamps kept per rx queue for latency stats, power of 2 */
+#define WMI_RX_QUEUE_TS_RING 64
+
+/**
+ * struct wmi_rx_queue - one rx work context for WMI_RX_WORK_CTX events
+ * @wmi_handle: handle owning the queue
+ * @lock: protects everything below
+ * @events: events waiting for @work
+ * @work: worker draining @events in order
+ * @enq_ts: enqueue time in us of the last WMI_RX_QUEUE_TS_RING events
+ * @enq_seq: events queued so far
+ * @deq_seq: events dequeued so far
+ * @depth: events currently in @events
+ * @max_depth: high watermark of @depth
+ * @processed: events handed to __wmi_control_rx()
+ * @total_latency_us: summed queueing latency of the sampled events
+ * @max_latency_us: worst queueing latency seen
+ * @latency_samples: events whose queueing latency was sampled; events
+ *	queued more than WMI_RX_QUEUE_TS_RING deep are not sampled
+ */
+struct wmi_rx_queue {
+	struct wmi_unified *wmi_handle;
+	qdf_spinlock_t lock;
+	qdf_nbuf_queue_t events;
+	struct work_struct work;
+	uint64_t enq_ts[WMI_RX_QUEUE_TS_RING];
+	uint32_t enq_seq;
+	uint32_t deq_seq;
+	uint32_t depth;
+	uint32_t max_depth;
+	uint32_t processed;
+	uint64_t total_latency_us;
+	uint64_t max_latency_us;
+	uint32_t latency_samples;
+};
+
 #ifdef WMI_INTERFACE_EVENT_LOGGING
 
 #define WMI_EVENT_DEBUG_MAX_ENTRY (1024)
+#ifndef WMI_EVENT_DEBUG_ENTRY_MAX_LENGTH
+/* payload bytes kept per record, a multiple of 4 and at least 16 */
 #define WMI_EVENT_DEBUG_ENTRY_MAX_LENGTH (16)
+#endif
 /* wmi_mgmt commands */
 #define WMI_MGMT_EVENT_DEBUG_MAX_ENTRY (256)
 
+#ifdef WMI_LOG_PERCPU
+#ifndef WMI_LOG_PERCPU_RING_SIZE
+/* records per CPU of each log, must be a power of 2 */
+#define WMI_LOG_PERCPU_RING_SIZE (64)
+#endif
+
+/**
+ * struct wmi_log_percpu_entry - record of a per-CPU WMI log
+ * @seq: sequence number on its CPU, 0 while the record is being written
+ * @id: WMI command or event id
+ * @time: time the record was taken
+ * @data: start of the command or event payload
+ */
+struct wmi_log_percpu_entry {
+	uint32_t seq;
+	uint32_t id;
+	uint64_t time;
+	uint32_t data[WMI_EVENT_DEBUG_ENTRY_MAX_LENGTH/sizeof(uint32_t)];
+};
+
+/**
+ * struct wmi_log_percpu_ring - records of one WMI log taken on one CPU
+ * @seq: sequence number of the newest record
+ * @entry: records, indexed by sequence number
+ */
+struct wmi_log_percpu_ring {
+	uint32_t seq;
+	struct wmi_log_percpu_entry entry[WMI_LOG_PERCPU_RING_SIZE];
+};
+#endif
+
 /**
  * struct wmi_command_debug - WMI command log buffer data type
  * @ command - Store WMI Command id
@@ -103,12 +238,18 @@ struct wmi_command_header {
  * @ buf_tail_idx - Tail index of buffer
  * @ p_buf_tail_idx - refernce to buffer tail index. It is added to accommodate
  * unified design since MCL uses global variable for buffer tail index
+ * @ percpu - per-CPU rings used instead of @buf with WMI_LOG_PERCPU
+ * @ clear_time - records up to this time were cleared through debugfs
  */
 struct wmi_log_buf_t {
 	void *buf;
 	uint32_t length;
 	uint32_t buf_tail_idx;
 	uint32_t *p_buf_tail_idx;
+#ifdef WMI_LOG_PERCPU
+	struct wmi_log_percpu_ring __percpu *percpu;
+	uint64_t clear_time;
+#endif
 };
 
 /**
@@ -1082,6 +1223,21 @@ QDF_STATUS (*extract_peer_extd_stats)(wmi_unified_t wmi_handle, void *evt_buf,
 QDF_STATUS (*extract_chan_stats)(wmi_unified_t wmi_handle, void *evt_buf,
 			 uint32_t index, wmi_host_chan_stats *chan_stats);
 
+QDF_STATUS (*extract_stats_view)(wmi_unified_t wmi_handle, void *evt_buf,
+			 struct wmi_host_stats_view *view);
+
+QDF_STATUS (*extract_vdev_stats_bulk)(wmi_unified_t wmi_handle, void *evt_buf,
+			 uint32_t start, uint32_t num,
+			 wmi_host_vdev_stats *vdev_stats, uint32_t *num_filled);
+
+QDF_STATUS (*extract_peer_stats_bulk)(wmi_unified_t wmi_handle, void *evt_buf,
+			 uint32_t start, uint32_t num,
+			 wmi_host_peer_stats *peer_stats, uint32_t *num_filled);
+
+QDF_STATUS (*extract_chan_stats_bulk)(wmi_unified_t wmi_handle, void *evt_buf,
+			 uint32_t start, uint32_t num,
+			 wmi_host_chan_stats *chan_stats, uint32_t *num_filled);
+
 QDF_STATUS (*extract_thermal_stats)(wmi_unified_t wmi_handle, void *evt_buf,
 	uint32_t *temp, uint32_t *level);
 
@@ -1158,10 +1314,15 @@ struct wmi_unified {
 	wmi_unified_event_handler event_handler[WMI_UNIFIED_MAX_EVENT];
 	enum wmi_rx_exec_ctx ctx[WMI_UNIFIED_MAX_EVENT];
 	uint32_t max_event_idx;
+	struct wmi_event_dispatch_tbl event_dispatch;
+	seqcount_t event_dispatch_seq;
+	struct wmitlv_arena tlv_arena;
+	struct wmi_htc_pkt_pool htc_pkt_pool;
 	void *htc_handle;
-	qdf_spinlock_t eventq_lock;
-	qdf_nbuf_queue_t event_queue;
-	struct work_struct rx_event_work;
+	struct workqueue_struct *rx_wq;
+	struct workqueue_struct *rx_hipri_wq;
+	struct wmi_rx_queue rx_queue[WMI_RX_QUEUE_NUM];
+	uint8_t rx_queue_ix[WMI_UNIFIED_MAX_EVENT];
 	int wmi_stop_in_progress;
 #ifndef WMI_NON_TLV_SUPPORT
 	struct _wmi_abi_version fw_abi_version;
@@ -1205,10 +1366,27 @@ struct wmi_unified {
 /* ONLY_NON_TLV_TARGET:TLV attach dummy function defintion for case when
  * driver supports only NON-TLV target (WIN mainline) */
 #define wmi_tlv_attach(x) qdf_print("TLV Unavailable\n")
+#define wmitlv_build_attr_index()
+#define wmitlv_arena_init(x) 0
+#define wmitlv_arena_deinit(x)
 #else
 void wmi_tlv_attach(wmi_unified_t wmi_handle);
+void wmitlv_build_attr_index(void);
+int wmitlv_arena_init(struct wmitlv_arena *arena);
+void wmitlv_arena_deinit(struct wmitlv_arena *arena);
+int wmitlv_check_and_pad_event_tlvs_arena(void *os_handle,
+					  void *param_struc_ptr,
+					  A_UINT32 param_buf_len,
+					  A_UINT32 wmi_cmd_event_id,
+					  struct wmitlv_arena *arena,
+					  void **wmi_cmd_struct_ptr);
+void wmitlv_free_allocated_event_tlvs_arena(A_UINT32 cmd_event_id,
+					    struct wmitlv_arena *arena,
+					    void **wmi_cmd_struct_ptr);
 #endif
 void wmi_non_tlv_attach(wmi_unified_t wmi_handle);
+int wmi_unified_cmd_send_trusted(wmi_unified_t wmi_handle, wmi_buf_t buf,
+				 uint32_t len, uint32_t cmd_id);
 
 /**
  * wmi_align() - provides word aligned parameter
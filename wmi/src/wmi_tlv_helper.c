@@ -28,6 +28,7 @@
 #include "wmi_tlv_platform.c"
 #include "wmi_tlv_defs.h"
 #include "wmi_version.h"
+#include "wmi_unified_priv.h"
 
 #define WMITLV_GET_ATTRIB_NUM_TLVS  0xFFFFFFFF
 
@@ -61,6 +62,136 @@ A_UINT32 evt_attr_list[] = {
 	WMITLV_ALL_EVT_LIST(WMITLV_GET_CMD_EVT_ATTRB_LIST)
 };
 
+/*
+ * Hashed index from command/event id to the offset of its attribute
+ * slice in cmd_attr_list/evt_attr_list, built once at attach time so
+ * wmitlv_get_attributes() does not walk the lists for every TLV.
+ * Each slot holds (offset + 1), 0 marks an empty slot.  The tables are
+ * sized to a little over twice the number of commands/events.
+ */
+#define WMITLV_CMD_EVT_COUNT(id) + 1
+#define WMITLV_NUM_CMDS (0 WMITLV_ALL_CMD_LIST(WMITLV_CMD_EVT_COUNT))
+#define WMITLV_NUM_EVTS (0 WMITLV_ALL_EVT_LIST(WMITLV_CMD_EVT_COUNT))
+#define WMITLV_CMD_ATTR_INDEX_SIZE (2 * WMITLV_NUM_CMDS + 1)
+#define WMITLV_EVT_ATTR_INDEX_SIZE (2 * WMITLV_NUM_EVTS + 1)
+
+static A_UINT32 cmd_attr_index[WMITLV_CMD_ATTR_INDEX_SIZE];
+static A_UINT32 evt_attr_index[WMITLV_EVT_ATTR_INDEX_SIZE];
+static bool wmitlv_attr_index_built;
+
+/**
+ * wmitlv_attr_index_insert() - add one attribute list entry to an index
+ * @index: hash index to add to
+ * @index_size: number of slots in @index
+ * @id: command/event id
+ * @offset: offset of the id's entry in the attribute list
+ *
+ * Return: None
+ */
+static void wmitlv_attr_index_insert(A_UINT32 *index, A_UINT32 index_size,
+				     A_UINT32 id, A_UINT32 offset)
+{
+	A_UINT32 slot = id % index_size;
+
+	while (index[slot]) {
+		slot++;
+		if (slot == index_size)
+			slot = 0;
+	}
+	index[slot] = offset + 1;
+}
+
+/**
+ * wmitlv_attr_index_build_list() - index one attribute list
+ * @attr_list: cmd_attr_list or evt_attr_list
+ * @num_entries: number of words in @attr_list
+ * @index: hash index to fill
+ * @index_size: number of slots in @index
+ *
+ * Return: None
+ */
+static void wmitlv_attr_index_build_list(A_UINT32 *attr_list,
+					 A_UINT32 num_entries,
+					 A_UINT32 *index, A_UINT32 index_size)
+{
+	A_UINT32 i;
+
+	for (i = 0; i < num_entries; i++) {
+		wmitlv_attr_index_insert(index, index_size,
+					 WMITLV_GET_CMDID(attr_list[i]), i);
+		i += WMITLV_GET_NUM_TLVS(attr_list[i]);
+	}
+}
+
+/**
+ * wmitlv_build_attr_index() - build the command/event attribute index
+ *
+ * Builds the id to attribute slice index for both the command and event
+ * attribute lists.  The lists are constant, so this is done only once
+ * no matter how many WMI handles are attached.
+ *
+ * Return: None
+ */
+void wmitlv_build_attr_index(void)
+{
+	if (wmitlv_attr_index_built)
+		return;
+
+	wmitlv_attr_index_build_list(cmd_attr_list,
+				     QDF_ARRAY_SIZE(cmd_attr_list),
+				     cmd_attr_index,
+				     QDF_ARRAY_SIZE(cmd_attr_index));
+	wmitlv_attr_index_build_list(evt_attr_list,
+				     QDF_ARRAY_SIZE(evt_attr_list),
+				     evt_attr_index,
+				     QDF_ARRAY_SIZE(evt_attr_index));
+	wmitlv_attr_index_built = true;
+}
+
+/**
+ * wmitlv_find_attr_list_entry() - find a command/event's attribute slice
+ * @attr_list: cmd_attr_list or evt_attr_list
+ * @num_entries: number of words in @attr_list
+ * @index: hash index of @attr_list
+ * @index_size: number of slots in @index
+ * @cmd_event_id: command/event id to look for
+ *
+ * Uses the hash index once it is built, otherwise walks @attr_list.
+ *
+ * Return: offset of the id's entry in @attr_list, or @num_entries if the
+ *	   id has no attribute definitions
+ */
+static A_UINT32 wmitlv_find_attr_list_entry(A_UINT32 *attr_list,
+					    A_UINT32 num_entries,
+					    A_UINT32 *index,
+					    A_UINT32 index_size,
+					    A_UINT32 cmd_event_id)
+{
+	A_UINT32 id = WMITLV_GET_CMDID(cmd_event_id);
+	A_UINT32 slot, i;
+
+	if (wmitlv_attr_index_built) {
+		slot = id % index_size;
+		while (index[slot]) {
+			i = index[slot] - 1;
+			if (WMITLV_GET_CMDID(attr_list[i]) == id)
+				return i;
+			slot++;
+			if (slot == index_size)
+				slot = 0;
+		}
+		return num_entries;
+	}
+
+	for (i = 0; i < num_entries; i++) {
+		if (WMITLV_GET_CMDID(attr_list[i]) == id)
+			return i;
+		i += WMITLV_GET_NUM_TLVS(attr_list[i]);
+	}
+
+	return num_entries;
+}
+
 #ifdef NO_DYNAMIC_MEM_ALLOC
 static wmitlv_cmd_param_info *g_wmi_static_cmd_param_info_buf;
 A_UINT32 g_wmi_static_max_cmd_param_tlvs;
@@ -104,7 +235,8 @@ wmitlv_set_static_param_tlv_buf(void *param_tlv_buf,
  *
  *
  * WMI TLV Helper functions to find the attributes of the
- * Command/Event TLVs.
+ * Command/Event TLVs.  The command/event is located through the
+ * attribute index built by wmitlv_build_attr_index().
  *
  * Return: 0 if success. Return >=1 if failure.
  */
@@ -118,61 +250,65 @@ A_UINT32 wmitlv_get_attributes(A_UINT32 is_cmd_id, A_UINT32 cmd_event_id,
 	if (is_cmd_id) {
 		pAttrArrayList = &cmd_attr_list[0];
 		num_entries = QDF_ARRAY_SIZE(cmd_attr_list);
+		i = wmitlv_find_attr_list_entry(pAttrArrayList, num_entries,
+						cmd_attr_index,
+						QDF_ARRAY_SIZE(cmd_attr_index),
+						cmd_event_id);
 	} else {
 		pAttrArrayList = &evt_attr_list[0];
 		num_entries = QDF_ARRAY_SIZE(evt_attr_list);
+		i = wmitlv_find_attr_list_entry(pAttrArrayList, num_entries,
+						evt_attr_index,
+						QDF_ARRAY_SIZE(evt_attr_index),
+						cmd_event_id);
 	}
 
-	for (i = 0; i < num_entries; i++) {
+	if (i < num_entries) {
 		num_tlvs = WMITLV_GET_NUM_TLVS(pAttrArrayList[i]);
-		if (WMITLV_GET_CMDID(cmd_event_id) ==
-		    WMITLV_GET_CMDID(pAttrArrayList[i])) {
-			tlv_attr_ptr->cmd_num_tlv = num_tlvs;
-			/* Return success from here when only number of TLVS for
-			 * this command/event is required */
-			if (curr_tlv_order == WMITLV_GET_ATTRIB_NUM_TLVS) {
-				wmi_tlv_print_verbose
-					("%s: WMI TLV attribute definitions for %s:0x%x found; num_of_tlvs:%d\n",
-					__func__, (is_cmd_id ? "Cmd" : "Evt"),
-					cmd_event_id, num_tlvs);
-				return 0;
-			}
-
-			/* Return failure if tlv_order is more than the expected
-			 * number of TLVs */
-			if (curr_tlv_order >= num_tlvs) {
-				wmi_tlv_print_error
-					("%s: ERROR: TLV order %d greater than num_of_tlvs:%d for %s:0x%x\n",
-					__func__, curr_tlv_order, num_tlvs,
-					(is_cmd_id ? "Cmd" : "Evt"), cmd_event_id);
-				return 1;
-			}
-
-			base_index = i + 1;     /* index to first TLV attributes */
+		tlv_attr_ptr->cmd_num_tlv = num_tlvs;
+		/* Return success from here when only number of TLVS for
+		 * this command/event is required */
+		if (curr_tlv_order == WMITLV_GET_ATTRIB_NUM_TLVS) {
 			wmi_tlv_print_verbose
-				("%s: WMI TLV attributes for %s:0x%x tlv[%d]:0x%x\n",
+				("%s: WMI TLV attribute definitions for %s:0x%x found; num_of_tlvs:%d\n",
 				__func__, (is_cmd_id ? "Cmd" : "Evt"),
-				cmd_event_id, curr_tlv_order,
-				pAttrArrayList[(base_index + curr_tlv_order)]);
-			tlv_attr_ptr->tag_order = curr_tlv_order;
-			tlv_attr_ptr->tag_id =
-				WMITLV_GET_TAGID(pAttrArrayList
-						 [(base_index + curr_tlv_order)]);
-			tlv_attr_ptr->tag_struct_size =
-				WMITLV_GET_TAG_STRUCT_SIZE(pAttrArrayList
-							   [(base_index +
-							     curr_tlv_order)]);
-			tlv_attr_ptr->tag_varied_size =
-				WMITLV_GET_TAG_VARIED(pAttrArrayList
-						      [(base_index +
-							curr_tlv_order)]);
-			tlv_attr_ptr->tag_array_size =
-				WMITLV_GET_TAG_ARRAY_SIZE(pAttrArrayList
-							  [(base_index +
-							    curr_tlv_order)]);
+				cmd_event_id, num_tlvs);
 			return 0;
 		}
-		i += num_tlvs;
+
+		/* Return failure if tlv_order is more than the expected
+		 * number of TLVs */
+		if (curr_tlv_order >= num_tlvs) {
+			wmi_tlv_print_error
+				("%s: ERROR: TLV order %d greater than num_of_tlvs:%d for %s:0x%x\n",
+				__func__, curr_tlv_order, num_tlvs,
+				(is_cmd_id ? "Cmd" : "Evt"), cmd_event_id);
+			return 1;
+		}
+
+		base_index = i + 1;     /* index to first TLV attributes */
+		wmi_tlv_print_verbose
+			("%s: WMI TLV attributes for %s:0x%x tlv[%d]:0x%x\n",
+			__func__, (is_cmd_id ? "Cmd" : "Evt"),
+			cmd_event_id, curr_tlv_order,
+			pAttrArrayList[(base_index + curr_tlv_order)]);
+		tlv_attr_ptr->tag_order = curr_tlv_order;
+		tlv_attr_ptr->tag_id =
+			WMITLV_GET_TAGID(pAttrArrayList
+					 [(base_index + curr_tlv_order)]);
+		tlv_attr_ptr->tag_struct_size =
+			WMITLV_GET_TAG_STRUCT_SIZE(pAttrArrayList
+						   [(base_index +
+						     curr_tlv_order)]);
+		tlv_attr_ptr->tag_varied_size =
+			WMITLV_GET_TAG_VARIED(pAttrArrayList
+					      [(base_index +
+						curr_tlv_order)]);
+		tlv_attr_ptr->tag_array_size =
+			WMITLV_GET_TAG_ARRAY_SIZE(pAttrArrayList
+						  [(base_index +
+						    curr_tlv_order)]);
+		return 0;
 	}
 
 	wmi_tlv_print_error
@@ -475,6 +611,158 @@ wmitlv_check_command_tlv_params(void *os_handle, void *param_struc_ptr,
 			wmi_cmd_event_id);
 }
 
+#ifndef NO_DYNAMIC_MEM_ALLOC
+/**
+ * wmitlv_arena_init() - allocate the event TLV parsing scratch arena
+ * @arena: arena to initialize
+ *
+ * Sizes the arena to hold the param info array of the event with the
+ * most TLVs, plus WMITLV_ARENA_PAD_SIZE bytes for padding short TLVs.
+ *
+ * Return: 0 if success. Return < 0 if failure.
+ */
+int wmitlv_arena_init(struct wmitlv_arena *arena)
+{
+	A_UINT32 i, num_tlvs, max_num_tlvs = 0;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(evt_attr_list); i++) {
+		num_tlvs = WMITLV_GET_NUM_TLVS(evt_attr_list[i]);
+		if (num_tlvs > max_num_tlvs)
+			max_num_tlvs = num_tlvs;
+		i += num_tlvs;
+	}
+
+	arena->size = roundup(max_num_tlvs * sizeof(wmitlv_cmd_param_info),
+			      sizeof(A_UINT64)) + WMITLV_ARENA_PAD_SIZE;
+	arena->used = 0;
+	qdf_atomic_init(&arena->in_use);
+	qdf_atomic_init(&arena->hits);
+	qdf_atomic_init(&arena->fallbacks);
+	wmi_tlv_os_mem_alloc(NULL, arena->buf, arena->size);
+	if (arena->buf == NULL) {
+		wmi_tlv_print_error
+			("%s: Error: unable to alloc memory (size=%d) for TLV arena\n",
+			__func__, arena->size);
+		arena->size = 0;
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * wmitlv_arena_deinit() - free the event TLV parsing scratch arena
+ * @arena: arena to free
+ *
+ * Return: none
+ */
+void wmitlv_arena_deinit(struct wmitlv_arena *arena)
+{
+	if (arena->buf)
+		wmi_tlv_os_mem_free(arena->buf);
+	arena->buf = NULL;
+	arena->size = 0;
+}
+
+/**
+ * wmitlv_arena_owns() - check if a buffer was carved from an arena
+ * @arena: arena, may be NULL
+ * @ptr: buffer to check
+ *
+ * Return: true if @ptr lies within @arena
+ */
+static inline bool wmitlv_arena_owns(struct wmitlv_arena *arena, void *ptr)
+{
+	if (!arena || !arena->buf)
+		return false;
+
+	return ((A_UINT8 *)ptr >= arena->buf) &&
+		((A_UINT8 *)ptr < arena->buf + arena->size);
+}
+
+/**
+ * wmitlv_arena_get() - take ownership of an arena for one event
+ * @arena: arena, may be NULL
+ *
+ * Events may be parsed from more than one context at a time; only one
+ * of them gets the arena, the others fall back to the heap.
+ *
+ * Return: @arena if it is now owned by the caller, NULL otherwise
+ */
+static struct wmitlv_arena *wmitlv_arena_get(struct wmitlv_arena *arena)
+{
+	if (!arena || !arena->buf)
+		return NULL;
+
+	if (qdf_atomic_inc_return(&arena->in_use) != 1) {
+		qdf_atomic_dec(&arena->in_use);
+		qdf_atomic_inc(&arena->fallbacks);
+		return NULL;
+	}
+
+	return arena;
+}
+
+/**
+ * wmitlv_arena_put() - reset an arena and give up its ownership
+ * @arena: arena owned by the caller
+ *
+ * Return: none
+ */
+static void wmitlv_arena_put(struct wmitlv_arena *arena)
+{
+	arena->used = 0;
+	qdf_atomic_set(&arena->in_use, 0);
+}
+
+/**
+ * wmitlv_tlv_buf_alloc() - allocate a TLV parsing buffer
+ * @os_handle: os context handle
+ * @arena: arena owned by the caller, or NULL to use the heap
+ * @len: number of bytes needed
+ *
+ * Carves @len bytes from @arena when it has room, otherwise allocates
+ * from the heap.
+ *
+ * Return: buffer, or NULL if the heap allocation failed
+ */
+static void *wmitlv_tlv_buf_alloc(void *os_handle, struct wmitlv_arena *arena,
+				  A_UINT32 len)
+{
+	void *ptr = NULL;
+	A_UINT32 aligned_len = roundup(len, sizeof(A_UINT64));
+
+	if (arena) {
+		if (arena->size - arena->used >= aligned_len) {
+			ptr = arena->buf + arena->used;
+			arena->used += aligned_len;
+			qdf_atomic_inc(&arena->hits);
+			return ptr;
+		}
+		qdf_atomic_inc(&arena->fallbacks);
+	}
+
+	wmi_tlv_os_mem_alloc(os_handle, ptr, len);
+	return ptr;
+}
+#else
+int wmitlv_arena_init(struct wmitlv_arena *arena)
+{
+	arena->buf = NULL;
+	arena->size = 0;
+	return 0;
+}
+
+void wmitlv_arena_deinit(struct wmitlv_arena *arena)
+{
+}
+#endif
+
+static void wmitlv_free_allocated_tlvs(A_UINT32 is_cmd_id,
+				       A_UINT32 cmd_event_id,
+				       void **wmi_cmd_struct_ptr,
+				       struct wmitlv_arena *arena);
+
 /**
  * wmitlv_check_and_pad_tlvs() - tlv helper function
  * @os_handle: os context handle
@@ -483,6 +771,7 @@ wmitlv_check_command_tlv_params(void *os_handle, void *param_struc_ptr,
  * @is_cmd_id: boolean for command attribute
  * @wmi_cmd_event_id: command event id
  * @wmi_cmd_struct_ptr: wmi command structure
+ * @arena: scratch arena to carve buffers from, NULL to use the heap
  *
  *
  * vaidate the TLV's coming for an event/command and
@@ -493,7 +782,8 @@ wmitlv_check_command_tlv_params(void *os_handle, void *param_struc_ptr,
 static int
 wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 			  A_UINT32 param_buf_len, A_UINT32 is_cmd_id,
-			  A_UINT32 wmi_cmd_event_id, void **wmi_cmd_struct_ptr)
+			  A_UINT32 wmi_cmd_event_id, void **wmi_cmd_struct_ptr,
+			  struct wmitlv_arena *arena)
 {
 	wmitlv_attributes_struc attr_struct_ptr;
 	A_UINT32 buf_idx = 0;
@@ -521,9 +811,15 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 	len_wmi_cmd_struct_buf =
 		attr_struct_ptr.cmd_num_tlv * sizeof(wmitlv_cmd_param_info);
 #ifndef NO_DYNAMIC_MEM_ALLOC
-	/* Dynamic memory allocation supported */
-	wmi_tlv_os_mem_alloc(os_handle, *wmi_cmd_struct_ptr,
-			     len_wmi_cmd_struct_buf);
+	/* Dynamic memory allocation supported, prefer the scratch arena */
+	arena = wmitlv_arena_get(arena);
+	*wmi_cmd_struct_ptr = wmitlv_tlv_buf_alloc(os_handle, arena,
+						   len_wmi_cmd_struct_buf);
+	if (arena && !wmitlv_arena_owns(arena, *wmi_cmd_struct_ptr)) {
+		/* base structure did not fit, do not hold the arena */
+		wmitlv_arena_put(arena);
+		arena = NULL;
+	}
 #else
 	/* Dynamic memory allocation is not supported. Use the buffer
 	 * g_wmi_static_cmd_param_info_buf, which should be set using
@@ -685,9 +981,9 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 				WMITLV_GET_TLVLEN(WMITLV_GET_HDR(buf_ptr)) +
 				WMI_TLV_HDR_SIZE;
 #ifndef NO_DYNAMIC_MEM_ALLOC
-			wmi_tlv_os_mem_alloc(os_handle, new_tlv_buf,
-					     (num_of_elems *
-					      attr_struct_ptr.tag_struct_size));
+			new_tlv_buf = wmitlv_tlv_buf_alloc(os_handle, arena,
+					(num_of_elems *
+					 attr_struct_ptr.tag_struct_size));
 			if (new_tlv_buf == NULL) {
 				/* Error: unable to alloc memory */
 				wmi_tlv_print_error
@@ -882,8 +1178,8 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 				__func__, tlv_size_diff);
 #ifndef NO_DYNAMIC_MEM_ALLOC
 			/* Dynamic memory allocation is supported */
-			wmi_tlv_os_mem_alloc(os_handle, new_tlv_buf,
-					     (curr_tlv_len - tlv_size_diff));
+			new_tlv_buf = wmitlv_tlv_buf_alloc(os_handle, arena,
+					(curr_tlv_len - tlv_size_diff));
 			if (new_tlv_buf == NULL) {
 				/* Error: unable to alloc memory */
 				wmi_tlv_print_error
@@ -938,13 +1234,8 @@ wmitlv_check_and_pad_tlvs(void *os_handle, void *param_struc_ptr,
 
 	return 0;
 Error_wmitlv_check_and_pad_tlvs:
-	if (is_cmd_id) {
-		wmitlv_free_allocated_command_tlvs(wmi_cmd_event_id,
-						   wmi_cmd_struct_ptr);
-	} else {
-		wmitlv_free_allocated_event_tlvs(wmi_cmd_event_id,
-						 wmi_cmd_struct_ptr);
-	}
+	wmitlv_free_allocated_tlvs(is_cmd_id, wmi_cmd_event_id,
+				   wmi_cmd_struct_ptr, arena);
 	*wmi_cmd_struct_ptr = NULL;
 	return error;
 }
@@ -971,7 +1262,37 @@ wmitlv_check_and_pad_event_tlvs(void *os_handle, void *param_struc_ptr,
 	A_UINT32 is_cmd_id = 0;
 	return wmitlv_check_and_pad_tlvs
 			(os_handle, param_struc_ptr, param_buf_len, is_cmd_id,
-			wmi_cmd_event_id, wmi_cmd_struct_ptr);
+			wmi_cmd_event_id, wmi_cmd_struct_ptr, NULL);
+}
+
+/**
+ * wmitlv_check_and_pad_event_tlvs_arena() - tlv helper function
+ * @os_handle: os context handle
+ * @param_struc_ptr: pointer to tlv structure
+ * @param_buf_len: length of tlv parameter
+ * @wmi_cmd_event_id: command event id
+ * @arena: scratch arena of the wmi handle the event arrived on
+ * @wmi_cmd_struct_ptr: wmi command structure
+ *
+ *
+ * validate and pad(if necessary) for incoming WMI Event TLVs, carving
+ * the param structure and padded TLVs from @arena instead of the heap
+ * when the arena is free and has room.  Must be paired with
+ * wmitlv_free_allocated_event_tlvs_arena().
+ *
+ * Return: 0 if success. Return < 0 if failure.
+ */
+int
+wmitlv_check_and_pad_event_tlvs_arena(void *os_handle, void *param_struc_ptr,
+				      A_UINT32 param_buf_len,
+				      A_UINT32 wmi_cmd_event_id,
+				      struct wmitlv_arena *arena,
+				      void **wmi_cmd_struct_ptr)
+{
+	A_UINT32 is_cmd_id = 0;
+	return wmitlv_check_and_pad_tlvs
+			(os_handle, param_struc_ptr, param_buf_len, is_cmd_id,
+			wmi_cmd_event_id, wmi_cmd_struct_ptr, arena);
 }
 
 /**
@@ -996,7 +1317,7 @@ wmitlv_check_and_pad_command_tlvs(void *os_handle, void *param_struc_ptr,
 	A_UINT32 is_cmd_id = 1;
 	return wmitlv_check_and_pad_tlvs
 			(os_handle, param_struc_ptr, param_buf_len, is_cmd_id,
-			wmi_cmd_event_id, wmi_cmd_struct_ptr);
+			wmi_cmd_event_id, wmi_cmd_struct_ptr, NULL);
 }
 
 /**
@@ -1004,15 +1325,18 @@ wmitlv_check_and_pad_command_tlvs(void *os_handle, void *param_struc_ptr,
  * @is_cmd_id: bollean to check if cmd or event tlv
  * @cmd_event_id: command or event id
  * @wmi_cmd_struct_ptr: wmi command structure
+ * @arena: scratch arena the buffers may have been carved from, or NULL
  *
  *
- * free any allocated buffers for WMI Event/Command TLV processing
+ * free any allocated buffers for WMI Event/Command TLV processing.
+ * Buffers carved from @arena are not freed; the arena is reset instead.
  *
  * Return: none
  */
 static void wmitlv_free_allocated_tlvs(A_UINT32 is_cmd_id,
 				       A_UINT32 cmd_event_id,
-				       void **wmi_cmd_struct_ptr)
+				       void **wmi_cmd_struct_ptr,
+				       struct wmitlv_arena *arena)
 {
 	void *ptr = *wmi_cmd_struct_ptr;
 
@@ -1026,7 +1350,8 @@ static void wmitlv_free_allocated_tlvs(A_UINT32 is_cmd_id,
 /* macro to free that previously allocated memory for this TLV. When (op==FREE_TLV_ELEM). */
 #define WMITLV_OP_FREE_TLV_ELEM_macro(param_ptr, param_len, wmi_cmd_event_id, elem_tlv_tag, elem_struc_type, elem_name, var_len, arr_size)  \
 	if ((((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->WMITLV_FIELD_BUF_IS_ALLOCATED(elem_name)) &&	\
-	    (((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->elem_name != NULL)) \
+	    (((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->elem_name != NULL) && \
+	    !wmitlv_arena_owns(arena, ((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->elem_name)) \
 	{ \
 		wmi_tlv_os_mem_free(((WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(wmi_cmd_event_id) *)ptr)->elem_name); \
 	}
@@ -1056,7 +1381,10 @@ break;
 		}
 	}
 
-	wmi_tlv_os_mem_free(*wmi_cmd_struct_ptr);
+	if (wmitlv_arena_owns(arena, *wmi_cmd_struct_ptr))
+		wmitlv_arena_put(arena);
+	else
+		wmi_tlv_os_mem_free(*wmi_cmd_struct_ptr);
 	*wmi_cmd_struct_ptr = NULL;
 #endif
 
@@ -1076,7 +1404,7 @@ break;
 void wmitlv_free_allocated_command_tlvs(A_UINT32 cmd_event_id,
 					void **wmi_cmd_struct_ptr)
 {
-	wmitlv_free_allocated_tlvs(1, cmd_event_id, wmi_cmd_struct_ptr);
+	wmitlv_free_allocated_tlvs(1, cmd_event_id, wmi_cmd_struct_ptr, NULL);
 }
 
 /**
@@ -1092,7 +1420,26 @@ void wmitlv_free_allocated_command_tlvs(A_UINT32 cmd_event_id,
 void wmitlv_free_allocated_event_tlvs(A_UINT32 cmd_event_id,
 				      void **wmi_cmd_struct_ptr)
 {
-	wmitlv_free_allocated_tlvs(0, cmd_event_id, wmi_cmd_struct_ptr);
+	wmitlv_free_allocated_tlvs(0, cmd_event_id, wmi_cmd_struct_ptr, NULL);
+}
+
+/**
+ * wmitlv_free_allocated_event_tlvs_arena() - tlv helper function
+ * @cmd_event_id: command or event id
+ * @arena: scratch arena passed to wmitlv_check_and_pad_event_tlvs_arena()
+ * @wmi_cmd_struct_ptr: wmi command structure
+ *
+ *
+ * free any heap buffers for WMI Event TLV processing and reset the
+ * scratch arena if the event was parsed into it
+ *
+ * Return: none
+ */
+void wmitlv_free_allocated_event_tlvs_arena(A_UINT32 cmd_event_id,
+					    struct wmitlv_arena *arena,
+					    void **wmi_cmd_struct_ptr)
+{
+	wmitlv_free_allocated_tlvs(0, cmd_event_id, wmi_cmd_struct_ptr, arena);
 }
 
 /**
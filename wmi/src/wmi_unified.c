@@ -39,6 +39,7 @@
 #include "dbglog_host.h"
 #include "wmi_unified_priv.h"
 #include "wmi_unified_param.h"
+#include "wmi_unified_api.h"
 
 #include <linux/debugfs.h>
 
@@ -137,17 +138,21 @@ struct wmi_event_debug wmi_event_log_buffer[WMI_EVENT_DEBUG_MAX_ENTRY];
 uint32_t g_wmi_rx_event_buf_idx = 0;
 struct wmi_event_debug wmi_rx_event_log_buffer[WMI_EVENT_DEBUG_MAX_ENTRY];
 
-#define WMI_COMMAND_RECORD(h, a, b) {					\
+#ifndef WMI_LOG_PERCPU
+#define WMI_LOG_LOCK(h) qdf_spin_lock_bh(&(h)->log_info.wmi_record_lock)
+#define WMI_LOG_UNLOCK(h) qdf_spin_unlock_bh(&(h)->log_info.wmi_record_lock)
+
+#define WMI_COMMAND_RECORD(h, a, b, c) {				\
 	if (wmi_log_max_entry <=					\
 		*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx))	\
 		*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx) = 0;\
 	((struct wmi_command_debug *)h->log_info.wmi_command_log_buf_info.buf)\
 		[*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx)]\
 						.command = a;		\
-	qdf_mem_copy(((struct wmi_command_debug *)h->log_info.		\
+	wmi_log_record_data(((struct wmi_command_debug *)h->log_info.	\
 				wmi_command_log_buf_info.buf)		\
 		[*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx)].data,\
-			b, wmi_record_max_length);			\
+			b, c);						\
 	((struct wmi_command_debug *)h->log_info.wmi_command_log_buf_info.buf)\
 		[*(h->log_info.wmi_command_log_buf_info.p_buf_tail_idx)].\
 		time = qdf_get_log_timestamp();			\
@@ -155,7 +160,7 @@ struct wmi_event_debug wmi_rx_event_log_buffer[WMI_EVENT_DEBUG_MAX_ENTRY];
 	h->log_info.wmi_command_log_buf_info.length++;			\
 }
 
-#define WMI_COMMAND_TX_CMP_RECORD(h, a, b) {				\
+#define WMI_COMMAND_TX_CMP_RECORD(h, a, b, c) {				\
 	if (wmi_log_max_entry <=					\
 		*(h->log_info.wmi_command_tx_cmp_log_buf_info.p_buf_tail_idx))\
 		*(h->log_info.wmi_command_tx_cmp_log_buf_info.p_buf_tail_idx) = 0;\
@@ -164,11 +169,11 @@ struct wmi_event_debug wmi_rx_event_log_buffer[WMI_EVENT_DEBUG_MAX_ENTRY];
 		[*(h->log_info.wmi_command_tx_cmp_log_buf_info.		\
 				p_buf_tail_idx)].			\
 							command	= a;	\
-	qdf_mem_copy(((struct wmi_command_debug *)h->log_info.		\
+	wmi_log_record_data(((struct wmi_command_debug *)h->log_info.	\
 				wmi_command_tx_cmp_log_buf_info.buf)	\
 		[*(h->log_info.wmi_command_tx_cmp_log_buf_info.		\
 			p_buf_tail_idx)].				\
-		data, b, wmi_record_max_length);			\
+		data, b, c);						\
 	((struct wmi_command_debug *)h->log_info.			\
 		wmi_command_tx_cmp_log_buf_info.buf)			\
 		[*(h->log_info.wmi_command_tx_cmp_log_buf_info.		\
@@ -178,17 +183,17 @@ struct wmi_event_debug wmi_rx_event_log_buffer[WMI_EVENT_DEBUG_MAX_ENTRY];
 	h->log_info.wmi_command_tx_cmp_log_buf_info.length++;		\
 }
 
-#define WMI_EVENT_RECORD(h, a, b) {					\
+#define WMI_EVENT_RECORD(h, a, b, c) {					\
 	if (wmi_log_max_entry <=					\
 		*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx))	\
 		*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx) = 0;\
 	((struct wmi_event_debug *)h->log_info.wmi_event_log_buf_info.buf)\
 		[*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx)].	\
 		event = a;						\
-	qdf_mem_copy(((struct wmi_event_debug *)h->log_info.		\
+	wmi_log_record_data(((struct wmi_event_debug *)h->log_info.	\
 				wmi_event_log_buf_info.buf)		\
 		[*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx)].data, b,\
-		wmi_record_max_length);					\
+		c);							\
 	((struct wmi_event_debug *)h->log_info.wmi_event_log_buf_info.buf)\
 		[*(h->log_info.wmi_event_log_buf_info.p_buf_tail_idx)].time =\
 		qdf_get_log_timestamp();				\
@@ -196,23 +201,24 @@ struct wmi_event_debug wmi_rx_event_log_buffer[WMI_EVENT_DEBUG_MAX_ENTRY];
 	h->log_info.wmi_event_log_buf_info.length++;			\
 }
 
-#define WMI_RX_EVENT_RECORD(h, a, b) {					\
+#define WMI_RX_EVENT_RECORD(h, a, b, c) {				\
 	if (wmi_log_max_entry <=					\
 		*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx))\
 		*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx) = 0;\
 	((struct wmi_event_debug *)h->log_info.wmi_rx_event_log_buf_info.buf)\
 		[*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx)].\
 		event = a;						\
-	qdf_mem_copy(((struct wmi_event_debug *)h->log_info.		\
+	wmi_log_record_data(((struct wmi_event_debug *)h->log_info.	\
 				wmi_rx_event_log_buf_info.buf)		\
 		[*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx)].\
-			data, b, wmi_record_max_length);		\
+			data, b, c);					\
 	((struct wmi_event_debug *)h->log_info.wmi_rx_event_log_buf_info.buf)\
 		[*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx)].\
 		time =	qdf_get_log_timestamp();			\
 	(*(h->log_info.wmi_rx_event_log_buf_info.p_buf_tail_idx))++;	\
 	h->log_info.wmi_rx_event_log_buf_info.length++;			\
 }
+#endif
 
 uint32_t g_wmi_mgmt_command_buf_idx = 0;
 struct
@@ -228,7 +234,8 @@ uint32_t g_wmi_mgmt_event_buf_idx = 0;
 struct wmi_event_debug
 wmi_mgmt_event_log_buffer[WMI_MGMT_EVENT_DEBUG_MAX_ENTRY];
 
-#define WMI_MGMT_COMMAND_RECORD(a, b, c, d, e) {			     \
+#ifndef WMI_LOG_PERCPU
+#define WMI_MGMT_COMMAND_RECORD(h, a, b, c, d, e) {			     \
 	if (WMI_MGMT_EVENT_DEBUG_MAX_ENTRY <=				     \
 		g_wmi_mgmt_command_buf_idx)				     \
 		g_wmi_mgmt_command_buf_idx = 0;				     \
@@ -242,7 +249,7 @@ wmi_mgmt_event_log_buffer[WMI_MGMT_EVENT_DEBUG_MAX_ENTRY];
 	g_wmi_mgmt_command_buf_idx++;					     \
 }
 
-#define WMI_MGMT_COMMAND_TX_CMP_RECORD(h, a, b) {			\
+#define WMI_MGMT_COMMAND_TX_CMP_RECORD(h, a, b, c) {			\
 	if (wmi_mgmt_log_max_entry <=					\
 		*(h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.	\
 			p_buf_tail_idx))				\
@@ -252,11 +259,11 @@ wmi_mgmt_event_log_buffer[WMI_MGMT_EVENT_DEBUG_MAX_ENTRY];
 			wmi_mgmt_command_tx_cmp_log_buf_info.buf)	\
 		[*(h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.	\
 				p_buf_tail_idx)].command = a;		\
-	qdf_mem_copy(((struct wmi_command_debug *)h->log_info.		\
+	wmi_log_record_data(((struct wmi_command_debug *)h->log_info.	\
 				wmi_mgmt_command_tx_cmp_log_buf_info.buf)\
 		[*(h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.	\
 			p_buf_tail_idx)].data, b,			\
-			wmi_record_max_length);				\
+			c);						\
 	((struct wmi_command_debug *)h->log_info.			\
 			wmi_mgmt_command_tx_cmp_log_buf_info.buf)	\
 		[*(h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.	\
@@ -267,23 +274,103 @@ wmi_mgmt_event_log_buffer[WMI_MGMT_EVENT_DEBUG_MAX_ENTRY];
 	h->log_info.wmi_mgmt_command_tx_cmp_log_buf_info.length++;	\
 }
 
-#define WMI_MGMT_EVENT_RECORD(h, a, b) {				\
+#define WMI_MGMT_EVENT_RECORD(h, a, b, c) {				\
 	if (wmi_mgmt_log_max_entry <=					\
 		*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx))\
 		*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx) = 0;\
 	((struct wmi_event_debug *)h->log_info.wmi_mgmt_event_log_buf_info.buf)\
 		[*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx)]\
 					.event = a;			\
-	qdf_mem_copy(((struct wmi_event_debug *)h->log_info.		\
+	wmi_log_record_data(((struct wmi_event_debug *)h->log_info.	\
 				wmi_mgmt_event_log_buf_info.buf)	\
 		[*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx)].\
-			data, b, wmi_record_max_length);		\
+			data, b, c);					\
 	((struct wmi_event_debug *)h->log_info.wmi_mgmt_event_log_buf_info.buf)\
 		[*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx)].\
 			time = qdf_get_log_timestamp();			\
 	(*(h->log_info.wmi_mgmt_event_log_buf_info.p_buf_tail_idx))++;	\
 	h->log_info.wmi_mgmt_event_log_buf_info.length++;		\
 }
+#else
+/* records go to the ring of the local CPU, no lock is taken */
+#define WMI_LOG_LOCK(h)
+#define WMI_LOG_UNLOCK(h)
+
+/**
+ * wmi_log_percpu_record() - add a record to a per-CPU WMI log
+ * @log: log to add to
+ * @id: WMI command or event id
+ * @data: payload to keep
+ * @len: bytes available at @data
+ *
+ * Only the local CPU writes its ring, with bottom halves disabled so a
+ * softirq cannot interleave. The sequence number is cleared while the
+ * record is written so readers can tell a torn record.
+ *
+ * Return: none
+ */
+static void wmi_log_percpu_record(struct wmi_log_buf_t *log, uint32_t id,
+				  const void *data, uint32_t len)
+{
+	struct wmi_log_percpu_ring *ring;
+	struct wmi_log_percpu_entry *entry;
+	uint32_t seq;
+
+	local_bh_disable();
+	ring = this_cpu_ptr(log->percpu);
+	seq = ring->seq + 1;
+	if (!seq)
+		seq = 1;
+	entry = &ring->entry[seq & (WMI_LOG_PERCPU_RING_SIZE - 1)];
+
+	entry->seq = 0;
+	smp_wmb();
+	entry->id = id;
+	entry->time = qdf_get_log_timestamp();
+	len = QDF_MIN(len, (uint32_t)sizeof(entry->data));
+	qdf_mem_copy(entry->data, data, len);
+	if (len < sizeof(entry->data))
+		qdf_mem_zero((uint8_t *)entry->data + len,
+			     sizeof(entry->data) - len);
+	smp_wmb();
+	entry->seq = seq;
+	ring->seq = seq;
+	local_bh_enable();
+}
+
+#define WMI_COMMAND_RECORD(h, a, b, c)					\
+	wmi_log_percpu_record(&(h)->log_info.wmi_command_log_buf_info,	\
+			      a, b, c)
+
+#define WMI_COMMAND_TX_CMP_RECORD(h, a, b, c)				\
+	wmi_log_percpu_record(						\
+		&(h)->log_info.wmi_command_tx_cmp_log_buf_info,		\
+		a, b, c)
+
+#define WMI_EVENT_RECORD(h, a, b, c)					\
+	wmi_log_percpu_record(&(h)->log_info.wmi_event_log_buf_info,	\
+			      a, b, c)
+
+#define WMI_RX_EVENT_RECORD(h, a, b, c)					\
+	wmi_log_percpu_record(&(h)->log_info.wmi_rx_event_log_buf_info,	\
+			      a, b, c)
+
+#define WMI_MGMT_COMMAND_RECORD(h, a, b, c, d, e) {			\
+	uint32_t mgmt_data[4] = {b, c, d, e};				\
+									\
+	wmi_log_percpu_record(&(h)->log_info.wmi_mgmt_command_log_buf_info,\
+			      a, mgmt_data, sizeof(mgmt_data));		\
+}
+
+#define WMI_MGMT_COMMAND_TX_CMP_RECORD(h, a, b, c)			\
+	wmi_log_percpu_record(						\
+		&(h)->log_info.wmi_mgmt_command_tx_cmp_log_buf_info,	\
+		a, b, c)
+
+#define WMI_MGMT_EVENT_RECORD(h, a, b, c)				\
+	wmi_log_percpu_record(&(h)->log_info.wmi_mgmt_event_log_buf_info,\
+			      a, b, c)
+#endif
 
 /* These are defined to made it as module param, which can be configured */
 uint32_t wmi_log_max_entry = WMI_EVENT_DEBUG_MAX_ENTRY;
@@ -291,6 +378,43 @@ uint32_t wmi_mgmt_log_max_entry = WMI_MGMT_EVENT_DEBUG_MAX_ENTRY;
 uint32_t wmi_record_max_length = WMI_EVENT_DEBUG_ENTRY_MAX_LENGTH;
 uint32_t wmi_display_size = 100;
 
+/**
+ * wmi_log_data_len() - bytes of a WMI buffer a log record may copy
+ * @buf_len: length of the buffer
+ * @offset: offset of the logged payload in the buffer, in bytes
+ *
+ * Return: bytes from @offset to the end of the buffer, 0 if none
+ */
+static inline uint32_t wmi_log_data_len(uint32_t buf_len, uint32_t offset)
+{
+	return buf_len > offset ? buf_len - offset : 0;
+}
+
+#ifndef WMI_LOG_PERCPU
+/**
+ * wmi_log_record_data() - fill the payload of a log record
+ * @data: payload of the record
+ * @src: start of the logged payload
+ * @len: bytes available at @src
+ *
+ * Copies at most wmi_record_max_length bytes and zeroes the rest, so a
+ * short buffer is never read past its end.
+ *
+ * Return: none
+ */
+static inline void wmi_log_record_data(uint32_t *data, const void *src,
+				       uint32_t len)
+{
+	uint32_t max = QDF_MIN(wmi_record_max_length,
+			       (uint32_t)WMI_EVENT_DEBUG_ENTRY_MAX_LENGTH);
+
+	len = QDF_MIN(len, max);
+	qdf_mem_copy(data, src, len);
+	if (len < max)
+		qdf_mem_zero((uint8_t *)data + len, max - len);
+}
+#endif
+
 static uint8_t *wmi_id_to_name(uint32_t wmi_command);
 
 /**
@@ -299,7 +423,38 @@ static uint8_t *wmi_id_to_name(uint32_t wmi_command);
  *
  * Return: Initialization status
  */
-#ifdef CONFIG_MCL
+#if defined(WMI_LOG_PERCPU)
+static QDF_STATUS wmi_log_init(struct wmi_unified *wmi_handle)
+{
+	struct wmi_log_buf_t *logs[] = {
+		&wmi_handle->log_info.wmi_command_log_buf_info,
+		&wmi_handle->log_info.wmi_command_tx_cmp_log_buf_info,
+		&wmi_handle->log_info.wmi_event_log_buf_info,
+		&wmi_handle->log_info.wmi_rx_event_log_buf_info,
+		&wmi_handle->log_info.wmi_mgmt_command_log_buf_info,
+		&wmi_handle->log_info.wmi_mgmt_command_tx_cmp_log_buf_info,
+		&wmi_handle->log_info.wmi_mgmt_event_log_buf_info,
+	};
+	int i;
+
+	wmi_handle->log_info.wmi_logging_enable = 0;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(logs); i++) {
+		logs[i]->length = 0;
+		logs[i]->clear_time = 0;
+		logs[i]->percpu = alloc_percpu(struct wmi_log_percpu_ring);
+		if (!logs[i]->percpu) {
+			qdf_print("no memory for WMI per-CPU log buffer..\n");
+			return QDF_STATUS_E_NOMEM;
+		}
+	}
+
+	qdf_spinlock_create(&wmi_handle->log_info.wmi_record_lock);
+	wmi_handle->log_info.wmi_logging_enable = 1;
+
+	return QDF_STATUS_SUCCESS;
+}
+#elif defined(CONFIG_MCL)
 static QDF_STATUS wmi_log_init(struct wmi_unified *wmi_handle)
 {
 	struct wmi_log_buf_t *cmd_log_buf =
@@ -494,7 +649,30 @@ static QDF_STATUS wmi_log_init(struct wmi_unified *wmi_handle)
  *
  * Return: None
  */
-#ifndef CONFIG_MCL
+#if defined(WMI_LOG_PERCPU)
+static inline void wmi_log_buffer_free(struct wmi_unified *wmi_handle)
+{
+	struct wmi_log_buf_t *logs[] = {
+		&wmi_handle->log_info.wmi_command_log_buf_info,
+		&wmi_handle->log_info.wmi_command_tx_cmp_log_buf_info,
+		&wmi_handle->log_info.wmi_event_log_buf_info,
+		&wmi_handle->log_info.wmi_rx_event_log_buf_info,
+		&wmi_handle->log_info.wmi_mgmt_command_log_buf_info,
+		&wmi_handle->log_info.wmi_mgmt_command_tx_cmp_log_buf_info,
+		&wmi_handle->log_info.wmi_mgmt_event_log_buf_info,
+	};
+	int i;
+
+	wmi_handle->log_info.wmi_logging_enable = 0;
+	for (i = 0; i < QDF_ARRAY_SIZE(logs); i++) {
+		if (logs[i]->percpu) {
+			free_percpu(logs[i]->percpu);
+			logs[i]->percpu = NULL;
+		}
+	}
+	qdf_spinlock_destroy(&wmi_handle->log_info.wmi_record_lock);
+}
+#elif !defined(CONFIG_MCL)
 static inline void wmi_log_buffer_free(struct wmi_unified *wmi_handle)
 {
 	if (wmi_handle->log_info.wmi_command_log_buf_info.buf)
@@ -534,6 +712,123 @@ const int8_t * const debugfs_dir[] = {"WMI0"};
 
 /* debugfs routines*/
 
+#ifdef WMI_LOG_PERCPU
+/**
+ * wmi_log_percpu_fetch() - copy a record out of a per-CPU ring
+ * @log: log to read
+ * @cpu: CPU whose ring is read
+ * @rec: record to fill, @rec->seq holds the sequence number wanted
+ *
+ * @rec->seq is set to 0 when the record is gone, is being rewritten or
+ * was cleared, which ends the walk over that CPU's ring.
+ *
+ * Return: none
+ */
+static void wmi_log_percpu_fetch(struct wmi_log_buf_t *log, int cpu,
+				 struct wmi_log_percpu_entry *rec)
+{
+	struct wmi_log_percpu_ring *ring = per_cpu_ptr(log->percpu, cpu);
+	struct wmi_log_percpu_entry *entry;
+	uint32_t seq = rec->seq;
+
+	if (!seq || ring->seq - seq >= WMI_LOG_PERCPU_RING_SIZE)
+		goto gone;
+
+	entry = &ring->entry[seq & (WMI_LOG_PERCPU_RING_SIZE - 1)];
+	if (entry->seq != seq)
+		goto gone;
+	smp_rmb();
+	qdf_mem_copy(rec, entry, sizeof(*rec));
+	smp_rmb();
+	if (entry->seq != seq || rec->time <= log->clear_time)
+		goto gone;
+
+	rec->seq = seq;
+	return;
+
+gone:
+	rec->seq = 0;
+}
+
+/**
+ * wmi_log_percpu_show() - print a per-CPU WMI log, newest record first
+ * @m: debugfs handler
+ * @log: log to print
+ * @id_str: label of the command or event id
+ *
+ * The rings of all CPUs are merged by record timestamp.
+ *
+ * Return: Length of characters printed
+ */
+static int wmi_log_percpu_show(struct seq_file *m, struct wmi_log_buf_t *log,
+			       const char *id_str)
+{
+	struct wmi_log_percpu_entry *rec;
+	int cpu, newest, nread, outlen, i;
+	uint32_t shown = 0;
+
+	rec = qdf_mem_malloc(nr_cpu_ids * sizeof(*rec));
+	if (!rec)
+		return seq_printf(m, "no memory to read ring buffer!\n");
+
+	for_each_possible_cpu(cpu) {
+		rec[cpu].seq = per_cpu_ptr(log->percpu, cpu)->seq;
+		wmi_log_percpu_fetch(log, cpu, &rec[cpu]);
+	}
+
+	outlen = 0;
+	nread = wmi_display_size;
+	while (nread--) {
+		newest = -1;
+		for_each_possible_cpu(cpu) {
+			if (rec[cpu].seq && (newest < 0 ||
+			    rec[cpu].time > rec[newest].time))
+				newest = cpu;
+		}
+		if (newest < 0)
+			break;
+
+		outlen += seq_printf(m, "%s = %x\n", id_str,
+				     rec[newest].id);
+		outlen += seq_printf(m, "CMD = ");
+		for (i = 0; i < QDF_ARRAY_SIZE(rec[newest].data); i++)
+			outlen += seq_printf(m, "%x ", rec[newest].data[i]);
+		outlen += seq_printf(m, "\n");
+		shown++;
+
+		rec[newest].seq--;
+		wmi_log_percpu_fetch(log, newest, &rec[newest]);
+	}
+	qdf_mem_free(rec);
+
+	if (!shown)
+		return seq_printf(m, "no elements to read from ring buffer!\n");
+
+	outlen += seq_printf(m, "Length = %u\n", shown);
+
+	return outlen;
+}
+
+#define GENERATE_COMMAND_DEBUG_SHOW_FUNCS(func_base, wmi_ring_size)	\
+	static int debug_wmi_##func_base##_show(struct seq_file *m,	\
+						void *v)		\
+	{								\
+		wmi_unified_t wmi_handle = (wmi_unified_t) m->private;	\
+									\
+		return wmi_log_percpu_show(m, &wmi_handle->log_info.	\
+				wmi_##func_base##_buf_info, "CMD ID");	\
+	}
+
+#define GENERATE_EVENT_DEBUG_SHOW_FUNCS(func_base, wmi_ring_size)	\
+	static int debug_wmi_##func_base##_show(struct seq_file *m,	\
+						void *v)		\
+	{								\
+		wmi_unified_t wmi_handle = (wmi_unified_t) m->private;	\
+									\
+		return wmi_log_percpu_show(m, &wmi_handle->log_info.	\
+				wmi_##func_base##_buf_info, "Event ID");\
+	}
+#else
 /**
  * debug_wmi_##func_base##_show() - debugfs functions to display content of
  * command and event buffers. Macro uses max buffer length to display
@@ -647,6 +942,7 @@ const int8_t * const debugfs_dir[] = {"WMI0"};
 									\
 		return outlen;						\
 	}
+#endif
 
 GENERATE_COMMAND_DEBUG_SHOW_FUNCS(command_log, wmi_display_size);
 GENERATE_COMMAND_DEBUG_SHOW_FUNCS(command_tx_cmp_log, wmi_display_size);
@@ -686,11 +982,54 @@ static int debug_wmi_enable_show(struct seq_file *m, void *v)
 static int debug_wmi_log_size_show(struct seq_file *m, void *v)
 {
 
+#ifdef WMI_LOG_PERCPU
+	seq_printf(m, "WMI command/event log per-CPU size:%d\n",
+		   WMI_LOG_PERCPU_RING_SIZE);
+	return seq_printf(m, "WMI record payload size:%d\n",
+			  WMI_EVENT_DEBUG_ENTRY_MAX_LENGTH);
+#endif
 	seq_printf(m, "WMI command/event log max size:%d\n", wmi_log_max_entry);
 	return seq_printf(m, "WMI management command/events log max size:%d\n",
 				wmi_mgmt_log_max_entry);
 }
 
+/**
+ * debug_wmi_stats_show() - debugfs functions to display wmi internal
+ * statistics.
+ *
+ * @m: debugfs handler to access wmi_handle
+ * @v: Variable arguments (not used)
+ *
+ * Return: Length of characters printed
+ */
+static int debug_wmi_stats_show(struct seq_file *m, void *v)
+{
+	wmi_unified_t wmi_handle = (wmi_unified_t) m->private;
+	struct wmi_rx_queue *rxq;
+	int outlen = 0;
+	int i;
+
+	outlen += seq_printf(m, "TLV arena size:%u hits:%d fallbacks:%d\n",
+			     wmi_handle->tlv_arena.size,
+			     qdf_atomic_read(&wmi_handle->tlv_arena.hits),
+			     qdf_atomic_read(&wmi_handle->tlv_arena.fallbacks));
+
+	for (i = 0; i < WMI_RX_QUEUE_NUM; i++) {
+		rxq = &wmi_handle->rx_queue[i];
+		qdf_spin_lock_bh(&rxq->lock);
+		outlen += seq_printf(m, "RX queue %d%s depth:%u max_depth:%u processed:%u latency samples:%u total_us:%llu max_us:%llu\n",
+				     i, i == WMI_RX_QUEUE_HIGH_PRI ?
+				     " (high pri)" : "",
+				     rxq->depth, rxq->max_depth, rxq->processed,
+				     rxq->latency_samples,
+				     rxq->total_latency_us,
+				     rxq->max_latency_us);
+		qdf_spin_unlock_bh(&rxq->lock);
+	}
+
+	return outlen;
+}
+
 /**
  * debug_wmi_##func_base##_write() - debugfs functions to clear
  * wmi logging command/event buffer and management command/event buffer.
@@ -702,6 +1041,29 @@ static int debug_wmi_log_size_show(struct seq_file *m, void *v)
  *
  * Return: count
  */
+#ifdef WMI_LOG_PERCPU
+/* per-CPU rings are not touched, records older than now are hidden */
+#define GENERATE_DEBUG_WRITE_FUNCS(func_base, wmi_ring_size, wmi_record_type)\
+	static ssize_t debug_wmi_##func_base##_write(struct file *file,	\
+				const char __user *buf,			\
+				size_t count, loff_t *ppos)		\
+	{								\
+		int k, ret;						\
+		wmi_unified_t wmi_handle = file->private_data;		\
+		struct wmi_log_buf_t *wmi_log = &wmi_handle->log_info.	\
+				wmi_##func_base##_buf_info;		\
+									\
+		ret = sscanf(buf, "%d", &k);				\
+		if ((ret != 1) || (k != 0)) {				\
+			qdf_print("Wrong input, echo 0 to clear the wmi	buffer\n");\
+			return -EINVAL;					\
+		}							\
+									\
+		wmi_log->clear_time = qdf_get_log_timestamp();		\
+									\
+		return count;						\
+	}
+#else
 #define GENERATE_DEBUG_WRITE_FUNCS(func_base, wmi_ring_size, wmi_record_type)\
 	static ssize_t debug_wmi_##func_base##_write(struct file *file,	\
 				const char __user *buf,			\
@@ -727,6 +1089,7 @@ static int debug_wmi_log_size_show(struct seq_file *m, void *v)
 									\
 		return count;						\
 	}
+#endif
 
 GENERATE_DEBUG_WRITE_FUNCS(command_log, wmi_log_max_entry,
 					wmi_command_debug);
@@ -784,6 +1147,19 @@ static ssize_t debug_wmi_log_size_write(struct file *file,
 	return -EINVAL;
 }
 
+/**
+ * debug_wmi_stats_write() - wmi statistics are read only
+ *
+ * @file: file handler to access wmi_handle
+ * @buf: received data buffer
+ * @count: length of received buffer
+ */
+static ssize_t debug_wmi_stats_write(struct file *file,
+		const char __user *buf, size_t count, loff_t *ppos)
+{
+	return -EINVAL;
+}
+
 /* Structure to maintain debug information */
 struct wmi_debugfs_info {
 	const char *name;
@@ -829,6 +1205,7 @@ GENERATE_DEBUG_STRUCTS(wmi_mgmt_command_tx_cmp_log);
 GENERATE_DEBUG_STRUCTS(wmi_mgmt_event_log);
 GENERATE_DEBUG_STRUCTS(wmi_enable);
 GENERATE_DEBUG_STRUCTS(wmi_log_size);
+GENERATE_DEBUG_STRUCTS(wmi_stats);
 
 struct wmi_debugfs_info wmi_debugfs_infos[] = {
 	DEBUG_FOO(wmi_command_log),
@@ -840,6 +1217,7 @@ struct wmi_debugfs_info wmi_debugfs_infos[] = {
 	DEBUG_FOO(wmi_mgmt_event_log),
 	DEBUG_FOO(wmi_enable),
 	DEBUG_FOO(wmi_log_size),
+	DEBUG_FOO(wmi_stats),
 };
 
 #define NUM_DEBUG_INFOS (sizeof(wmi_debugfs_infos) /			\
@@ -951,14 +1329,14 @@ static QDF_STATUS wmi_debugfs_init(wmi_unified_t wmi_handle)
 void wmi_mgmt_cmd_record(wmi_unified_t wmi_handle, uint32_t cmd,
 			void *header, uint32_t vdev_id, uint32_t chanfreq)
 {
-	qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);
+	WMI_LOG_LOCK(wmi_handle);
 
-	WMI_MGMT_COMMAND_RECORD(cmd,
+	WMI_MGMT_COMMAND_RECORD(wmi_handle, cmd,
 				((struct wmi_command_header *)header)->type,
 				((struct wmi_command_header *)header)->sub_type,
 				vdev_id, chanfreq);
 
-	qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+	WMI_LOG_UNLOCK(wmi_handle);
 }
 #else
 /**
@@ -1707,19 +2085,166 @@ static bool wmi_is_pm_resume_cmd(uint32_t cmd_id)
 #endif
 
 /**
- * wmi_unified_cmd_send() - WMI command API
+ * wmi_htc_pkt_pool_init() - preallocate the command HTC packet pool
+ * @pool: pool to initialize
+ *
+ * pending_cmds caps the number of commands in flight at WMI_MAX_CMDS,
+ * so a pool of that size covers every command that can be outstanding.
+ *
+ * Return: 0 on success, -ENOMEM if the pool could not be allocated
+ */
+static int wmi_htc_pkt_pool_init(struct wmi_htc_pkt_pool *pool)
+{
+	qdf_atomic_init(&pool->hint);
+	qdf_atomic_init(&pool->hits);
+	qdf_atomic_init(&pool->fallbacks);
+	bitmap_zero(pool->map, WMI_MAX_CMDS);
+
+	pool->pkts = qdf_mem_malloc(WMI_MAX_CMDS * sizeof(*pool->pkts));
+	if (!pool->pkts)
+		return -ENOMEM;
+
+	return 0;
+}
+
+/**
+ * wmi_htc_pkt_pool_deinit() - free the command HTC packet pool
+ * @pool: pool to free
+ *
+ * Return: none
+ */
+static void wmi_htc_pkt_pool_deinit(struct wmi_htc_pkt_pool *pool)
+{
+	if (pool->pkts) {
+		qdf_mem_free(pool->pkts);
+		pool->pkts = NULL;
+	}
+}
+
+/**
+ * wmi_htc_pkt_pool_get() - get an HTC packet for a WMI command
+ * @pool: command packet pool
+ *
+ * Claims a free slot in the pool bitmap without taking a lock; racing
+ * senders that pick the same slot retry on the next free one. The slot
+ * bit is a bit lock, so the packet is not touched before it is owned.
+ * Falls back to the heap if the pool is missing or exhausted.
+ *
+ * Return: zeroed HTC packet or NULL on allocation failure
+ */
+static HTC_PACKET *wmi_htc_pkt_pool_get(struct wmi_htc_pkt_pool *pool)
+{
+	HTC_PACKET *pkt;
+	unsigned long start;
+	unsigned long slot;
+	int tries;
+
+	if (!pool->pkts)
+		goto fallback;
+
+	start = (unsigned long)qdf_atomic_read(&pool->hint) % WMI_MAX_CMDS;
+	for (tries = 0; tries < WMI_MAX_CMDS; tries++) {
+		slot = find_next_zero_bit(pool->map, WMI_MAX_CMDS, start);
+		if (slot >= WMI_MAX_CMDS) {
+			slot = find_next_zero_bit(pool->map, WMI_MAX_CMDS, 0);
+			if (slot >= WMI_MAX_CMDS)
+				break;
+		}
+
+		if (!test_and_set_bit_lock(slot, pool->map)) {
+			qdf_atomic_set(&pool->hint,
+				       (slot + 1) % WMI_MAX_CMDS);
+			qdf_atomic_inc(&pool->hits);
+			pkt = &pool->pkts[slot];
+			qdf_mem_zero(pkt, sizeof(*pkt));
+			return pkt;
+		}
+		start = slot + 1;
+	}
+
+fallback:
+	qdf_atomic_inc(&pool->fallbacks);
+	return qdf_mem_malloc(sizeof(*pkt));
+}
+
+/**
+ * wmi_htc_pkt_pool_put() - release an HTC packet of a completed command
+ * @pool: command packet pool
+ * @pkt: packet returned by wmi_htc_pkt_pool_get()
+ *
+ * Return: none
+ */
+static void wmi_htc_pkt_pool_put(struct wmi_htc_pkt_pool *pool,
+				 HTC_PACKET *pkt)
+{
+	if (pool->pkts && pkt >= pool->pkts &&
+	    pkt < pool->pkts + WMI_MAX_CMDS) {
+		/* publish the last use of the packet before freeing the slot */
+		clear_bit_unlock(pkt - pool->pkts, pool->map);
+		return;
+	}
+
+	qdf_mem_free(pkt);
+}
+
+/**
+ * wmi_check_cmd_tlv_params() - validate the TLVs of an outgoing command
  * @wmi_handle: handle to wmi
  * @buf: wmi buf
  * @len: wmi buffer length
  * @cmd_id: wmi command id
  *
- * Return: 0 on success
+ * Return: 0 if the command is valid
  */
-int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, uint32_t len,
-			 uint32_t cmd_id)
+static int wmi_check_cmd_tlv_params(wmi_unified_t wmi_handle,
+				    wmi_buf_t buf, uint32_t len,
+				    uint32_t cmd_id)
+{
+#ifndef WMI_NON_TLV_SUPPORT
+	if (wmi_handle->target_type == WMI_TLV_TARGET) {
+		void *buf_ptr = (void *)qdf_nbuf_data(buf);
+
+		if (wmitlv_check_command_tlv_params(NULL, buf_ptr, len, cmd_id)
+			!= 0) {
+			QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_ERROR,
+			"\nERROR: %s: Invalid WMI Param Buffer for Cmd:%d",
+				__func__, cmd_id);
+			return -EINVAL;
+		}
+	}
+#endif
+	return 0;
+}
+
+/*
+ * Commands built by the send_*_cmd_tlv() builders use the same TLV
+ * definitions as the checker, release builds may skip validating them.
+ */
+#ifdef WMI_TLV_CMD_TRUSTED_BUILDERS
+#define WMI_CMD_CHECK_TRUSTED false
+#else
+#define WMI_CMD_CHECK_TRUSTED true
+#endif
+
+/**
+ * wmi_unified_cmd_prepare() - validate a WMI command and wrap it for HTC
+ * @wmi_handle: handle to wmi
+ * @buf: wmi buf
+ * @len: wmi buffer length
+ * @cmd_id: wmi command id
+ * @check: validate the TLVs of the command
+ * @htc_pkt: filled with the HTC packet carrying @buf on success
+ *
+ * Accounts the command in pending_cmds; the reference is dropped by
+ * wmi_htc_tx_complete() or by the caller if the send fails.
+ *
+ * Return: QDF_STATUS_SUCCESS on success
+ */
+static int wmi_unified_cmd_prepare(wmi_unified_t wmi_handle, wmi_buf_t buf,
+				   uint32_t len, uint32_t cmd_id, bool check,
+				   HTC_PACKET **htc_pkt)
 {
 	HTC_PACKET *pkt;
-	A_STATUS status;
 	uint16_t htc_tag = 0;
 
 	if (wmi_get_runtime_pm_inprogress(wmi_handle)) {
@@ -1739,19 +2264,8 @@ int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, uint32_t len,
 	}
 
 	/* Do sanity check on the TLV parameter structure */
-#ifndef WMI_NON_TLV_SUPPORT
-	if (wmi_handle->target_type == WMI_TLV_TARGET) {
-		void *buf_ptr = (void *)qdf_nbuf_data(buf);
-
-		if (wmitlv_check_command_tlv_params(NULL, buf_ptr, len, cmd_id)
-			!= 0) {
-			QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_ERROR,
-			"\nERROR: %s: Invalid WMI Param Buffer for Cmd:%d",
-				__func__, cmd_id);
-			return QDF_STATUS_E_INVAL;
-		}
-	}
-#endif
+	if (check && wmi_check_cmd_tlv_params(wmi_handle, buf, len, cmd_id))
+		return QDF_STATUS_E_INVAL;
 
 	if (qdf_nbuf_push_head(buf, sizeof(WMI_CMD_HDR)) == NULL) {
 		QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_ERROR,
@@ -1775,7 +2289,7 @@ int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, uint32_t len,
 		return QDF_STATUS_E_BUSY;
 	}
 
-	pkt = qdf_mem_malloc(sizeof(*pkt));
+	pkt = wmi_htc_pkt_pool_get(&wmi_handle->htc_pkt_pool);
 	if (!pkt) {
 		qdf_atomic_dec(&wmi_handle->pending_cmds);
 		QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_ERROR,
@@ -1796,20 +2310,66 @@ int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, uint32_t len,
 
 #ifdef WMI_INTERFACE_EVENT_LOGGING
 	if (wmi_handle->log_info.wmi_logging_enable) {
-		qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);
+		WMI_LOG_LOCK(wmi_handle);
 		if (!wmi_handle->log_info.is_management_record(cmd_id)) {
 			WMI_COMMAND_RECORD(wmi_handle, cmd_id,
 			((uint32_t *) qdf_nbuf_data(buf) +
-			 wmi_handle->log_info.buf_offset_command));
+			 wmi_handle->log_info.buf_offset_command),
+			wmi_log_data_len(qdf_nbuf_len(buf),
+				wmi_handle->log_info.buf_offset_command *
+				sizeof(uint32_t)));
 		}
-		qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+		WMI_LOG_UNLOCK(wmi_handle);
 	}
 #endif
 
+	*htc_pkt = pkt;
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * wmi_unified_cmd_unprepare() - undo wmi_unified_cmd_prepare()
+ * @wmi_handle: handle to wmi
+ * @pkt: HTC packet returned by wmi_unified_cmd_prepare()
+ *
+ * Return: none
+ */
+static void wmi_unified_cmd_unprepare(wmi_unified_t wmi_handle,
+				      HTC_PACKET *pkt)
+{
+	qdf_nbuf_pull_head(GET_HTC_PACKET_NET_BUF_CONTEXT(pkt),
+			   sizeof(WMI_CMD_HDR));
+	wmi_htc_pkt_pool_put(&wmi_handle->htc_pkt_pool, pkt);
+	qdf_atomic_dec(&wmi_handle->pending_cmds);
+}
+
+/**
+ * __wmi_unified_cmd_send() - send one WMI command
+ * @wmi_handle: handle to wmi
+ * @buf: wmi buf
+ * @len: wmi buffer length
+ * @cmd_id: wmi command id
+ * @check: validate the TLVs of the command
+ *
+ * Return: 0 on success
+ */
+static int __wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf,
+				  uint32_t len, uint32_t cmd_id, bool check)
+{
+	HTC_PACKET *pkt;
+	A_STATUS status;
+	int ret;
+
+	ret = wmi_unified_cmd_prepare(wmi_handle, buf, len, cmd_id, check,
+				      &pkt);
+	if (ret != QDF_STATUS_SUCCESS)
+		return ret;
+
 	status = htc_send_pkt(wmi_handle->htc_handle, pkt);
 
 	if (A_OK != status) {
-		qdf_atomic_dec(&wmi_handle->pending_cmds);
+		/* htc_send_pkt only fails before queuing the packet */
+		wmi_unified_cmd_unprepare(wmi_handle, pkt);
 		QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_ERROR,
 		   "%s %d, htc_send_pkt failed", __func__, __LINE__);
 	}
@@ -1819,28 +2379,255 @@ int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, uint32_t len,
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * wmi_unified_cmd_send() - WMI command API
+ * @wmi_handle: handle to wmi
+ * @buf: wmi buf
+ * @len: wmi buffer length
+ * @cmd_id: wmi command id
+ *
+ * Return: 0 on success
+ */
+int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, uint32_t len,
+			 uint32_t cmd_id)
+{
+	return __wmi_unified_cmd_send(wmi_handle, buf, len, cmd_id, true);
+}
+
+/**
+ * wmi_unified_cmd_send_trusted() - send a command built by a TLV builder
+ * @wmi_handle: handle to wmi
+ * @buf: wmi buf
+ * @len: wmi buffer length
+ * @cmd_id: wmi command id
+ *
+ * Only for the send_*_cmd_tlv() builders; the TLV check is skipped when
+ * WMI_TLV_CMD_TRUSTED_BUILDERS is set.
+ *
+ * Return: 0 on success
+ */
+int wmi_unified_cmd_send_trusted(wmi_unified_t wmi_handle, wmi_buf_t buf,
+				 uint32_t len, uint32_t cmd_id)
+{
+	return __wmi_unified_cmd_send(wmi_handle, buf, len, cmd_id,
+				      WMI_CMD_CHECK_TRUSTED);
+}
+
+/**
+ * wmi_unified_cmd_batch_begin() - start a batch of WMI commands
+ * @wmi_handle: handle to wmi
+ * @batch: caller owned batch context
+ *
+ * Return: none
+ */
+void wmi_unified_cmd_batch_begin(wmi_unified_t wmi_handle,
+				 struct wmi_cmd_batch *batch)
+{
+	INIT_HTC_PACKET_QUEUE(&batch->queue);
+}
+
+/**
+ * wmi_unified_cmd_batch_add() - queue a built WMI command in a batch
+ * @wmi_handle: handle to wmi
+ * @batch: batch started with wmi_unified_cmd_batch_begin()
+ * @buf: wmi buf
+ * @len: wmi buffer length
+ * @cmd_id: wmi command id
+ *
+ * A full batch is flushed before @buf is queued, so on failure @buf has
+ * never been taken and stays with the caller.
+ *
+ * Return: 0 on success
+ */
+int wmi_unified_cmd_batch_add(wmi_unified_t wmi_handle,
+			      struct wmi_cmd_batch *batch, wmi_buf_t buf,
+			      uint32_t len, uint32_t cmd_id)
+{
+	HTC_PACKET *pkt;
+	int ret;
+
+	if (HTC_PACKET_QUEUE_DEPTH(&batch->queue) >= WMI_CMD_BATCH_MAX_DEPTH) {
+		ret = wmi_unified_cmd_batch_commit(wmi_handle, batch);
+		if (ret != QDF_STATUS_SUCCESS)
+			return ret;
+	}
+
+	ret = wmi_unified_cmd_prepare(wmi_handle, buf, len, cmd_id, true, &pkt);
+	if (ret != QDF_STATUS_SUCCESS)
+		return ret;
+
+	HTC_PACKET_ENQUEUE(&batch->queue, pkt);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * wmi_unified_cmd_batch_commit() - send all queued WMI commands at once
+ * @wmi_handle: handle to wmi
+ * @batch: batch started with wmi_unified_cmd_batch_begin()
+ *
+ * Leaves @batch empty, so it can take further commands.
+ *
+ * Return: 0 on success
+ */
+int wmi_unified_cmd_batch_commit(wmi_unified_t wmi_handle,
+				 struct wmi_cmd_batch *batch)
+{
+	HTC_PACKET_QUEUE queue;
+	HTC_PACKET *pkt;
+	A_STATUS status;
+
+	INIT_HTC_PACKET_QUEUE(&queue);
+	HTC_PACKET_QUEUE_TRANSFER_TO_TAIL(&queue, &batch->queue);
+
+	if (HTC_QUEUE_EMPTY(&queue))
+		return QDF_STATUS_SUCCESS;
+
+	status = htc_send_pkts_multiple(wmi_handle->htc_handle, &queue);
+	if (A_OK == status)
+		return QDF_STATUS_SUCCESS;
+
+	/* htc_send_pkts_multiple only fails before taking any packet */
+	QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_ERROR,
+		  "%s: htc_send_pkts_multiple failed, dropping %d cmds",
+		  __func__, HTC_PACKET_QUEUE_DEPTH(&queue));
+	while ((pkt = htc_packet_dequeue(&queue)) != NULL) {
+		wmi_buf_t buf = GET_HTC_PACKET_NET_BUF_CONTEXT(pkt);
+
+		wmi_unified_cmd_unprepare(wmi_handle, pkt);
+		qdf_nbuf_free(buf);
+	}
+
+	return QDF_STATUS_E_FAILURE;
+}
+
+/**
+ * wmi_event_dispatch_hash() - hash a wmi event id into the dispatch table
+ * @event_id: wmi event id
+ *
+ * Return: first slot to probe for @event_id
+ */
+static inline uint32_t wmi_event_dispatch_hash(uint32_t event_id)
+{
+	/* ids are grouped as (group << 12) | offset, fold the group in */
+	return (event_id ^ (event_id >> 7)) & WMI_EVENT_DISPATCH_TBL_MASK;
+}
+
+/**
+ * wmi_event_dispatch_publish() - rebuild the dispatch table
+ * @wmi_handle: handle to wmi
+ *
+ * Rebuilds the dispatch table from event_id[] and event_handler[] inside
+ * a write section of event_dispatch_seq, so a lookup that overlaps the
+ * rebuild is retried instead of acting on a half built table.  Must be
+ * called with ctx_lock held, which also keeps bottom halves (and so the
+ * rx path) off this cpu while the write section is open.
+ *
+ * Return: none
+ */
+static void wmi_event_dispatch_publish(wmi_unified_t wmi_handle)
+{
+	struct wmi_event_dispatch_tbl *tbl = &wmi_handle->event_dispatch;
+	uint32_t idx;
+	uint32_t slot;
+
+	write_seqcount_begin(&wmi_handle->event_dispatch_seq);
+	qdf_mem_zero(tbl->handler_ix, sizeof(tbl->handler_ix));
+	for (idx = 0; idx < wmi_handle->max_event_idx; idx++) {
+		if (wmi_handle->event_handler[idx] == NULL)
+			continue;
+
+		slot = wmi_event_dispatch_hash(wmi_handle->event_id[idx]);
+		while (tbl->handler_ix[slot])
+			slot = (slot + 1) & WMI_EVENT_DISPATCH_TBL_MASK;
+		tbl->event_id[slot] = wmi_handle->event_id[idx];
+		tbl->handler_ix[slot] = idx + 1;
+	}
+	write_seqcount_end(&wmi_handle->event_dispatch_seq);
+}
+
 /**
  * wmi_unified_get_event_handler_ix() - gives event handler's index
  * @wmi_handle: handle to wmi
  * @event_id: wmi  event id
  *
+ * Lock free O(1) lookup through the event dispatch table, retried if it
+ * overlapped a rebuild.  The probe is bounded by the table size as a
+ * torn read of a table being rebuilt may have no empty slot.
+ *
  * Return: event handler's index
  */
 int wmi_unified_get_event_handler_ix(wmi_unified_t wmi_handle,
 				     uint32_t event_id)
 {
-	uint32_t idx = 0;
-	int32_t invalid_idx = -1;
-
-	for (idx = 0; (idx < wmi_handle->max_event_idx &&
-		       idx < WMI_UNIFIED_MAX_EVENT); ++idx) {
-		if (wmi_handle->event_id[idx] == event_id &&
-		    wmi_handle->event_handler[idx] != NULL) {
-			return idx;
+	struct wmi_event_dispatch_tbl *tbl = &wmi_handle->event_dispatch;
+	unsigned int seq;
+	uint32_t slot;
+	uint32_t probes;
+	uint32_t idx;
+	int32_t found;
+
+	do {
+		seq = read_seqcount_begin(&wmi_handle->event_dispatch_seq);
+		found = -1;
+		slot = wmi_event_dispatch_hash(event_id);
+		for (probes = 0; probes < WMI_EVENT_DISPATCH_TBL_SIZE &&
+		     tbl->handler_ix[slot]; probes++) {
+			if (tbl->event_id[slot] == event_id) {
+				idx = tbl->handler_ix[slot] - 1;
+				if (wmi_handle->event_handler[idx] != NULL)
+					found = idx;
+				break;
+			}
+			slot = (slot + 1) & WMI_EVENT_DISPATCH_TBL_MASK;
 		}
+	} while (read_seqcount_retry(&wmi_handle->event_dispatch_seq, seq));
+
+	return found;
+}
+
+#ifdef WMI_TLV_AND_NON_TLV_SUPPORT
+/* time critical events, as host abstracted event ids */
+static const uint32_t wmi_rx_high_pri_events[] = {
+	wmi_vdev_start_resp_event_id,
+	wmi_vdev_stopped_event_id,
+	wmi_peer_sta_kickout_event_id,
+	wmi_roam_event_id,
+	wmi_csa_handling_event_id,
+	wmi_wow_wakeup_host_event_id,
+};
+#else
+/* time critical events, as target event ids */
+static const uint32_t wmi_rx_high_pri_events[] = {
+	WMI_VDEV_START_RESP_EVENTID,
+	WMI_VDEV_STOPPED_EVENTID,
+	WMI_PEER_STA_KICKOUT_EVENTID,
+	WMI_ROAM_EVENTID,
+	WMI_CSA_HANDLING_EVENTID,
+	WMI_WOW_WAKEUP_HOST_EVENTID,
+};
+#endif
+
+/**
+ * wmi_rx_queue_select() - pick the rx work queue for an event
+ * @event_id: event id as passed to wmi_unified_register_event_handler()
+ *
+ * Time critical events go to the high priority queue, every other event
+ * id is pinned to one bulk queue so that its events stay in order.
+ *
+ * Return: index into wmi_unified rx_queue[]
+ */
+static uint8_t wmi_rx_queue_select(uint32_t event_id)
+{
+	uint32_t i;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(wmi_rx_high_pri_events); i++) {
+		if (wmi_rx_high_pri_events[i] == event_id)
+			return WMI_RX_QUEUE_HIGH_PRI;
 	}
 
-	return invalid_idx;
+	return WMI_RX_QUEUE_HIGH_PRI + 1 +
+		wmi_event_dispatch_hash(event_id) % WMI_RX_BULK_QUEUE_NUM;
 }
 
 /**
@@ -1871,23 +2658,32 @@ int wmi_unified_register_event_handler(wmi_unified_t wmi_handle,
 #else
 	evt_id = event_id;
 #endif
+	qdf_spin_lock_bh(&wmi_handle->ctx_lock);
 	if (wmi_unified_get_event_handler_ix(wmi_handle, evt_id) != -1) {
+		qdf_spin_unlock_bh(&wmi_handle->ctx_lock);
 		qdf_print("%s : event handler already registered 0x%x\n",
 		       __func__, evt_id);
 		return QDF_STATUS_E_FAILURE;
 	}
-	if (wmi_handle->max_event_idx == WMI_UNIFIED_MAX_EVENT) {
+	/* reuse a slot freed by unregister so live indices never move */
+	for (idx = 0; idx < wmi_handle->max_event_idx; idx++) {
+		if (wmi_handle->event_handler[idx] == NULL)
+			break;
+	}
+	if (idx == WMI_UNIFIED_MAX_EVENT) {
+		qdf_spin_unlock_bh(&wmi_handle->ctx_lock);
 		qdf_print("%s : no more event handlers 0x%x\n",
 		       __func__, evt_id);
 		return QDF_STATUS_E_FAILURE;
 	}
-	idx = wmi_handle->max_event_idx;
-	wmi_handle->event_handler[idx] = handler_func;
 	wmi_handle->event_id[idx] = evt_id;
-	qdf_spin_lock_bh(&wmi_handle->ctx_lock);
 	wmi_handle->ctx[idx] = rx_ctx;
+	wmi_handle->rx_queue_ix[idx] = wmi_rx_queue_select(event_id);
+	wmi_handle->event_handler[idx] = handler_func;
+	if (idx == wmi_handle->max_event_idx)
+		wmi_handle->max_event_idx++;
+	wmi_event_dispatch_publish(wmi_handle);
 	qdf_spin_unlock_bh(&wmi_handle->ctx_lock);
-	wmi_handle->max_event_idx++;
 
 	return 0;
 }
@@ -1902,7 +2698,7 @@ int wmi_unified_register_event_handler(wmi_unified_t wmi_handle,
 int wmi_unified_unregister_event_handler(wmi_unified_t wmi_handle,
 					 uint32_t event_id)
 {
-	uint32_t idx = 0;
+	int idx = 0;
 	uint32_t evt_id;
 
 #ifdef WMI_TLV_AND_NON_TLV_SUPPORT
@@ -1917,19 +2713,21 @@ int wmi_unified_unregister_event_handler(wmi_unified_t wmi_handle,
 	evt_id = event_id;
 #endif
 
+	qdf_spin_lock_bh(&wmi_handle->ctx_lock);
 	idx = wmi_unified_get_event_handler_ix(wmi_handle, evt_id);
 	if (idx == -1) {
+		qdf_spin_unlock_bh(&wmi_handle->ctx_lock);
 		qdf_print("%s : event handler is not registered: evt id 0x%x\n",
 		       __func__, evt_id);
 		return QDF_STATUS_E_FAILURE;
 	}
 	wmi_handle->event_handler[idx] = NULL;
 	wmi_handle->event_id[idx] = 0;
-	--wmi_handle->max_event_idx;
-	wmi_handle->event_handler[idx] =
-		wmi_handle->event_handler[wmi_handle->max_event_idx];
-	wmi_handle->event_id[idx] =
-		wmi_handle->event_id[wmi_handle->max_event_idx];
+	while (wmi_handle->max_event_idx &&
+	       wmi_handle->event_handler[wmi_handle->max_event_idx - 1] == NULL)
+		--wmi_handle->max_event_idx;
+	wmi_event_dispatch_publish(wmi_handle);
+	qdf_spin_unlock_bh(&wmi_handle->ctx_lock);
 
 	return 0;
 }
@@ -1966,37 +2764,57 @@ static void wmi_process_fw_event_default_ctx(struct wmi_unified *wmi_handle,
  * wmi_process_fw_event_worker_thread_ctx() - process in worker thread context
  * @wmi_handle: handle to wmi
  * @htc_packet: pointer to htc packet
+ * @idx: event handler index resolved by wmi_control_rx()
  *
  * Event process by below function will be in worker thread context.
  * Use this method for events which are not critical and not
- * handled in protocol stack.
+ * handled in protocol stack. @idx travels with the event in the nbuf
+ * priority field, which is unused for wmi events, so that the worker
+ * does not have to look the handler up again.
  *
  * Return: none
  */
 static void wmi_process_fw_event_worker_thread_ctx
-		(struct wmi_unified *wmi_handle, HTC_PACKET *htc_packet)
+		(struct wmi_unified *wmi_handle, HTC_PACKET *htc_packet,
+		 uint32_t idx)
 {
+	uint8_t queue_ix = wmi_handle->rx_queue_ix[idx];
+	struct wmi_rx_queue *rxq = &wmi_handle->rx_queue[queue_ix];
 	wmi_buf_t evt_buf;
 	uint32_t id;
 	uint8_t *data;
 
 	evt_buf = (wmi_buf_t) htc_packet->pPktContext;
+	qdf_nbuf_set_priority(evt_buf, idx);
 	id = WMI_GET_FIELD(qdf_nbuf_data(evt_buf), WMI_CMD_HDR, COMMANDID);
 	data = qdf_nbuf_data(evt_buf);
 
 #ifdef WMI_INTERFACE_EVENT_LOGGING
 	if (wmi_handle->log_info.wmi_logging_enable) {
-		qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);
+		WMI_LOG_LOCK(wmi_handle);
 		/* Exclude 4 bytes of TLV header */
 		WMI_RX_EVENT_RECORD(wmi_handle, id, ((uint8_t *) data +
+				wmi_handle->log_info.buf_offset_event),
+				wmi_log_data_len(qdf_nbuf_len(evt_buf),
 				wmi_handle->log_info.buf_offset_event));
-		qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+		WMI_LOG_UNLOCK(wmi_handle);
 	}
 #endif
-	qdf_spin_lock_bh(&wmi_handle->eventq_lock);
-	qdf_nbuf_queue_add(&wmi_handle->event_queue, evt_buf);
-	qdf_spin_unlock_bh(&wmi_handle->eventq_lock);
-	schedule_work(&wmi_handle->rx_event_work);
+	qdf_spin_lock_bh(&rxq->lock);
+	qdf_nbuf_queue_add(&rxq->events, evt_buf);
+	rxq->enq_ts[rxq->enq_seq & (WMI_RX_QUEUE_TS_RING - 1)] =
+		qdf_get_monotonic_boottime();
+	rxq->enq_seq++;
+	if (++rxq->depth > rxq->max_depth)
+		rxq->max_depth = rxq->depth;
+	qdf_spin_unlock_bh(&rxq->lock);
+
+	if (queue_ix == WMI_RX_QUEUE_HIGH_PRI && wmi_handle->rx_hipri_wq)
+		queue_work(wmi_handle->rx_hipri_wq, &rxq->work);
+	else if (wmi_handle->rx_wq)
+		queue_work(wmi_handle->rx_wq, &rxq->work);
+	else
+		schedule_work(&rxq->work);
 	return;
 }
 
@@ -2025,13 +2843,11 @@ void wmi_control_rx(void *ctx, HTC_PACKET *htc_packet)
 		qdf_nbuf_free(evt_buf);
 		return;
 	}
-	qdf_spin_lock_bh(&wmi_handle->ctx_lock);
 	exec_ctx = wmi_handle->ctx[idx];
-	qdf_spin_unlock_bh(&wmi_handle->ctx_lock);
 
 	if (exec_ctx == WMI_RX_WORK_CTX) {
 		wmi_process_fw_event_worker_thread_ctx
-					(wmi_handle, htc_packet);
+					(wmi_handle, htc_packet, idx);
 	} else if (exec_ctx > WMI_RX_WORK_CTX) {
 		wmi_process_fw_event_default_ctx
 					(wmi_handle, htc_packet, exec_ctx);
@@ -2057,13 +2873,18 @@ void wmi_process_fw_event(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 }
 
 /**
- * __wmi_control_rx() - process serialize wmi event callback
+ * wmi_control_rx_dispatch() - validate an event and call its handler
  * @wmi_handle: wmi handle
  * @evt_buf: fw event buffer
+ * @idx: event handler index if already resolved, A_ERROR otherwise
+ *
+ * A resolved @idx is only trusted while it still maps to the event id,
+ * a handler unregistered or moved in the meantime is looked up again.
  *
  * Return: none
  */
-void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
+static void wmi_control_rx_dispatch(struct wmi_unified *wmi_handle,
+				    wmi_buf_t evt_buf, uint32_t idx)
 {
 	uint32_t id;
 	uint8_t *data;
@@ -2072,7 +2893,7 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 #ifndef WMI_NON_TLV_SUPPORT
 	int tlv_ok_status = 0;
 #endif
-	uint32_t idx = 0;
+	wmi_unified_event_handler handler = NULL;
 
 	id = WMI_GET_FIELD(qdf_nbuf_data(evt_buf), WMI_CMD_HDR, COMMANDID);
 
@@ -2086,9 +2907,10 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 	if (wmi_handle->target_type == WMI_TLV_TARGET) {
 		/* Validate and pad(if necessary) the TLVs */
 		tlv_ok_status =
-			wmitlv_check_and_pad_event_tlvs(wmi_handle->scn_handle,
-							data, len, id,
-							&wmi_cmd_struct_ptr);
+			wmitlv_check_and_pad_event_tlvs_arena(
+					wmi_handle->scn_handle, data, len, id,
+					&wmi_handle->tlv_arena,
+					&wmi_cmd_struct_ptr);
 		if (tlv_ok_status != 0) {
 			QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_ERROR,
 				"%s: Error: id=0x%d, wmitlv check status=%d\n",
@@ -2098,8 +2920,14 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 	}
 #endif
 
-	idx = wmi_unified_get_event_handler_ix(wmi_handle, id);
-	if (idx == A_ERROR) {
+	if (idx < WMI_UNIFIED_MAX_EVENT && wmi_handle->event_id[idx] == id)
+		handler = wmi_handle->event_handler[idx];
+	if (handler == NULL) {
+		idx = wmi_unified_get_event_handler_ix(wmi_handle, id);
+		if (idx != A_ERROR)
+			handler = wmi_handle->event_handler[idx];
+	}
+	if (handler == NULL) {
 		QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_ERROR,
 		   "%s : event handler is not registered: event id 0x%x\n",
 			__func__, id);
@@ -2107,61 +2935,181 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 	}
 #ifdef WMI_INTERFACE_EVENT_LOGGING
 	if (wmi_handle->log_info.wmi_logging_enable) {
-		qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);
+		WMI_LOG_LOCK(wmi_handle);
 		/* Exclude 4 bytes of TLV header */
 		if (wmi_handle->log_info.is_management_record(id)) {
 			WMI_MGMT_EVENT_RECORD(wmi_handle, id, ((uint8_t *) data
-				+ wmi_handle->log_info.buf_offset_event));
+				+ wmi_handle->log_info.buf_offset_event),
+				wmi_log_data_len(len,
+				wmi_handle->log_info.buf_offset_event));
 		} else {
 			WMI_EVENT_RECORD(wmi_handle, id, ((uint8_t *) data +
+					wmi_handle->log_info.buf_offset_event),
+					wmi_log_data_len(len,
 					wmi_handle->log_info.buf_offset_event));
 		}
-		qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+		WMI_LOG_UNLOCK(wmi_handle);
 	}
 #endif
 	/* Call the WMI registered event handler */
 	if (wmi_handle->target_type == WMI_TLV_TARGET)
-		wmi_handle->event_handler[idx] (wmi_handle->scn_handle,
-			wmi_cmd_struct_ptr, len);
+		handler(wmi_handle->scn_handle, wmi_cmd_struct_ptr, len);
 	else
-		wmi_handle->event_handler[idx] (wmi_handle->scn_handle,
-			data, len);
+		handler(wmi_handle->scn_handle, data, len);
 
 end:
 	/* Free event buffer and allocated event tlv */
 #ifndef WMI_NON_TLV_SUPPORT
 	if (wmi_handle->target_type == WMI_TLV_TARGET)
-		wmitlv_free_allocated_event_tlvs(id, &wmi_cmd_struct_ptr);
+		wmitlv_free_allocated_event_tlvs_arena(id,
+						       &wmi_handle->tlv_arena,
+						       &wmi_cmd_struct_ptr);
 #endif
 	qdf_nbuf_free(evt_buf);
 
 }
 
+/**
+ * __wmi_control_rx() - process serialize wmi event callback
+ * @wmi_handle: wmi handle
+ * @evt_buf: fw event buffer
+ *
+ * Return: none
+ */
+void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
+{
+	wmi_control_rx_dispatch(wmi_handle, evt_buf, A_ERROR);
+}
+
+/**
+ * wmi_rx_queue_dequeue() - take the oldest event off an rx queue
+ * @rxq: rx queue
+ *
+ * Return: event buffer or NULL if @rxq is empty
+ */
+static wmi_buf_t wmi_rx_queue_dequeue(struct wmi_rx_queue *rxq)
+{
+	wmi_buf_t buf;
+	uint64_t latency;
+
+	qdf_spin_lock_bh(&rxq->lock);
+	buf = qdf_nbuf_queue_remove(&rxq->events);
+	if (buf) {
+		/* the stamp is only still there if the queue was not deeper */
+		if (rxq->enq_seq - rxq->deq_seq <= WMI_RX_QUEUE_TS_RING) {
+			latency = qdf_get_monotonic_boottime() -
+				rxq->enq_ts[rxq->deq_seq &
+					    (WMI_RX_QUEUE_TS_RING - 1)];
+			rxq->total_latency_us += latency;
+			if (latency > rxq->max_latency_us)
+				rxq->max_latency_us = latency;
+			rxq->latency_samples++;
+		}
+		rxq->deq_seq++;
+		rxq->depth--;
+		rxq->processed++;
+	}
+	qdf_spin_unlock_bh(&rxq->lock);
+
+	return buf;
+}
+
 /**
  * wmi_rx_event_work() - process rx event in rx work queue context
  * @work: rx work queue struct
  *
- * This function process any fw event to serialize it through rx worker thread.
+ * This function process the fw events of one rx queue, serialized in the
+ * order they were received.
  *
  * Return: none
  */
 void wmi_rx_event_work(struct work_struct *work)
 {
-	struct wmi_unified *wmi = container_of(work, struct wmi_unified,
-					rx_event_work);
+	struct wmi_rx_queue *rxq = container_of(work, struct wmi_rx_queue,
+						work);
+	wmi_buf_t buf;
+
+	while ((buf = wmi_rx_queue_dequeue(rxq)))
+		wmi_control_rx_dispatch(rxq->wmi_handle, buf,
+					qdf_nbuf_get_priority(buf));
+}
+
+/**
+ * wmi_rx_queues_init() - set up the rx work queues of a wmi handle
+ * @wmi_handle: handle to wmi
+ *
+ * Falls back to the system workqueue if the dedicated ones cannot be
+ * created.
+ *
+ * Return: none
+ */
+static void wmi_rx_queues_init(struct wmi_unified *wmi_handle)
+{
+	struct wmi_rx_queue *rxq;
+	int i;
+
+	for (i = 0; i < WMI_RX_QUEUE_NUM; i++) {
+		rxq = &wmi_handle->rx_queue[i];
+		rxq->wmi_handle = wmi_handle;
+		qdf_spinlock_create(&rxq->lock);
+		qdf_nbuf_queue_init(&rxq->events);
+		INIT_WORK(&rxq->work, wmi_rx_event_work);
+	}
+
+	wmi_handle->rx_hipri_wq = alloc_workqueue("wmi_rx_hipri",
+						  WQ_HIGHPRI | WQ_UNBOUND, 1);
+	wmi_handle->rx_wq = alloc_workqueue("wmi_rx", WQ_UNBOUND,
+					    WMI_RX_BULK_QUEUE_NUM);
+	if (!wmi_handle->rx_hipri_wq || !wmi_handle->rx_wq)
+		qdf_print("%s: WMI rx workqueue unavailable, using system wq\n",
+			  __func__);
+}
+
+/**
+ * wmi_rx_queues_flush() - stop the rx workers and drop queued events
+ * @wmi_handle: handle to wmi
+ *
+ * Return: none
+ */
+static void wmi_rx_queues_flush(struct wmi_unified *wmi_handle)
+{
+	struct wmi_rx_queue *rxq;
 	wmi_buf_t buf;
+	int i;
 
-	qdf_spin_lock_bh(&wmi->eventq_lock);
-	buf = qdf_nbuf_queue_remove(&wmi->event_queue);
-	qdf_spin_unlock_bh(&wmi->eventq_lock);
-	while (buf) {
-		__wmi_control_rx(wmi, buf);
-		qdf_spin_lock_bh(&wmi->eventq_lock);
-		buf = qdf_nbuf_queue_remove(&wmi->event_queue);
-		qdf_spin_unlock_bh(&wmi->eventq_lock);
+	for (i = 0; i < WMI_RX_QUEUE_NUM; i++) {
+		rxq = &wmi_handle->rx_queue[i];
+		cancel_work_sync(&rxq->work);
+		while ((buf = wmi_rx_queue_dequeue(rxq)))
+			qdf_nbuf_free(buf);
 	}
 }
 
+/**
+ * wmi_rx_queues_deinit() - free the rx work queues of a wmi handle
+ * @wmi_handle: handle to wmi
+ *
+ * Return: none
+ */
+static void wmi_rx_queues_deinit(struct wmi_unified *wmi_handle)
+{
+	int i;
+
+	wmi_rx_queues_flush(wmi_handle);
+
+	if (wmi_handle->rx_hipri_wq) {
+		destroy_workqueue(wmi_handle->rx_hipri_wq);
+		wmi_handle->rx_hipri_wq = NULL;
+	}
+	if (wmi_handle->rx_wq) {
+		destroy_workqueue(wmi_handle->rx_wq);
+		wmi_handle->rx_wq = NULL;
+	}
+
+	for (i = 0; i < WMI_RX_QUEUE_NUM; i++)
+		qdf_spinlock_destroy(&wmi_handle->rx_queue[i].lock);
+}
+
 #ifdef FEATURE_RUNTIME_PM
 /**
  * wmi_runtime_pm_init() - initialize runtime pm wmi variables
@@ -2232,9 +3180,11 @@ void *wmi_unified_attach(void *scn_handle,
 	qdf_atomic_init(&wmi_handle->pending_cmds);
 	qdf_atomic_init(&wmi_handle->is_target_suspended);
 	wmi_runtime_pm_init(wmi_handle);
-	qdf_spinlock_create(&wmi_handle->eventq_lock);
-	qdf_nbuf_queue_init(&wmi_handle->event_queue);
-	INIT_WORK(&wmi_handle->rx_event_work, wmi_rx_event_work);
+	seqcount_init(&wmi_handle->event_dispatch_seq);
+	wmi_rx_queues_init(wmi_handle);
+	if (wmi_htc_pkt_pool_init(&wmi_handle->htc_pkt_pool))
+		qdf_print("%s: HTC packet pool unavailable, using heap\n",
+			  __func__);
 #ifdef WMI_INTERFACE_EVENT_LOGGING
 	if (QDF_STATUS_SUCCESS == wmi_log_init(wmi_handle)) {
 		qdf_spinlock_create(&wmi_handle->log_info.wmi_record_lock);
@@ -2245,10 +3195,15 @@ void *wmi_unified_attach(void *scn_handle,
 	wmi_handle->rx_ops.wma_process_fw_event_handler_cbk =
 				rx_ops->wma_process_fw_event_handler_cbk;
 	wmi_handle->target_type = target_type;
-	if (target_type == WMI_TLV_TARGET)
+	if (target_type == WMI_TLV_TARGET) {
 		wmi_tlv_attach(wmi_handle);
-	else
+		wmitlv_build_attr_index();
+		if (wmitlv_arena_init(&wmi_handle->tlv_arena))
+			qdf_print("%s: TLV arena unavailable, using heap\n",
+				  __func__);
+	} else {
 		wmi_non_tlv_attach(wmi_handle);
+	}
 	/* Assign target cookie capablity */
 	wmi_handle->use_cookie = use_cookie;
 	wmi_handle->osdev = osdev;
@@ -2267,23 +3222,18 @@ void *wmi_unified_attach(void *scn_handle,
  */
 void wmi_unified_detach(struct wmi_unified *wmi_handle)
 {
-	wmi_buf_t buf;
-
-	cancel_work_sync(&wmi_handle->rx_event_work);
+	wmi_rx_queues_deinit(wmi_handle);
 
 	wmi_debugfs_remove(wmi_handle);
 
-	buf = qdf_nbuf_queue_remove(&wmi_handle->event_queue);
-	while (buf) {
-		qdf_nbuf_free(buf);
-		buf = qdf_nbuf_queue_remove(&wmi_handle->event_queue);
-	}
-
 #ifdef WMI_INTERFACE_EVENT_LOGGING
 	wmi_log_buffer_free(wmi_handle);
 #endif
 
-	qdf_spinlock_destroy(&wmi_handle->eventq_lock);
+	if (wmi_handle->target_type == WMI_TLV_TARGET)
+		wmitlv_arena_deinit(&wmi_handle->tlv_arena);
+
+	wmi_htc_pkt_pool_deinit(&wmi_handle->htc_pkt_pool);
 	qdf_spinlock_destroy(&wmi_handle->ctx_lock);
 	OS_FREE(wmi_handle);
 	wmi_handle = NULL;
@@ -2303,18 +3253,9 @@ void wmi_unified_detach(struct wmi_unified *wmi_handle)
 void
 wmi_unified_remove_work(struct wmi_unified *wmi_handle)
 {
-	wmi_buf_t buf;
-
 	QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_INFO,
 		"Enter: %s", __func__);
-	cancel_work_sync(&wmi_handle->rx_event_work);
-	qdf_spin_lock_bh(&wmi_handle->eventq_lock);
-	buf = qdf_nbuf_queue_remove(&wmi_handle->event_queue);
-	while (buf) {
-		qdf_nbuf_free(buf);
-		buf = qdf_nbuf_queue_remove(&wmi_handle->event_queue);
-	}
-	qdf_spin_unlock_bh(&wmi_handle->eventq_lock);
+	wmi_rx_queues_flush(wmi_handle);
 	QDF_TRACE(QDF_MODULE_ID_WMI, QDF_TRACE_LEVEL_INFO,
 		"Done: %s", __func__);
 }
@@ -2345,24 +3286,30 @@ void wmi_htc_tx_complete(void *ctx, HTC_PACKET *htc_pkt)
 	WMI_LOGD("Sent WMI command:%s command_id:0x%x over dma and recieved tx complete interupt",
 		 wmi_id_to_name(cmd_id), cmd_id);
 
-	qdf_spin_lock_bh(&wmi_handle->log_info.wmi_record_lock);
+	WMI_LOG_LOCK(wmi_handle);
 	/* Record 16 bytes of WMI cmd tx complete data
 	- exclude TLV and WMI headers */
 	if (wmi_handle->log_info.is_management_record(cmd_id)) {
 		WMI_MGMT_COMMAND_TX_CMP_RECORD(wmi_handle, cmd_id,
 			((uint32_t *) qdf_nbuf_data(wmi_cmd_buf) +
-			wmi_handle->log_info.buf_offset_command));
+			wmi_handle->log_info.buf_offset_command),
+			wmi_log_data_len(qdf_nbuf_len(wmi_cmd_buf),
+				wmi_handle->log_info.buf_offset_command *
+				sizeof(uint32_t)));
 	} else {
 		WMI_COMMAND_TX_CMP_RECORD(wmi_handle, cmd_id,
 			((uint32_t *) qdf_nbuf_data(wmi_cmd_buf) +
-			wmi_handle->log_info.buf_offset_command));
+			wmi_handle->log_info.buf_offset_command),
+			wmi_log_data_len(qdf_nbuf_len(wmi_cmd_buf),
+				wmi_handle->log_info.buf_offset_command *
+				sizeof(uint32_t)));
 	}
 
-	qdf_spin_unlock_bh(&wmi_handle->log_info.wmi_record_lock);
+	WMI_LOG_UNLOCK(wmi_handle);
 	}
 #endif
 	qdf_nbuf_free(wmi_cmd_buf);
-	qdf_mem_free(htc_pkt);
+	wmi_htc_pkt_pool_put(&wmi_handle->htc_pkt_pool, htc_pkt);
 	qdf_atomic_dec(&wmi_handle->pending_cmds);
 }
 
@@ -6039,6 +6039,171 @@ QDF_STATUS wmi_extract_vdev_extd_stats(void *wmi_hdl, void *evt_buf,
 	return QDF_STATUS_E_FAILURE;
 }
 
+/**
+ * wmi_extract_stats_view() - locate the stats arrays of a stats event
+ * @wmi_handle: wmi handle
+ * @param evt_buf: pointer to event buffer
+ * @param view: Pointer to hold the array locations and counts
+ *
+ * For callers that only read the stats; nothing is copied.
+ *
+ * Return: QDF_STATUS_SUCCESS on success and QDF_STATUS_E_FAILURE for failure
+ */
+QDF_STATUS wmi_extract_stats_view(void *wmi_hdl, void *evt_buf,
+		struct wmi_host_stats_view *view)
+{
+	wmi_unified_t wmi_handle = (wmi_unified_t) wmi_hdl;
+
+	if (wmi_handle->ops->extract_stats_view)
+		return wmi_handle->ops->extract_stats_view(wmi_handle,
+				evt_buf, view);
+	return QDF_STATUS_E_FAILURE;
+}
+
+/**
+ * wmi_extract_vdev_stats_bulk() - extract a range of vdev stats from event
+ * @wmi_handle: wmi handle
+ * @param evt_buf: pointer to event buffer
+ * @param start: Index of the first vdev stats record to extract
+ * @param num: Number of entries in @vdev_stats
+ * @param vdev_stats: Array to hold vdev stats
+ * @param num_filled: Set to the number of entries filled
+ *
+ * Falls back to one extract_vdev_stats call per record when the target
+ * flavour has no bulk op.
+ *
+ * Return: QDF_STATUS_SUCCESS on success and QDF_STATUS_E_FAILURE for failure
+ */
+QDF_STATUS wmi_extract_vdev_stats_bulk(void *wmi_hdl, void *evt_buf,
+		uint32_t start, uint32_t num, wmi_host_vdev_stats *vdev_stats,
+		uint32_t *num_filled)
+{
+	wmi_unified_t wmi_handle = (wmi_unified_t) wmi_hdl;
+	wmi_host_stats_event counts;
+	QDF_STATUS status;
+	uint32_t i;
+
+	*num_filled = 0;
+	if (wmi_handle->ops->extract_vdev_stats_bulk)
+		return wmi_handle->ops->extract_vdev_stats_bulk(wmi_handle,
+				evt_buf, start, num, vdev_stats, num_filled);
+
+	if (!wmi_handle->ops->extract_vdev_stats ||
+	    !wmi_handle->ops->extract_all_stats_count)
+		return QDF_STATUS_E_FAILURE;
+
+	status = wmi_handle->ops->extract_all_stats_count(wmi_handle,
+				evt_buf, &counts);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	for (i = start; i < counts.num_vdev_stats && *num_filled < num; i++) {
+		status = wmi_handle->ops->extract_vdev_stats(wmi_handle,
+				evt_buf, i, &vdev_stats[*num_filled]);
+		if (QDF_IS_STATUS_ERROR(status))
+			return status;
+		(*num_filled)++;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * wmi_extract_peer_stats_bulk() - extract a range of peer stats from event
+ * @wmi_handle: wmi handle
+ * @param evt_buf: pointer to event buffer
+ * @param start: Index of the first peer stats record to extract
+ * @param num: Number of entries in @peer_stats
+ * @param peer_stats: Array to hold peer stats
+ * @param num_filled: Set to the number of entries filled
+ *
+ * Falls back to one extract_peer_stats call per record when the target
+ * flavour has no bulk op.
+ *
+ * Return: QDF_STATUS_SUCCESS on success and QDF_STATUS_E_FAILURE for failure
+ */
+QDF_STATUS wmi_extract_peer_stats_bulk(void *wmi_hdl, void *evt_buf,
+		uint32_t start, uint32_t num, wmi_host_peer_stats *peer_stats,
+		uint32_t *num_filled)
+{
+	wmi_unified_t wmi_handle = (wmi_unified_t) wmi_hdl;
+	wmi_host_stats_event counts;
+	QDF_STATUS status;
+	uint32_t i;
+
+	*num_filled = 0;
+	if (wmi_handle->ops->extract_peer_stats_bulk)
+		return wmi_handle->ops->extract_peer_stats_bulk(wmi_handle,
+				evt_buf, start, num, peer_stats, num_filled);
+
+	if (!wmi_handle->ops->extract_peer_stats ||
+	    !wmi_handle->ops->extract_all_stats_count)
+		return QDF_STATUS_E_FAILURE;
+
+	status = wmi_handle->ops->extract_all_stats_count(wmi_handle,
+				evt_buf, &counts);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	for (i = start; i < counts.num_peer_stats && *num_filled < num; i++) {
+		status = wmi_handle->ops->extract_peer_stats(wmi_handle,
+				evt_buf, i, &peer_stats[*num_filled]);
+		if (QDF_IS_STATUS_ERROR(status))
+			return status;
+		(*num_filled)++;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * wmi_extract_chan_stats_bulk() - extract a range of chan stats from event
+ * @wmi_handle: wmi handle
+ * @param evt_buf: pointer to event buffer
+ * @param start: Index of the first chan stats record to extract
+ * @param num: Number of entries in @chan_stats
+ * @param chan_stats: Array to hold chan stats
+ * @param num_filled: Set to the number of entries filled
+ *
+ * Falls back to one extract_chan_stats call per record when the target
+ * flavour has no bulk op.
+ *
+ * Return: QDF_STATUS_SUCCESS on success and QDF_STATUS_E_FAILURE for failure
+ */
+QDF_STATUS wmi_extract_chan_stats_bulk(void *wmi_hdl, void *evt_buf,
+		uint32_t start, uint32_t num, wmi_host_chan_stats *chan_stats,
+		uint32_t *num_filled)
+{
+	wmi_unified_t wmi_handle = (wmi_unified_t) wmi_hdl;
+	wmi_host_stats_event counts;
+	QDF_STATUS status;
+	uint32_t i;
+
+	*num_filled = 0;
+	if (wmi_handle->ops->extract_chan_stats_bulk)
+		return wmi_handle->ops->extract_chan_stats_bulk(wmi_handle,
+				evt_buf, start, num, chan_stats, num_filled);
+
+	if (!wmi_handle->ops->extract_chan_stats ||
+	    !wmi_handle->ops->extract_all_stats_count)
+		return QDF_STATUS_E_FAILURE;
+
+	status = wmi_handle->ops->extract_all_stats_count(wmi_handle,
+				evt_buf, &counts);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	for (i = start; i < counts.num_chan_stats && *num_filled < num; i++) {
+		status = wmi_handle->ops->extract_chan_stats(wmi_handle,
+				evt_buf, i, &chan_stats[*num_filled]);
+		if (QDF_IS_STATUS_ERROR(status))
+			return status;
+		(*num_filled)++;
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
 /**
  * wmi_unified_send_adapt_dwelltime_params_cmd() - send wmi cmd of
  * adaptive dwelltime configuration params
@@ -96,7 +96,7 @@ QDF_STATUS send_vdev_create_cmd_tlv(wmi_unified_t wmi_handle,
 	WMITLV_SET_HDR(&txrx_streams->tlv_header,
 		       WMITLV_TAG_STRUC_wmi_vdev_txrx_streams,
 		       WMITLV_GET_STRUCT_TLVLEN(wmi_vdev_txrx_streams));
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len, WMI_VDEV_CREATE_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len, WMI_VDEV_CREATE_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send WMI_VDEV_CREATE_CMDID");
 		wmi_buf_free(buf);
@@ -131,9 +131,9 @@ QDF_STATUS send_vdev_delete_cmd_tlv(wmi_unified_t wmi_handle,
 		       WMITLV_GET_STRUCT_TLVLEN
 			       (wmi_vdev_delete_cmd_fixed_param));
 	cmd->vdev_id = if_id;
-	ret = wmi_unified_cmd_send(wmi_handle, buf,
-				   sizeof(wmi_vdev_delete_cmd_fixed_param),
-				   WMI_VDEV_DELETE_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					   sizeof(wmi_vdev_delete_cmd_fixed_param),
+					   WMI_VDEV_DELETE_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send WMI_VDEV_DELETE_CMDID");
 		wmi_buf_free(buf);
@@ -167,7 +167,7 @@ QDF_STATUS send_vdev_stop_cmd_tlv(wmi_unified_t wmi,
 		       WMITLV_TAG_STRUC_wmi_vdev_stop_cmd_fixed_param,
 		       WMITLV_GET_STRUCT_TLVLEN(wmi_vdev_stop_cmd_fixed_param));
 	cmd->vdev_id = vdev_id;
-	if (wmi_unified_cmd_send(wmi, buf, len, WMI_VDEV_STOP_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi, buf, len, WMI_VDEV_STOP_CMDID)) {
 		WMI_LOGP("%s: Failed to send vdev stop command", __func__);
 		qdf_nbuf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -199,7 +199,7 @@ QDF_STATUS send_vdev_down_cmd_tlv(wmi_unified_t wmi, uint8_t vdev_id)
 		       WMITLV_TAG_STRUC_wmi_vdev_down_cmd_fixed_param,
 		       WMITLV_GET_STRUCT_TLVLEN(wmi_vdev_down_cmd_fixed_param));
 	cmd->vdev_id = vdev_id;
-	if (wmi_unified_cmd_send(wmi, buf, len, WMI_VDEV_DOWN_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi, buf, len, WMI_VDEV_DOWN_CMDID)) {
 		WMI_LOGP("%s: Failed to send vdev down", __func__);
 		qdf_nbuf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -307,11 +307,11 @@ QDF_STATUS send_vdev_start_cmd_tlv(wmi_unified_t wmi_handle,
 		req->preferred_tx_streams, req->preferred_rx_streams);
 
 	if (req->is_restart)
-		ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-					   WMI_VDEV_RESTART_REQUEST_CMDID);
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+						   WMI_VDEV_RESTART_REQUEST_CMDID);
 	else
-		ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-					   WMI_VDEV_START_REQUEST_CMDID);
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+						   WMI_VDEV_START_REQUEST_CMDID);
 	 if (ret) {
 		WMI_LOGP("%s: Failed to send vdev start command", __func__);
 		qdf_nbuf_free(buf);
@@ -382,8 +382,8 @@ QDF_STATUS send_hidden_ssid_vdev_restart_cmd_tlv(wmi_unified_t wmi_handle,
 		       cmd->num_noa_descriptors *
 		       sizeof(wmi_p2p_noa_descriptor));
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_VDEV_RESTART_REQUEST_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_VDEV_RESTART_REQUEST_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		wmi_buf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -424,7 +424,7 @@ QDF_STATUS send_peer_flush_tids_cmd_tlv(wmi_unified_t wmi,
 	WMI_LOGD("%s: peer_addr %pM vdev_id %d and peer bitmap %d", __func__,
 				peer_addr, param->vdev_id,
 				param->peer_tid_bitmap);
-	if (wmi_unified_cmd_send(wmi, buf, len, WMI_PEER_FLUSH_TIDS_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi, buf, len, WMI_PEER_FLUSH_TIDS_CMDID)) {
 		WMI_LOGP("%s: Failed to send flush tid command", __func__);
 		qdf_nbuf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -461,7 +461,7 @@ QDF_STATUS send_peer_delete_cmd_tlv(wmi_unified_t wmi,
 	WMI_CHAR_ARRAY_TO_MAC_ADDR(peer_addr, &cmd->peer_macaddr);
 	cmd->vdev_id = vdev_id;
 
-	if (wmi_unified_cmd_send(wmi, buf, len, WMI_PEER_DELETE_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi, buf, len, WMI_PEER_DELETE_CMDID)) {
 		WMI_LOGP("%s: Failed to send peer delete command", __func__);
 		qdf_nbuf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -501,9 +501,9 @@ QDF_STATUS send_peer_param_cmd_tlv(wmi_unified_t wmi,
 	WMI_CHAR_ARRAY_TO_MAC_ADDR(peer_addr, &cmd->peer_macaddr);
 	cmd->param_id = param->param_id;
 	cmd->param_value = param->param_value;
-	err = wmi_unified_cmd_send(wmi, buf,
-				   sizeof(wmi_peer_set_param_cmd_fixed_param),
-				   WMI_PEER_SET_PARAM_CMDID);
+	err = wmi_unified_cmd_send_trusted(wmi, buf,
+					   sizeof(wmi_peer_set_param_cmd_fixed_param),
+					   WMI_PEER_SET_PARAM_CMDID);
 	if (err) {
 		WMI_LOGE("Failed to send set_param cmd");
 		qdf_mem_free(buf);
@@ -544,7 +544,7 @@ QDF_STATUS send_vdev_up_cmd_tlv(wmi_unified_t wmi,
 	cmd->vdev_id = params->vdev_id;
 	cmd->vdev_assoc_id = params->assoc_id;
 	WMI_CHAR_ARRAY_TO_MAC_ADDR(bssid, &cmd->vdev_bssid);
-	if (wmi_unified_cmd_send(wmi, buf, len, WMI_VDEV_UP_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi, buf, len, WMI_VDEV_UP_CMDID)) {
 		WMI_LOGP("%s: Failed to send vdev up command", __func__);
 		qdf_nbuf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -583,7 +583,7 @@ QDF_STATUS send_peer_create_cmd_tlv(wmi_unified_t wmi,
 	cmd->peer_type = param->peer_type;
 	cmd->vdev_id = param->vdev_id;
 
-	if (wmi_unified_cmd_send(wmi, buf, len, WMI_PEER_CREATE_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi, buf, len, WMI_PEER_CREATE_CMDID)) {
 		WMI_LOGP("%s: failed to send WMI_PEER_CREATE_CMDID", __func__);
 		qdf_nbuf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -625,8 +625,8 @@ QDF_STATUS send_green_ap_ps_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->pdev_id = 0;
 	cmd->enable = value;
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_PDEV_GREEN_AP_PS_ENABLE_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_PDEV_GREEN_AP_PS_ENABLE_CMDID)) {
 		WMI_LOGE("Set Green AP PS param Failed val %d", value);
 		qdf_nbuf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -705,10 +705,10 @@ send_pdev_utf_cmd_tlv(wmi_unified_t wmi_handle,
 		memcpy(cmd, &segHdrInfo, sizeof(segHdrInfo));   /* 4 bytes */
 		memcpy(&cmd[sizeof(segHdrInfo)], bufpos, chunk_len);
 
-		ret = wmi_unified_cmd_send(wmi_handle, buf,
-					   (chunk_len + sizeof(segHdrInfo) +
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+						   (chunk_len + sizeof(segHdrInfo) +
 					    WMI_TLV_HDR_SIZE),
-					   WMI_PDEV_UTF_CMDID);
+						   WMI_PDEV_UTF_CMDID);
 
 		if (QDF_IS_STATUS_ERROR(ret)) {
 			WMI_LOGE("Failed to send WMI_PDEV_UTF_CMDID command");
@@ -758,8 +758,8 @@ send_pdev_param_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->param_value = param->param_value;
 	WMI_LOGD("Setting pdev param = %x, value = %u", param->param_id,
 				param->param_value);
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_PDEV_SET_PARAM_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_PDEV_SET_PARAM_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send set param command ret = %d", ret);
 		wmi_buf_free(buf);
@@ -802,7 +802,7 @@ QDF_STATUS send_suspend_cmd_tlv(wmi_unified_t wmi_handle,
 		cmd->suspend_opt = WMI_PDEV_SUSPEND_AND_DISABLE_INTR;
 	else
 		cmd->suspend_opt = WMI_PDEV_SUSPEND;
-	ret = wmi_unified_cmd_send(wmi_handle, wmibuf, len,
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, wmibuf, len,
 				 WMI_PDEV_SUSPEND_CMDID);
 	if (ret) {
 		qdf_nbuf_free(wmibuf);
@@ -835,8 +835,8 @@ QDF_STATUS send_resume_cmd_tlv(wmi_unified_t wmi_handle,
 		       WMITLV_GET_STRUCT_TLVLEN
 			       (wmi_pdev_resume_cmd_fixed_param));
 	cmd->pdev_id = WMI_PDEV_ID_SOC;
-	ret = wmi_unified_cmd_send(wmi_handle, wmibuf, sizeof(*cmd),
-				   WMI_PDEV_RESUME_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, wmibuf, sizeof(*cmd),
+					   WMI_PDEV_RESUME_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send WMI_PDEV_RESUME_CMDID command");
 		wmi_buf_free(wmibuf);
@@ -884,8 +884,8 @@ QDF_STATUS send_wow_enable_cmd_tlv(wmi_unified_t wmi_handle,
 		cmd->pause_iface_config == WOW_IFACE_PAUSE_ENABLED ?
 		"WOW_IFACE_PAUSE_ENABLED" : "WOW_IFACE_PAUSE_DISABLED");
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_WOW_ENABLE_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_WOW_ENABLE_CMDID);
 	if (ret)
 		wmi_buf_free(buf);
 
@@ -922,8 +922,8 @@ QDF_STATUS send_set_ap_ps_param_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_CHAR_ARRAY_TO_MAC_ADDR(peer_addr, &cmd->peer_macaddr);
 	cmd->param = param->param;
 	cmd->value = param->value;
-	err = wmi_unified_cmd_send(wmi_handle, buf,
-				   sizeof(*cmd), WMI_AP_PS_PEER_PARAM_CMDID);
+	err = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					   sizeof(*cmd), WMI_AP_PS_PEER_PARAM_CMDID);
 	if (err) {
 		WMI_LOGE("Failed to send set_ap_ps_param cmd");
 		qdf_mem_free(buf);
@@ -963,8 +963,8 @@ QDF_STATUS send_set_sta_ps_param_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->param = param->param;
 	cmd->value = param->value;
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_STA_POWERSAVE_PARAM_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_STA_POWERSAVE_PARAM_CMDID)) {
 		WMI_LOGE("Set Sta Ps param Failed vdevId %d Param %d val %d",
 			 param->vdev_id, param->param, param->value);
 		qdf_nbuf_free(buf);
@@ -1003,7 +1003,7 @@ QDF_STATUS send_crash_inject_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->type = param->type;
 	cmd->delay_time_ms = param->delay_time_ms;
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 		WMI_FORCE_FW_HANG_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send set param command, ret = %d",
@@ -1067,8 +1067,8 @@ send_dbglog_cmd_tlv(wmi_unified_t wmi_handle,
 		}
 	}
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_DBGLOG_CFG_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_DBGLOG_CFG_CMDID);
 
 	if (status != A_OK)
 		qdf_nbuf_free(buf);
@@ -1107,8 +1107,8 @@ QDF_STATUS send_vdev_set_param_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->param_value = param->param_value;
 	WMI_LOGD("Setting vdev %d param = %x, value = %u",
 		 param->if_id, param->param_id, param->param_value);
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_VDEV_SET_PARAM_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_VDEV_SET_PARAM_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send set param command ret = %d", ret);
 		wmi_buf_free(buf);
@@ -1147,7 +1147,7 @@ QDF_STATUS send_stats_request_cmd_tlv(wmi_unified_t wmi_handle,
 			       (wmi_request_stats_cmd_fixed_param));
 	cmd->stats_id = param->stats_id;
 	cmd->vdev_id = param->vdev_id;
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 					 WMI_REQUEST_STATS_CMDID);
 	if (ret) {
 		WMI_LOGE("Failed to send status request to fw =%d", ret);
@@ -1236,8 +1236,8 @@ QDF_STATUS send_beacon_send_cmd_tlv(wmi_unified_t wmi_handle,
 	buf_ptr += WMI_TLV_HDR_SIZE;
 	qdf_mem_copy(buf_ptr, param->frm, param->tmpl_len);
 
-	ret = wmi_unified_cmd_send(wmi_handle,
-				   wmi_buf, wmi_buf_len, WMI_BCN_TMPL_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle,
+					   wmi_buf, wmi_buf_len, WMI_BCN_TMPL_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send bcn tmpl: %d", __func__, ret);
 		wmi_buf_free(wmi_buf);
@@ -1298,8 +1298,8 @@ QDF_STATUS send_beacon_tmpl_send_cmd_tlv(wmi_unified_t wmi_handle,
 	buf_ptr += WMI_TLV_HDR_SIZE;
 	qdf_mem_copy(buf_ptr, param->frm, param->tmpl_len);
 
-	ret = wmi_unified_cmd_send(wmi_handle,
-				   wmi_buf, wmi_buf_len, WMI_BCN_TMPL_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle,
+					   wmi_buf, wmi_buf_len, WMI_BCN_TMPL_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send bcn tmpl: %d", __func__, ret);
 		wmi_buf_free(wmi_buf);
@@ -1408,8 +1408,8 @@ QDF_STATUS send_peer_assoc_cmd_tlv(wmi_unified_t wmi_handle,
 		 cmd->peer_mpdu_density,
 		 cmd->peer_vht_caps);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_PEER_ASSOC_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_PEER_ASSOC_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGP("%s: Failed to send peer assoc command ret = %d",
 			 __func__, ret);
@@ -1536,7 +1536,7 @@ QDF_STATUS send_scan_start_cmd_tlv(wmi_unified_t wmi_handle,
 	}
 	buf_ptr += WMI_TLV_HDR_SIZE + params->ie_len_with_pad;
 
-	ret = wmi_unified_cmd_send(wmi_handle, wmi_buf,
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf,
 				      len, WMI_START_SCAN_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to start scan: %d", __func__, ret);
@@ -1581,7 +1581,7 @@ QDF_STATUS send_scan_stop_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->scan_id = param->scan_id;
 	/* stop the scan with the corresponding scan_id */
 	cmd->req_type = param->req_type;
-	ret = wmi_unified_cmd_send(wmi_handle, wmi_buf,
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf,
 				      len, WMI_STOP_SCAN_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send stop scan: %d", __func__, ret);
@@ -1657,7 +1657,7 @@ QDF_STATUS send_scan_chan_list_cmd_tlv(wmi_unified_t wmi_handle,
 		chan_info++;
 	}
 
-	qdf_status = wmi_unified_cmd_send(wmi_handle, buf, len,
+	qdf_status = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				      WMI_SCAN_CHAN_LIST_CMDID);
 
 	if (QDF_IS_STATUS_ERROR(qdf_status)) {
@@ -1724,7 +1724,7 @@ QDF_STATUS send_scan_chan_list_cmd_tlv(wmi_unified_t wmi_handle,
 		chan_info++;
 	}
 
-	qdf_status = wmi_unified_cmd_send(wmi_handle, buf, len,
+	qdf_status = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				      WMI_SCAN_CHAN_LIST_CMDID);
 
 	if (QDF_IS_STATUS_ERROR(qdf_status)) {
@@ -1792,7 +1792,7 @@ QDF_STATUS send_mgmt_cmd_tlv(wmi_unified_t wmi_handle,
 	wmi_mgmt_cmd_record(wmi_handle, WMI_MGMT_TX_SEND_CMDID,
 			bufp, cmd->vdev_id, cmd->chanfreq);
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, cmd_len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, cmd_len,
 				      WMI_MGMT_TX_SEND_CMDID)) {
 		WMI_LOGE("%s: Failed to send mgmt Tx", __func__);
 		goto err1;
@@ -1832,7 +1832,7 @@ QDF_STATUS send_modem_power_state_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->modem_power_state = param_value;
 	WMI_LOGD("%s: Setting cmd->modem_power_state = %u", __func__,
 		 param_value);
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				     WMI_MODEM_POWER_STATE_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send notify cmd ret = %d", ret);
@@ -1875,8 +1875,8 @@ QDF_STATUS send_set_sta_ps_mode_cmd_tlv(wmi_unified_t wmi_handle,
 	else
 		cmd->sta_ps_mode = WMI_STA_PS_MODE_DISABLED;
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_STA_POWERSAVE_MODE_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_STA_POWERSAVE_MODE_CMDID)) {
 		WMI_LOGE("Set Sta Mode Ps Failed vdevId %d val %d",
 			 vdev_id, val);
 		qdf_nbuf_free(buf);
@@ -1938,8 +1938,8 @@ QDF_STATUS send_set_mimops_cmd_tlv(wmi_unified_t wmi_handle,
 
 	WMI_LOGD("Setting vdev %d value = %u", vdev_id, value);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_STA_SMPS_FORCE_MODE_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_STA_SMPS_FORCE_MODE_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send set Mimo PS ret = %d", ret);
 		wmi_buf_free(buf);
@@ -1983,8 +1983,8 @@ QDF_STATUS send_set_smps_params_cmd_tlv(wmi_unified_t wmi_handle, uint8_t vdev_i
 	WMI_LOGD("Setting vdev %d value = %x param %x", vdev_id, cmd->value,
 		 cmd->param);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_STA_SMPS_PARAM_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_STA_SMPS_PARAM_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send set Mimo PS ret = %d", ret);
 		wmi_buf_free(buf);
@@ -2048,8 +2048,8 @@ QDF_STATUS send_set_p2pgo_noa_req_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGI("SET P2P GO NOA:vdev_id:%d count:%d duration:%d interval:%d",
 		 cmd->vdev_id, noa->count, noa_discriptor->duration,
 		 noa->interval);
-	status = wmi_unified_cmd_send(wmi_handle, buf, len,
-				      WMI_FWTEST_P2P_SET_NOA_PARAM_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					      WMI_FWTEST_P2P_SET_NOA_PARAM_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("Failed to send WMI_FWTEST_P2P_SET_NOA_PARAM_CMDID");
 		wmi_buf_free(buf);
@@ -2095,8 +2095,8 @@ QDF_STATUS send_set_p2pgo_oppps_req_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_UNIFIED_OPPPS_ATTR_CTWIN_SET(cmd, oppps->ctwindow);
 	WMI_LOGI("SET P2P GO OPPPS:vdev_id:%d ctwindow:%d",
 		 cmd->vdev_id, oppps->ctwindow);
-	status = wmi_unified_cmd_send(wmi_handle, buf, sizeof(*cmd),
-				      WMI_P2P_SET_OPPPS_PARAM_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf, sizeof(*cmd),
+					      WMI_P2P_SET_OPPPS_PARAM_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("Failed to send WMI_P2P_SET_OPPPS_PARAM_CMDID");
 		wmi_buf_free(buf);
@@ -2139,8 +2139,8 @@ QDF_STATUS send_get_temperature_cmd_tlv(wmi_unified_t wmi_handle)
 		       WMITLV_GET_STRUCT_TLVLEN
 			       (wmi_pdev_get_temperature_cmd_fixed_param));
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_PDEV_GET_TEMPERATURE_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_PDEV_GET_TEMPERATURE_CMDID)) {
 		WMI_LOGE(FL("failed to send get temperature command"));
 		wmi_buf_free(wmi_buf);
 		return QDF_STATUS_E_FAILURE;
@@ -2211,8 +2211,8 @@ QDF_STATUS send_set_sta_uapsd_auto_trig_cmd_tlv(wmi_unified_t wmi_handle,
 				       (wmi_sta_uapsd_auto_trig_param));
 	}
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, cmd_len,
-				   WMI_STA_UAPSD_AUTO_TRIG_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, cmd_len,
+					   WMI_STA_UAPSD_AUTO_TRIG_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send set uapsd param ret = %d", ret);
 		wmi_buf_free(buf);
@@ -2257,8 +2257,8 @@ QDF_STATUS send_ocb_set_utc_time_cmd_tlv(wmi_unified_t wmi_handle,
 	for (i = 0; i < SIZE_UTC_TIME_ERROR; i++)
 		WMI_TIME_ERROR_SET(cmd, i, utc->time_error[i]);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_OCB_SET_UTC_TIME_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_OCB_SET_UTC_TIME_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE(FL("Failed to set OCB UTC time"));
 		wmi_buf_free(buf);
@@ -2320,8 +2320,8 @@ QDF_STATUS send_ocb_start_timing_advert_cmd_tlv(wmi_unified_t wmi_handle,
 		     (uint8_t *)timing_advert->template_value,
 		     timing_advert->template_length);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_OCB_START_TIMING_ADVERT_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_OCB_START_TIMING_ADVERT_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE(FL("Failed to start OCB timing advert"));
 		wmi_buf_free(buf);
@@ -2363,8 +2363,8 @@ QDF_STATUS send_ocb_stop_timing_advert_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->vdev_id = timing_advert->vdev_id;
 	cmd->channel_freq = timing_advert->chan_freq;
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_OCB_STOP_TIMING_ADVERT_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_OCB_STOP_TIMING_ADVERT_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE(FL("Failed to stop OCB timing advert"));
 		wmi_buf_free(buf);
@@ -2406,8 +2406,8 @@ QDF_STATUS send_ocb_get_tsf_timer_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->vdev_id = vdev_id;
 
 	/* Send the WMI command */
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_OCB_GET_TSF_TIMER_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_OCB_GET_TSF_TIMER_CMDID);
 	/* If there is an error, set the completion event */
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE(FL("Failed to send WMI message: %d"), ret);
@@ -2480,8 +2480,8 @@ QDF_STATUS send_dcc_get_stats_cmd_tlv(wmi_unified_t wmi_handle,
 			    wmi_dcc_channel_stats_request));
 
 	/* Send the WMI command */
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_DCC_GET_STATS_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_DCC_GET_STATS_CMDID);
 
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE(FL("Failed to send WMI message: %d"), ret);
@@ -2531,8 +2531,8 @@ QDF_STATUS send_dcc_clear_stats_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->dcc_stats_bitmap = dcc_stats_bitmap;
 
 	/* Send the WMI command */
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_DCC_CLEAR_STATS_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_DCC_CLEAR_STATS_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE(FL("Failed to send the WMI command"));
 		wmi_buf_free(buf);
@@ -2635,7 +2635,7 @@ QDF_STATUS send_dcc_update_ndl_cmd_tlv(wmi_unified_t wmi_handle,
 	buf_ptr += update_ndl_param->dcc_ndl_active_state_list_len;
 
 	/* Send the WMI command */
-	qdf_status = wmi_unified_cmd_send(wmi_handle, buf, len,
+	qdf_status = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				   WMI_DCC_UPDATE_NDL_CMDID);
 	/* If there is an error, set the completion event */
 	if (QDF_IS_STATUS_ERROR(qdf_status)) {
@@ -2843,8 +2843,8 @@ QDF_STATUS send_ocb_set_config_cmd_tlv(wmi_unified_t wmi_handle,
 	}
 
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_OCB_SET_CONFIG_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_OCB_SET_CONFIG_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to set OCB config");
 		wmi_buf_free(buf);
@@ -2887,8 +2887,8 @@ QDF_STATUS send_set_enable_disable_mcc_adaptive_scheduler_cmd_tlv(
 	cmd->enable = mcc_adaptive_scheduler;
 	cmd->pdev_id = pdev_id;
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_RESMGR_ADAPTIVE_OCS_ENABLE_DISABLE_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_RESMGR_ADAPTIVE_OCS_ENABLE_DISABLE_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGP("%s: Failed to send enable/disable MCC"
 			 " adaptive scheduler command", __func__);
@@ -2961,8 +2961,8 @@ QDF_STATUS send_set_mcc_channel_time_latency_cmd_tlv(wmi_unified_t wmi_handle,
 	chan_latency.chan_mhz = chan1_freq;
 	chan_latency.latency = latency_chan1;
 	qdf_mem_copy(buf_ptr, &chan_latency, sizeof(chan_latency));
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_RESMGR_SET_CHAN_LATENCY_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_RESMGR_SET_CHAN_LATENCY_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("%s: Failed to send MCC Channel Time Latency command",
 			 __func__);
@@ -3047,8 +3047,8 @@ QDF_STATUS send_set_mcc_channel_time_quota_cmd_tlv(wmi_unified_t wmi_handle,
 	chan_quota.channel_time_quota = quota_chan2;
 	qdf_mem_copy(buf_ptr, &chan_quota, sizeof(chan_quota));
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_RESMGR_SET_CHAN_TIME_QUOTA_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_RESMGR_SET_CHAN_TIME_QUOTA_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send MCC Channel Time Quota command");
 		qdf_nbuf_free(buf);
@@ -3098,8 +3098,8 @@ QDF_STATUS send_set_thermal_mgmt_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGE("TM Sending thermal mgmt cmd: low temp %d, upper temp %d, enabled %d",
 		cmd->lower_thresh_degreeC, cmd->upper_thresh_degreeC, cmd->enable);
 
-	status = wmi_unified_cmd_send(wmi_handle, buf, len,
-				      WMI_THERMAL_MGMT_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					      WMI_THERMAL_MGMT_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		qdf_nbuf_free(buf);
 		WMI_LOGE("%s:Failed to send thermal mgmt command", __func__);
@@ -3182,7 +3182,7 @@ QDF_STATUS send_lro_config_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD("WMI_LRO_CONFIG: lro_enable %d, tcp_flag 0x%x",
 		cmd->lro_enable, cmd->tcp_flag_u32);
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
 		 sizeof(*cmd), WMI_LRO_CONFIG_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		qdf_nbuf_free(buf);
@@ -3247,7 +3247,7 @@ QDF_STATUS send_peer_rate_report_cmd_tlv(wmi_unified_t wmi_handle,
 		 cmd->enable_rate_report,
 		 cmd->report_backoff_time, cmd->report_timer_period);
 
-	status = wmi_unified_cmd_send(wmi_handle, buf, len,
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 			WMI_PEER_SET_RATE_REPORT_CONDITION_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		qdf_nbuf_free(buf);
@@ -3288,7 +3288,7 @@ QDF_STATUS send_bcn_buf_ll_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->frag_ptr = param->frag_ptr;
 	cmd->dtim_flag = param->dtim_flag;
 
-	ret = wmi_unified_cmd_send(wmi_handle, wmi_buf, sizeof(*cmd),
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, sizeof(*cmd),
 				      WMI_PDEV_SEND_BCN_CMDID);
 
 	if (QDF_IS_STATUS_ERROR(ret)) {
@@ -3339,8 +3339,8 @@ QDF_STATUS send_set_sta_sa_query_param_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD(FL("STA sa query: vdev_id:%d interval:%u retry count:%d"),
 		 vdev_id, retry_interval, max_retries);
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_PMF_OFFLOAD_SET_SA_QUERY_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_PMF_OFFLOAD_SET_SA_QUERY_CMDID)) {
 		WMI_LOGE(FL("Failed to offload STA SA Query"));
 		qdf_nbuf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -3414,7 +3414,7 @@ QDF_STATUS send_set_sta_keep_alive_cmd_tlv(wmi_unified_t wmi_handle,
 		cmd->method = WMI_STA_KEEPALIVE_METHOD_NULL_FRAME;
 	}
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				 WMI_STA_KEEPALIVE_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to set KeepAlive");
@@ -3468,8 +3468,8 @@ QDF_STATUS send_vdev_set_gtx_cfg_cmd_tlv(wmi_unified_t wmi_handle, uint32_t if_i
 		 cmd->userGtxMask, cmd->gtxPERThreshold, cmd->gtxPERMargin,
 		 cmd->gtxTPCstep, cmd->gtxTPCMin, cmd->gtxBWMask);
 
-	return wmi_unified_cmd_send(wmi_handle, buf, len,
-				    WMI_VDEV_SET_GTX_PARAMS_CMDID);
+	return wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					    WMI_VDEV_SET_GTX_PARAMS_CMDID);
 }
 
 /**
@@ -3521,8 +3521,8 @@ QDF_STATUS send_process_update_edca_param_cmd_tlv(wmi_unified_t wmi_handle,
 		wmm_param->no_ack = twmm_param->no_ack;
 	}
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_VDEV_SET_WMM_PARAMS_CMDID))
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_VDEV_SET_WMM_PARAMS_CMDID))
 		goto fail;
 
 	return QDF_STATUS_SUCCESS;
@@ -3596,8 +3596,8 @@ QDF_STATUS send_probe_rsp_tmpl_send_cmd_tlv(wmi_unified_t wmi_handle,
 	buf_ptr += WMI_TLV_HDR_SIZE;
 	qdf_mem_copy(buf_ptr, frm, tmpl_len);
 
-	ret = wmi_unified_cmd_send(wmi_handle,
-				   wmi_buf, wmi_buf_len, WMI_PRB_TMPL_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle,
+					   wmi_buf, wmi_buf_len, WMI_PRB_TMPL_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE(FL("Failed to send PRB RSP tmpl: %d"), ret);
 		wmi_buf_free(wmi_buf);
@@ -3697,7 +3697,7 @@ QDF_STATUS send_setup_install_key_cmd_tlv(wmi_unified_t wmi_handle,
 		     (const void *)key_params->key_data, key_params->key_len);
 	cmd->key_len = key_params->key_len;
 
-	status = wmi_unified_cmd_send(wmi_handle, buf, len,
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 					      WMI_VDEV_INSTALL_KEY_CMDID);
 	if (QDF_IS_STATUS_ERROR(status))
 		qdf_nbuf_free(buf);
@@ -3767,9 +3767,9 @@ QDF_STATUS send_p2p_go_set_beacon_ie_cmd_tlv(wmi_unified_t wmi_handle,
 
 	WMI_LOGI("%s: Sending WMI_P2P_GO_SET_BEACON_IE", __func__);
 
-	ret = wmi_unified_cmd_send(wmi_handle,
-				   wmi_buf, wmi_buf_len,
-				   WMI_P2P_GO_SET_BEACON_IE);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle,
+					   wmi_buf, wmi_buf_len,
+					   WMI_P2P_GO_SET_BEACON_IE);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send bcn tmpl: %d", ret);
 		wmi_buf_free(wmi_buf);
@@ -3826,7 +3826,7 @@ QDF_STATUS send_set_gateway_params_cmd_tlv(wmi_unified_t wmi_handle,
 	if (req->ipv6_addr_type)
 		WMI_SET_ROAM_SUBNET_CHANGE_FLAG_IP6_ENABLED(cmd->flag);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				WMI_ROAM_SUBNET_CHANGE_CONFIG_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send gw config parameter to fw, ret: %d",
@@ -3884,8 +3884,8 @@ QDF_STATUS send_set_rssi_monitoring_cmd_tlv(wmi_unified_t wmi_handle,
 		cmd->hi_rssi_breach_threshold[0] = 0;
 	}
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_RSSI_BREACH_MONITOR_CONFIG_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_RSSI_BREACH_MONITOR_CONFIG_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("Failed to send WMI_RSSI_BREACH_MONITOR_CONFIG_CMDID");
 		wmi_buf_free(buf);
@@ -3933,8 +3933,8 @@ QDF_STATUS send_scan_probe_setoui_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD("%s: wmi:oui received from hdd %08x", __func__,
 		 cmd->prob_req_oui);
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_SCAN_PROB_REQ_OUI_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_SCAN_PROB_REQ_OUI_CMDID)) {
 		WMI_LOGE("%s: failed to send command", __func__);
 		qdf_nbuf_free(wmi_buf);
 		return QDF_STATUS_E_FAILURE;
@@ -3975,8 +3975,8 @@ QDF_STATUS send_reset_passpoint_network_list_cmd_tlv(wmi_unified_t wmi_handle,
 			wmi_passpoint_config_cmd_fixed_param));
 	cmd->id = WMI_PASSPOINT_NETWORK_ID_WILDCARD;
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_PASSPOINT_LIST_CONFIG_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_PASSPOINT_LIST_CONFIG_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send reset passpoint network list wmi cmd",
 			 __func__);
@@ -4041,8 +4041,8 @@ QDF_STATUS send_set_passpoint_network_list_cmd_tlv(wmi_unified_t wmi_handle,
 		WMI_LOGD("%s: plmn: %02x:%02x:%02x", __func__,
 			cmd->plmn[0], cmd->plmn[1], cmd->plmn[2]);
 
-		ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-					   WMI_PASSPOINT_LIST_CONFIG_CMDID);
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+						   WMI_PASSPOINT_LIST_CONFIG_CMDID);
 		if (ret) {
 			WMI_LOGE("%s: Failed to send set passpoint network list wmi cmd",
 				 __func__);
@@ -4327,8 +4327,8 @@ QDF_STATUS send_roam_scan_offload_mode_cmd_tlv(wmi_unified_t wmi_handle,
 			       WMITLV_GET_STRUCT_TLVLEN(0));
 	}
 #endif /* WLAN_FEATURE_ROAM_OFFLOAD */
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_ROAM_SCAN_MODE);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_ROAM_SCAN_MODE);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE(
 		    "wmi_unified_cmd_send WMI_ROAM_SCAN_MODE returned Error %d",
@@ -4449,8 +4449,8 @@ QDF_STATUS send_roam_scan_offload_rssi_thresh_cmd_tlv(wmi_unified_t wmi_handle,
 			WMITLV_GET_STRUCT_TLVLEN
 			(wmi_roam_dense_thres_param));
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_ROAM_SCAN_RSSI_THRESHOLD);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_ROAM_SCAN_RSSI_THRESHOLD);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("cmd WMI_ROAM_SCAN_RSSI_THRESHOLD returned Error %d",
 					status);
@@ -4511,7 +4511,7 @@ QDF_STATUS send_adapt_dwelltime_params_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->adapative_lpf_weight = dwelltime_params->lpf_weight;
 	cmd->passive_monitor_interval_ms = dwelltime_params->passive_mon_intval;
 	cmd->wifi_activity_threshold_pct = dwelltime_params->wifi_act_threshold;
-	err = wmi_unified_cmd_send(wmi_handle, buf,
+	err = wmi_unified_cmd_send_trusted(wmi_handle, buf,
 			len, WMI_SCAN_ADAPTIVE_DWELL_CONFIG_CMDID);
 	if (err) {
 		WMI_LOGE("Failed to send adapt dwelltime cmd err=%d", err);
@@ -4623,7 +4623,7 @@ QDF_STATUS send_roam_scan_filter_cmd_tlv(wmi_unified_t wmi_handle,
 	buf_ptr += WMI_TLV_HDR_SIZE +
 		(roam_req->num_bssid_preferred_list * sizeof(uint32_t));
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
 		len, WMI_ROAM_FILTER_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("cmd WMI_ROAM_FILTER_CMDID returned Error %d",
@@ -4729,8 +4729,8 @@ QDF_STATUS send_set_epno_network_list_cmd_tlv(wmi_unified_t wmi_handle,
 
 	WMITLV_SET_HDR(buf_ptr, WMITLV_TAG_ARRAY_STRUC, 0);
 	buf_ptr += WMI_TLV_HDR_SIZE;
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_NETWORK_LIST_OFFLOAD_CONFIG_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_NETWORK_LIST_OFFLOAD_CONFIG_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("%s: Failed to send nlo wmi cmd", __func__);
 		wmi_buf_free(buf);
@@ -4778,7 +4778,7 @@ QDF_STATUS send_ipa_offload_control_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->vdev_id = ipa_offload->vdev_id;
 	cmd->enable = ipa_offload->enable;
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
 		WMI_IPA_OFFLOAD_ENABLE_DISABLE_CMDID)) {
 		WMI_LOGE("%s: failed to command", __func__);
 		wmi_buf_free(wmi_buf);
@@ -4821,8 +4821,8 @@ QDF_STATUS send_extscan_get_capabilities_cmd_tlv(wmi_unified_t wmi_handle,
 
 	cmd->request_id = pgetcapab->request_id;
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_EXTSCAN_GET_CAPABILITIES_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_EXTSCAN_GET_CAPABILITIES_CMDID)) {
 		WMI_LOGE("%s: failed to  command", __func__);
 		qdf_nbuf_free(wmi_buf);
 		return QDF_STATUS_E_FAILURE;
@@ -4865,8 +4865,8 @@ QDF_STATUS send_extscan_get_cached_results_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->vdev_id = pcached_results->session_id;
 	cmd->control_flags = pcached_results->flush;
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_EXTSCAN_GET_CACHED_RESULTS_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_EXTSCAN_GET_CACHED_RESULTS_CMDID)) {
 		WMI_LOGE("%s: failed to  command", __func__);
 		qdf_nbuf_free(wmi_buf);
 		return QDF_STATUS_E_FAILURE;
@@ -4924,7 +4924,7 @@ QDF_STATUS send_extscan_stop_change_monitor_cmd_tlv(wmi_unified_t wmi_handle,
 				       sizeof
 				       (wmi_extscan_wlan_change_bssid_param));
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
 			 WMI_EXTSCAN_CONFIGURE_WLAN_CHANGE_MONITOR_CMDID)) {
 		WMI_LOGE("%s: failed to  command", __func__);
 		qdf_nbuf_free(wmi_buf);
@@ -5047,7 +5047,7 @@ QDF_STATUS send_extscan_start_change_monitor_cmd_tlv(wmi_unified_t wmi_handle,
 		WMI_LOGE("%s: Failed to get buffer", __func__);
 		return QDF_STATUS_E_FAILURE;
 	}
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 		 WMI_EXTSCAN_CONFIGURE_WLAN_CHANGE_MONITOR_CMDID)) {
 		WMI_LOGE("%s: failed to send command", __func__);
 		qdf_nbuf_free(buf);
@@ -5105,8 +5105,8 @@ QDF_STATUS send_extscan_stop_hotlist_monitor_cmd_tlv(wmi_unified_t wmi_handle,
 	buf_ptr += WMI_TLV_HDR_SIZE +
 		   (hotlist_entries * sizeof(wmi_extscan_hotlist_entry));
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_EXTSCAN_CONFIGURE_HOTLIST_MONITOR_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_EXTSCAN_CONFIGURE_HOTLIST_MONITOR_CMDID)) {
 		WMI_LOGE("%s: failed to  command", __func__);
 		qdf_nbuf_free(wmi_buf);
 		return QDF_STATUS_E_FAILURE;
@@ -5147,8 +5147,8 @@ QDF_STATUS send_stop_extscan_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->request_id = pstopcmd->request_id;
 	cmd->vdev_id = pstopcmd->session_id;
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_EXTSCAN_STOP_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_EXTSCAN_STOP_CMDID)) {
 		WMI_LOGE("%s: failed to  command", __func__);
 		qdf_nbuf_free(wmi_buf);
 		return QDF_STATUS_E_FAILURE;
@@ -5426,8 +5426,8 @@ QDF_STATUS send_start_extscan_cmd_tlv(wmi_unified_t wmi_handle,
 			 "for current extscan info", __func__);
 		return QDF_STATUS_E_FAILURE;
 	}
-	if (wmi_unified_cmd_send(wmi_handle, buf,
-				 len, WMI_EXTSCAN_START_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					 len, WMI_EXTSCAN_START_CMDID)) {
 		WMI_LOGE("%s: failed to send command", __func__);
 		qdf_nbuf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -5475,8 +5475,8 @@ QDF_STATUS send_plm_stop_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->meas_token = plm->meas_token;
 	WMI_LOGD("vdev %d meas token %d", cmd->vdev_id, cmd->meas_token);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_VDEV_PLMREQ_STOP_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_VDEV_PLMREQ_STOP_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send plm stop wmi cmd", __func__);
 		wmi_buf_free(buf);
@@ -5564,8 +5564,8 @@ QDF_STATUS send_plm_start_cmd_tlv(wmi_unified_t wmi_handle,
 		buf_ptr += cmd->num_chans * sizeof(uint32_t);
 	}
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_VDEV_PLMREQ_START_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_VDEV_PLMREQ_START_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send plm start wmi cmd", __func__);
 		wmi_buf_free(buf);
@@ -5626,8 +5626,8 @@ QDF_STATUS send_pno_stop_cmd_tlv(wmi_unified_t wmi_handle, uint8_t vdev_id)
 	buf_ptr += WMI_TLV_HDR_SIZE;
 
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_NETWORK_LIST_OFFLOAD_CONFIG_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_NETWORK_LIST_OFFLOAD_CONFIG_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send nlo wmi cmd", __func__);
 		wmi_buf_free(buf);
@@ -5806,8 +5806,8 @@ QDF_STATUS send_pno_start_cmd_tlv(wmi_unified_t wmi_handle,
 	/** TODO: Discrete firmware doesn't have command/option to configure
 	 * App IE which comes from wpa_supplicant as of part PNO start request.
 	 */
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_NETWORK_LIST_OFFLOAD_CONFIG_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_NETWORK_LIST_OFFLOAD_CONFIG_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send nlo wmi cmd", __func__);
 		wmi_buf_free(buf);
@@ -5899,8 +5899,8 @@ QDF_STATUS send_set_ric_req_cmd_tlv(wmi_unified_t wmi_handle,
 	}
 	WMI_LOGI("%s: Set RIC Req is_add_ts:%d", __func__, is_add_ts);
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_ROAM_SET_RIC_REQUEST_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_ROAM_SET_RIC_REQUEST_CMDID)) {
 		WMI_LOGP("%s: Failed to send vdev Set RIC Req command",
 			 __func__);
 		if (is_add_ts)
@@ -5961,8 +5961,8 @@ QDF_STATUS send_process_ll_stats_clear_cmd_tlv(wmi_unified_t wmi_handle,
 	/* WMI_LOGD("Peer MAC Addr   : %pM",
 		 cmd->peer_macaddr); */
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_CLEAR_LINK_STATS_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_CLEAR_LINK_STATS_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send clear link stats req", __func__);
 		wmi_buf_free(buf);
@@ -6014,8 +6014,8 @@ QDF_STATUS send_process_ll_stats_set_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD("MPDU Size Thresh : %d", cmd->mpdu_size_threshold);
 	WMI_LOGD("Aggressive Gather: %d", cmd->aggressive_statistics_gathering);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_START_LINK_STATS_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_START_LINK_STATS_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send set link stats request", __func__);
 		wmi_buf_free(buf);
@@ -6073,8 +6073,8 @@ QDF_STATUS send_process_ll_stats_get_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD("Vdev ID         : %d", cmd->vdev_id);
 	WMI_LOGD("Peer MAC Addr   : %pM", addr);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_REQUEST_LINK_STATS_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_REQUEST_LINK_STATS_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send get link stats request", __func__);
 		wmi_buf_free(buf);
@@ -6118,8 +6118,8 @@ QDF_STATUS send_get_stats_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->vdev_id = get_stats_param->session_id;
 	WMI_CHAR_ARRAY_TO_MAC_ADDR(addr, &cmd->peer_macaddr);
 	WMI_LOGD("STATS REQ VDEV_ID:%d-->", cmd->vdev_id);
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_REQUEST_STATS_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_REQUEST_STATS_CMDID)) {
 
 		WMI_LOGE("%s: Failed to send WMI_REQUEST_STATS_CMDID",
 			 __func__);
@@ -6193,8 +6193,8 @@ QDF_STATUS send_snr_cmd_tlv(wmi_unified_t wmi_handle, uint8_t vdev_id)
 		       WMITLV_GET_STRUCT_TLVLEN
 			       (wmi_request_stats_cmd_fixed_param));
 	cmd->stats_id = WMI_REQUEST_VDEV_STAT;
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_REQUEST_STATS_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_REQUEST_STATS_CMDID)) {
 		WMI_LOGE("Failed to send host stats request to fw");
 		wmi_buf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -6230,8 +6230,8 @@ QDF_STATUS send_link_status_req_cmd_tlv(wmi_unified_t wmi_handle,
 			       (wmi_request_stats_cmd_fixed_param));
 	cmd->stats_id = WMI_REQUEST_VDEV_RATE_STAT;
 	cmd->vdev_id = link_status->session_id;
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_REQUEST_STATS_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_REQUEST_STATS_CMDID)) {
 		WMI_LOGE("Failed to send WMI link  status request to fw");
 		wmi_buf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -6278,8 +6278,8 @@ QDF_STATUS send_lphb_config_hbenable_cmd_tlv(wmi_unified_t wmi_handle,
 	hb_enable_fp->item = params->item;
 	hb_enable_fp->session = params->session;
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_HB_SET_ENABLE_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_HB_SET_ENABLE_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("wmi_unified_cmd_send WMI_HB_SET_ENABLE returned Error %d",
 			status);
@@ -6332,8 +6332,8 @@ QDF_STATUS send_lphb_config_tcp_params_cmd_tlv(wmi_unified_t wmi_handle,
 				   &lphb_conf_req->gateway_mac,
 				   sizeof(hb_tcp_params_fp->gateway_mac));
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_HB_SET_TCP_PARAMS_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_HB_SET_TCP_PARAMS_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("wmi_unified_cmd_send WMI_HB_SET_TCP_PARAMS returned Error %d",
 			status);
@@ -6381,8 +6381,8 @@ QDF_STATUS send_lphb_config_tcp_pkt_filter_cmd_tlv(wmi_unified_t wmi_handle,
 	       (void *)&g_hb_tcp_filter_fp->filter,
 	       WMI_WLAN_HB_MAX_FILTER_SIZE);
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_HB_SET_TCP_PKT_FILTER_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_HB_SET_TCP_PKT_FILTER_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("wmi_unified_cmd_send WMI_HB_SET_TCP_PKT_FILTER returned Error %d",
 			status);
@@ -6433,8 +6433,8 @@ QDF_STATUS send_lphb_config_udp_params_cmd_tlv(wmi_unified_t wmi_handle,
 				   &lphb_conf_req->gateway_mac,
 				   sizeof(lphb_conf_req->gateway_mac));
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_HB_SET_UDP_PARAMS_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_HB_SET_UDP_PARAMS_CMDID);
 	if (QDF_IS_STATUS_ERROR(status))
 		WMI_LOGE("wmi_unified_cmd_send WMI_HB_SET_UDP_PARAMS returned Error %d",
 			status);
@@ -6481,8 +6481,8 @@ QDF_STATUS send_lphb_config_udp_pkt_filter_cmd_tlv(wmi_unified_t wmi_handle,
 	       (void *)&lphb_conf_req->filter,
 	       WMI_WLAN_HB_MAX_FILTER_SIZE);
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_HB_SET_UDP_PKT_FILTER_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_HB_SET_UDP_PKT_FILTER_CMDID);
 	if (QDF_IS_STATUS_ERROR(status))
 		WMI_LOGE("wmi_unified_cmd_send WMI_HB_SET_UDP_PKT_FILTER returned Error %d",
 			status);
@@ -6529,8 +6529,8 @@ QDF_STATUS send_process_dhcp_ind_cmd_tlv(wmi_unified_t wmi_handle,
 				   &ta_dhcp_ind->peer_macaddr,
 				   sizeof(ta_dhcp_ind->peer_macaddr));
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_PEER_SET_PARAM_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_PEER_SET_PARAM_CMDID);
 	if (QDF_IS_STATUS_ERROR(status))
 		WMI_LOGE("%s: wmi_unified_cmd_send WMI_PEER_SET_PARAM_CMD"
 			 " returned Error %d", __func__, status);
@@ -6573,8 +6573,8 @@ QDF_STATUS send_get_link_speed_cmd_tlv(wmi_unified_t wmi_handle,
 				   sizeof(peer_macaddr));
 
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_PEER_GET_ESTIMATED_LINKSPEED_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_PEER_GET_ESTIMATED_LINKSPEED_CMDID)) {
 		WMI_LOGE("%s: failed to send link speed command", __func__);
 		qdf_nbuf_free(wmi_buf);
 		return QDF_STATUS_E_FAILURE;
@@ -6611,8 +6611,8 @@ QDF_STATUS send_egap_conf_params_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->inactivity_time = egap_params->inactivity_time;
 	cmd->wait_time = egap_params->wait_time;
 	cmd->flags = egap_params->flags;
-	err = wmi_unified_cmd_send(wmi_handle, buf,
-				   sizeof(*cmd), WMI_AP_PS_EGAP_PARAM_CMDID);
+	err = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					   sizeof(*cmd), WMI_AP_PS_EGAP_PARAM_CMDID);
 	if (err) {
 		WMI_LOGE("Failed to send ap_ps_egap cmd");
 		wmi_buf_free(buf);
@@ -6658,7 +6658,7 @@ QDF_STATUS send_fw_profiling_cmd_tlv(wmi_unified_t wmi_handle,
 		     WMITLV_GET_STRUCT_TLVLEN
 		    (wmi_wlan_profile_trigger_cmd_fixed_param));
 		prof_trig_cmd->enable = value1;
-		ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				WMI_WLAN_PROFILE_TRIGGER_CMDID);
 		if (ret) {
 			WMI_LOGE("PROFILE_TRIGGER cmd Failed with value %d",
@@ -6682,7 +6682,7 @@ QDF_STATUS send_fw_profiling_cmd_tlv(wmi_unified_t wmi_handle,
 		      WMITLV_TAG_STRUC_wmi_wlan_profile_get_prof_data_cmd_fixed_param,
 		      WMITLV_GET_STRUCT_TLVLEN
 		      (wmi_wlan_profile_get_prof_data_cmd_fixed_param));
-		ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				WMI_WLAN_PROFILE_GET_PROFILE_DATA_CMDID);
 		if (ret) {
 			WMI_LOGE("PROFILE_DATA cmd Failed for id %d value %d",
@@ -6708,7 +6708,7 @@ QDF_STATUS send_fw_profiling_cmd_tlv(wmi_unified_t wmi_handle,
 		      (wmi_wlan_profile_set_hist_intvl_cmd_fixed_param));
 		hist_intvl_cmd->profile_id = value1;
 		hist_intvl_cmd->value = value2;
-		ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				WMI_WLAN_PROFILE_SET_HIST_INTVL_CMDID);
 		if (ret) {
 			WMI_LOGE("HIST_INTVL cmd Failed for id %d value %d",
@@ -6735,7 +6735,7 @@ QDF_STATUS send_fw_profiling_cmd_tlv(wmi_unified_t wmi_handle,
 		      (wmi_wlan_profile_enable_profile_id_cmd_fixed_param));
 		profile_enable_cmd->profile_id = value1;
 		profile_enable_cmd->enable = value2;
-		ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				WMI_WLAN_PROFILE_ENABLE_PROFILE_ID_CMDID);
 		if (ret) {
 			WMI_LOGE("enable cmd Failed for id %d value %d",
@@ -6831,8 +6831,8 @@ QDF_STATUS send_wow_sta_ra_filter_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD("%s: send RA rate limit [%d] to fw vdev = %d", __func__,
 		 rate_limit_interval, vdev_id);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_WOW_ADD_WAKE_PATTERN_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_WOW_ADD_WAKE_PATTERN_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send RA rate limit to fw", __func__);
 		wmi_buf_free(buf);
@@ -6871,8 +6871,8 @@ QDF_STATUS send_nat_keepalive_en_cmd_tlv(wmi_unified_t wmi_handle, uint8_t vdev_
 		  (WMI_VDEV_IPSEC_NATKEEPALIVE_FILTER_CMD_fixed_param));
 	cmd->vdev_id = vdev_id;
 	cmd->action = IPSEC_NATKEEPALIVE_FILTER_ENABLE;
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_VDEV_IPSEC_NATKEEPALIVE_FILTER_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_VDEV_IPSEC_NATKEEPALIVE_FILTER_CMDID)) {
 		WMI_LOGP("%s: Failed to send NAT keepalive enable command",
 			 __func__);
 		wmi_buf_free(buf);
@@ -6909,8 +6909,8 @@ QDF_STATUS send_csa_offload_enable_cmd_tlv(wmi_unified_t wmi_handle,
 			       (wmi_csa_offload_enable_cmd_fixed_param));
 	cmd->vdev_id = vdev_id;
 	cmd->csa_offload_enable = WMI_CSA_OFFLOAD_ENABLE;
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_CSA_OFFLOAD_ENABLE_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_CSA_OFFLOAD_ENABLE_CMDID)) {
 		WMI_LOGP("%s: Failed to send CSA offload enable command",
 			 __func__);
 		wmi_buf_free(buf);
@@ -6952,8 +6952,8 @@ QDF_STATUS send_start_oem_data_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGI(FL("Sending OEM Data Request to target, data len %d"),
 		 data_len);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf,
-				   (data_len +
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					   (data_len +
 				    WMI_TLV_HDR_SIZE), WMI_OEM_REQ_CMDID);
 
 	if (QDF_IS_STATUS_ERROR(ret)) {
@@ -7010,8 +7010,8 @@ send_dfs_phyerr_filter_offload_en_cmd_tlv(wmi_unified_t wmi_handle,
 		 * to the firmware to disable the phyerror
 		 * filtering offload.
 		 */
-		ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-					   WMI_DFS_PHYERR_FILTER_DIS_CMDID);
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+						   WMI_DFS_PHYERR_FILTER_DIS_CMDID);
 		if (QDF_IS_STATUS_ERROR(ret)) {
 			WMI_LOGE("%s: Failed to send WMI_DFS_PHYERR_FILTER_DIS_CMDID ret=%d",
 				__func__, ret);
@@ -7045,8 +7045,8 @@ send_dfs_phyerr_filter_offload_en_cmd_tlv(wmi_unified_t wmi_handle,
 		 * to the firmware to enable the phyerror
 		 * filtering offload.
 		 */
-		ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-					   WMI_DFS_PHYERR_FILTER_ENA_CMDID);
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+						   WMI_DFS_PHYERR_FILTER_ENA_CMDID);
 
 		if (QDF_IS_STATUS_ERROR(ret)) {
 			WMI_LOGE("%s: Failed to send DFS PHYERR CMD ret=%d",
@@ -7102,8 +7102,8 @@ QDF_STATUS send_pktlog_wmi_send_cmd_tlv(wmi_unified_t wmi_handle,
 		cmd->enable = user_triggered ? WMI_PKTLOG_ENABLE_FORCE
 					: WMI_PKTLOG_ENABLE_AUTO;
 		cmd->pdev_id = WMI_PDEV_ID_SOC;
-		if (wmi_unified_cmd_send(wmi_handle, buf, len,
-					 WMI_PDEV_PKTLOG_ENABLE_CMDID)) {
+		if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+						 WMI_PDEV_PKTLOG_ENABLE_CMDID)) {
 			WMI_LOGE("failed to send pktlog enable cmdid");
 			goto wmi_send_failed;
 		}
@@ -7122,8 +7122,8 @@ QDF_STATUS send_pktlog_wmi_send_cmd_tlv(wmi_unified_t wmi_handle,
 		     WMITLV_GET_STRUCT_TLVLEN
 		     (wmi_pdev_pktlog_disable_cmd_fixed_param));
 		disable_cmd->pdev_id = WMI_PDEV_ID_SOC;
-		if (wmi_unified_cmd_send(wmi_handle, buf, len,
-					 WMI_PDEV_PKTLOG_DISABLE_CMDID)) {
+		if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+						 WMI_PDEV_PKTLOG_DISABLE_CMDID)) {
 			WMI_LOGE("failed to send pktlog disable cmdid");
 			goto wmi_send_failed;
 		}
@@ -7175,8 +7175,8 @@ QDF_STATUS send_add_wow_wakeup_event_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->is_add = enable;
 	cmd->event_bitmap = bitmap;
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_WOW_ENABLE_DISABLE_WAKE_EVENT_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_WOW_ENABLE_DISABLE_WAKE_EVENT_CMDID);
 	if (ret) {
 		WMI_LOGE("Failed to config wow wakeup event");
 		wmi_buf_free(buf);
@@ -7310,8 +7310,8 @@ QDF_STATUS send_wow_patterns_to_fw_cmd_tlv(wmi_unified_t wmi_handle,
 	buf_ptr += WMI_TLV_HDR_SIZE;
 	*(A_UINT32 *) buf_ptr = 0;
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_WOW_ADD_WAKE_PATTERN_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_WOW_ADD_WAKE_PATTERN_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to send wow ptrn to fw", __func__);
 		wmi_buf_free(buf);
@@ -7359,8 +7359,8 @@ QDF_STATUS send_wow_delete_pattern_cmd_tlv(wmi_unified_t wmi_handle, uint8_t ptr
 	WMI_LOGI("Deleting pattern id: %d vdev id %d in fw",
 		cmd->pattern_id, vdev_id);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_WOW_DEL_WAKE_PATTERN_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_WOW_DEL_WAKE_PATTERN_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to delete wow ptrn from fw", __func__);
 		wmi_buf_free(buf);
@@ -7403,8 +7403,8 @@ QDF_STATUS send_host_wakeup_ind_to_fw_cmd_tlv(wmi_unified_t wmi_handle)
 	       (wmi_wow_hostwakeup_from_sleep_cmd_fixed_param));
 
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_WOW_HOSTWAKEUP_FROM_SLEEP_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_WOW_HOSTWAKEUP_FROM_SLEEP_CMDID);
 	if (ret) {
 		WMI_LOGE("Failed to send host wakeup indication to fw");
 		wmi_buf_free(buf);
@@ -7443,8 +7443,8 @@ QDF_STATUS send_del_ts_cmd_tlv(wmi_unified_t wmi_handle, uint8_t vdev_id,
 
 	WMI_LOGD("Delts vdev:%d, ac:%d, %s:%d",
 		 cmd->vdev_id, cmd->ac, __func__, __LINE__);
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_VDEV_WMM_DELTS_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_VDEV_WMM_DELTS_CMDID)) {
 		WMI_LOGP("%s: Failed to send vdev DELTS command", __func__);
 		qdf_nbuf_free(buf);
 		return QDF_STATUS_E_FAILURE;
@@ -7553,8 +7553,8 @@ QDF_STATUS send_add_ts_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD("Addts vdev:%d, ac:%d, mediumTime:%d, downgrade_type:%d %s:%d",
 		 cmd->vdev_id, cmd->ac, cmd->medium_time_us,
 		 cmd->downgrade_type, __func__, __LINE__);
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_VDEV_WMM_ADDTS_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_VDEV_WMM_ADDTS_CMDID)) {
 		WMI_LOGP("%s: Failed to send vdev ADDTS command", __func__);
 		msg->status = QDF_STATUS_E_FAILURE;
 		qdf_nbuf_free(buf);
@@ -7603,7 +7603,7 @@ QDF_STATUS send_enable_disable_packet_filter_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGE("%s: Packet filter enable %d for vdev_id %d",
 		__func__, cmd->enable, vdev_id);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 			 WMI_PACKET_FILTER_ENABLE_CMDID);
 	if (ret)
 		WMI_LOGE("Failed to send packet filter wmi cmd to fw");
@@ -7680,7 +7680,7 @@ QDF_STATUS send_config_packet_filter_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGE("Packet filter action %d filter with id: %d, num_params=%d",
 		cmd->filter_action, cmd->filter_id, cmd->num_params);
 	/* send the command along with data */
-	err = wmi_unified_cmd_send(wmi_handle, buf, len,
+	err = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				WMI_PACKET_FILTER_CONFIG_CMDID);
 	if (err) {
 		WMI_LOGE("Failed to send pkt_filter cmd");
@@ -7727,9 +7727,9 @@ QDF_STATUS send_add_clear_mcbc_filter_cmd_tlv(wmi_unified_t wmi_handle,
 		(clearList ? WMI_MCAST_FILTER_DELETE : WMI_MCAST_FILTER_SET);
 	cmd->vdev_id = vdev_id;
 	WMI_CHAR_ARRAY_TO_MAC_ADDR(multicast_addr.bytes, &cmd->mcastbdcastaddr);
-	err = wmi_unified_cmd_send(wmi_handle, buf,
-				   sizeof(*cmd),
-				   WMI_SET_MCASTBCAST_FILTER_CMDID);
+	err = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					   sizeof(*cmd),
+					   WMI_SET_MCASTBCAST_FILTER_CMDID);
 	if (err) {
 		WMI_LOGE("Failed to send set_param cmd");
 		qdf_mem_free(buf);
@@ -7794,8 +7794,8 @@ QDF_STATUS send_gtk_offload_cmd_tlv(wmi_unified_t wmi_handle, uint8_t vdev_id,
 	}
 
 	/* send the wmi command */
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_GTK_OFFLOAD_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_GTK_OFFLOAD_CMDID)) {
 		WMI_LOGE("Failed to send WMI_GTK_OFFLOAD_CMDID");
 		wmi_buf_free(buf);
 		status = QDF_STATUS_E_FAILURE;
@@ -7844,8 +7844,8 @@ QDF_STATUS send_process_gtk_offload_getinfo_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->vdev_id = vdev_id;
 
 	/* send the wmi command */
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_GTK_OFFLOAD_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_GTK_OFFLOAD_CMDID)) {
 		WMI_LOGE("Failed to send WMI_GTK_OFFLOAD_CMDID for req info");
 		wmi_buf_free(buf);
 		status = QDF_STATUS_E_FAILURE;
@@ -7910,8 +7910,8 @@ QDF_STATUS send_process_add_periodic_tx_ptrn_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD("%s: Add ptrn id: %d vdev_id: %d",
 		 __func__, cmd->pattern_id, cmd->vdev_id);
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_ADD_PROACTIVE_ARP_RSP_PATTERN_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_ADD_PROACTIVE_ARP_RSP_PATTERN_CMDID)) {
 		WMI_LOGE("%s: failed to add pattern set state command",
 			 __func__);
 		qdf_nbuf_free(wmi_buf);
@@ -7956,8 +7956,8 @@ QDF_STATUS send_process_del_periodic_tx_ptrn_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD("%s: Del ptrn id: %d vdev_id: %d",
 		 __func__, cmd->pattern_id, cmd->vdev_id);
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_DEL_PROACTIVE_ARP_RSP_PATTERN_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_DEL_PROACTIVE_ARP_RSP_PATTERN_CMDID)) {
 		WMI_LOGE("%s: failed to send del pattern command", __func__);
 		qdf_nbuf_free(wmi_buf);
 		return QDF_STATUS_E_FAILURE;
@@ -8008,8 +8008,8 @@ QDF_STATUS send_stats_ext_req_cmd_tlv(wmi_unified_t wmi_handle,
 	buf_ptr += WMI_TLV_HDR_SIZE;
 	qdf_mem_copy(buf_ptr, preq->request_data, cmd->data_len);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_REQUEST_STATS_EXT_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_REQUEST_STATS_EXT_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("%s: Failed to send notify cmd ret = %d", __func__,
 			 ret);
@@ -8055,8 +8055,8 @@ QDF_STATUS send_enable_ext_wow_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGD("%s: vdev_id %d type %d Wakeup_pin_num %x",
 		 __func__, cmd->vdev_id, cmd->type, cmd->wakeup_pin_num);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_EXTWOW_ENABLE_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_EXTWOW_ENABLE_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to set EXTWOW Enable", __func__);
 		wmi_buf_free(buf);
@@ -8111,8 +8111,8 @@ QDF_STATUS send_app_type1_params_in_fw_cmd_tlv(wmi_unified_t wmi_handle,
 		 __func__, cmd->vdev_id, app_type1_params->wakee_mac_addr.bytes,
 		 cmd->ident, cmd->ident_len, cmd->passwd, cmd->passwd_len);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_EXTWOW_SET_APP_TYPE1_PARAMS_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_EXTWOW_SET_APP_TYPE1_PARAMS_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to set APP TYPE1 PARAMS", __func__);
 		wmi_buf_free(buf);
@@ -8191,8 +8191,8 @@ QDF_STATUS send_set_app_type2_params_in_fw_cmd_tlv(wmi_unified_t wmi_handle,
 		 cmd->keepalive_max, cmd->keepalive_inc,
 		 cmd->tcp_tx_timeout_val, cmd->tcp_rx_timeout_val);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_EXTWOW_SET_APP_TYPE2_PARAMS_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_EXTWOW_SET_APP_TYPE2_PARAMS_CMDID);
 	if (ret) {
 		WMI_LOGE("%s: Failed to set APP TYPE2 PARAMS", __func__);
 		wmi_buf_free(buf);
@@ -8238,8 +8238,8 @@ QDF_STATUS send_set_auto_shutdown_timer_cmd_tlv(wmi_unified_t wmi_handle,
 	       WMITLV_GET_STRUCT_TLVLEN
 	       (wmi_host_auto_shutdown_cfg_cmd_fixed_param));
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_HOST_AUTO_SHUTDOWN_CFG_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_HOST_AUTO_SHUTDOWN_CFG_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("%s: WMI_HOST_AUTO_SHUTDOWN_CFG_CMDID Err %d",
 			 __func__, status);
@@ -8298,8 +8298,8 @@ QDF_STATUS send_nan_req_cmd_tlv(wmi_unified_t wmi_handle,
 	buf_ptr += WMI_TLV_HDR_SIZE;
 	qdf_mem_copy(buf_ptr, nan_req->request_data, cmd->data_len);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_NAN_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_NAN_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE("%s Failed to send set param command ret = %d",
 			 __func__, ret);
@@ -8342,7 +8342,7 @@ QDF_STATUS send_process_dhcpserver_offload_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->num_client = pDhcpSrvOffloadInfo->dhcpClientNum;
 	cmd->srv_ipv4 = pDhcpSrvOffloadInfo->dhcpSrvIP;
 	cmd->start_lsb = 0;
-	status = wmi_unified_cmd_send(wmi_handle, buf,
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
 				   sizeof(*cmd),
 				   WMI_SET_DHCP_SERVER_OFFLOAD_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
@@ -8387,8 +8387,8 @@ QDF_STATUS send_set_led_flashing_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->led_x0 = flashing->led_x0;
 	cmd->led_x1 = flashing->led_x1;
 
-	status = wmi_unified_cmd_send(wmi_handle, buf, len,
-				      WMI_PDEV_SET_LED_FLASHING_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					      WMI_PDEV_SET_LED_FLASHING_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("%s: wmi_unified_cmd_send WMI_PEER_SET_PARAM_CMD"
 			 " returned Error %d", __func__, status);
@@ -8426,8 +8426,8 @@ QDF_STATUS send_process_ch_avoid_update_cmd_tlv(wmi_unified_t wmi_handle)
 		       WMITLV_GET_STRUCT_TLVLEN
 			       (wmi_chan_avoid_update_cmd_param));
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_CHAN_AVOID_UPDATE_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_CHAN_AVOID_UPDATE_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("wmi_unified_cmd_send"
 			 " WMITLV_TABLE_WMI_CHAN_AVOID_UPDATE"
@@ -8475,8 +8475,8 @@ QDF_STATUS send_regdomain_info_to_fw_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->conformance_test_limit_2G = ctl2G;
 	cmd->conformance_test_limit_5G = ctl5G;
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
-				 WMI_PDEV_SET_REGDOMAIN_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					 WMI_PDEV_SET_REGDOMAIN_CMDID)) {
 		WMI_LOGP("%s: Failed to send pdev set regdomain command",
 			 __func__);
 		qdf_nbuf_free(buf);
@@ -8539,7 +8539,7 @@ QDF_STATUS send_set_tdls_offchan_mode_cmd_tlv(wmi_unified_t wmi_handle,
 		 cmd->is_peer_responder,
 		 cmd->offchan_oper_class);
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
 		WMI_TDLS_SET_OFFCHAN_MODE_CMDID)) {
 		WMI_LOGP(FL("failed to send tdls off chan command"));
 		qdf_nbuf_free(wmi_buf);
@@ -8625,8 +8625,8 @@ QDF_STATUS send_update_fw_tdls_state_cmd_tlv(wmi_unified_t wmi_handle,
 		 cmd->teardown_notification_ms,
 		 cmd->tdls_peer_kickout_threshold);
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_TDLS_SET_STATE_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_TDLS_SET_STATE_CMDID)) {
 		WMI_LOGP("%s: failed to send tdls set state command", __func__);
 		qdf_nbuf_free(wmi_buf);
 		return QDF_STATUS_E_FAILURE;
@@ -8791,8 +8791,8 @@ QDF_STATUS send_update_tdls_peer_state_cmd_tlv(wmi_unified_t wmi_handle,
 		chan_info++;
 	}
 
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_TDLS_PEER_UPDATE_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_TDLS_PEER_UPDATE_CMDID)) {
 		WMI_LOGE("%s: failed to send tdls peer update state command",
 			 __func__);
 		qdf_nbuf_free(wmi_buf);
@@ -8884,8 +8884,8 @@ QDF_STATUS send_process_fw_mem_dump_cmd_tlv(wmi_unified_t wmi_handle,
 		dump_params++;
 	}
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_GET_FW_MEM_DUMP_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_GET_FW_MEM_DUMP_CMDID);
 	if (ret) {
 		WMI_LOGE(FL("Failed to send get firmware mem dump request"));
 		wmi_buf_free(buf);
@@ -8949,8 +8949,8 @@ QDF_STATUS send_process_set_ie_info_cmd_tlv(wmi_unified_t wmi_handle,
 
 	qdf_mem_copy(buf_ptr, ie_info->data, cmd->ie_len);
 
-	ret = wmi_unified_cmd_send(wmi_handle, buf, len,
-				   WMI_VDEV_SET_IE_CMDID);
+	ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+					   WMI_VDEV_SET_IE_CMDID);
 	if (QDF_IS_STATUS_ERROR(ret)) {
 		WMI_LOGE(FL("Failed to send set IE command ret = %d"), ret);
 		wmi_buf_free(buf);
@@ -9132,7 +9132,7 @@ QDF_STATUS send_init_cmd_tlv(wmi_unified_t wmi_handle,
 			sizeof(wmi_abi_version));
 #endif
 	if (action) {
-		ret = wmi_unified_cmd_send(wmi_handle, buf, len,
+		ret = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				 WMI_INIT_CMDID);
 		if (ret) {
 			WMI_LOGE(FL("Failed to send set WMI INIT command ret = %d"), ret);
@@ -9166,7 +9166,7 @@ QDF_STATUS send_saved_init_cmd_tlv(wmi_unified_t wmi_handle)
 		WMI_LOGP("Service ready ext event w/o WMI_SERVICE_EXT_MSG!");
 		return QDF_STATUS_E_FAILURE;
 	}
-	status = wmi_unified_cmd_send(wmi_handle,
+	status = wmi_unified_cmd_send_trusted(wmi_handle,
 				wmi_handle->saved_wmi_init_cmd.buf,
 				wmi_handle->saved_wmi_init_cmd.buf_len,
 				WMI_INIT_CMDID);
@@ -9291,9 +9291,9 @@ QDF_STATUS send_set_base_macaddr_indicate_cmd_tlv(wmi_unified_t wmi_handle,
 			       (wmi_pdev_set_base_macaddr_cmd_fixed_param));
 	WMI_CHAR_ARRAY_TO_MAC_ADDR(custom_addr, &cmd->base_macaddr);
 	cmd->pdev_id = WMI_PDEV_ID_SOC;
-	err = wmi_unified_cmd_send(wmi_handle, buf,
-				   sizeof(*cmd),
-				   WMI_PDEV_SET_BASE_MACADDR_CMDID);
+	err = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					   sizeof(*cmd),
+					   WMI_PDEV_SET_BASE_MACADDR_CMDID);
 	if (err) {
 		WMI_LOGE("Failed to send set_base_macaddr cmd");
 		qdf_mem_free(buf);
@@ -9408,7 +9408,7 @@ QDF_STATUS send_log_supported_evt_cmd_tlv(wmi_unified_t wmi_handle,
 		wmi_handle->events_logs_list[i] = evt_args[i];
 	}
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, buf_len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, buf_len,
 				WMI_DIAG_EVENT_LOG_CONFIG_CMDID)) {
 		WMI_LOGE("%s: WMI_DIAG_EVENT_LOG_CONFIG_CMDID failed",
 				__func__);
@@ -9505,7 +9505,7 @@ QDF_STATUS send_enable_specific_fw_logs_cmd_tlv(wmi_unified_t wmi_handle,
 		}
 	}
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				WMI_DIAG_EVENT_LOG_CONFIG_CMDID)) {
 		WMI_LOGE("%s: WMI_DIAG_EVENT_LOG_CONFIG_CMDID failed",
 				__func__);
@@ -9545,7 +9545,7 @@ QDF_STATUS send_flush_logs_to_fw_cmd_tlv(wmi_unified_t wmi_handle)
 				wmi_debug_mesg_flush_fixed_param));
 	cmd->reserved0 = 0;
 
-	ret = wmi_unified_cmd_send(wmi_handle,
+	ret = wmi_unified_cmd_send_trusted(wmi_handle,
 			buf,
 			len,
 			WMI_DEBUG_MESG_FLUSH_CMDID);
@@ -9617,7 +9617,7 @@ QDF_STATUS send_pdev_set_pcl_cmd_tlv(wmi_unified_t wmi_handle,
 		WMI_LOGI("%s: chan:%d weight:%d", __func__,
 			msg->saved_chan_list[i], cmd_args[i]);
 	}
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				WMI_PDEV_SET_PCL_CMDID)) {
 		WMI_LOGE("%s: Failed to send WMI_PDEV_SET_PCL_CMDID", __func__);
 		qdf_nbuf_free(buf);
@@ -9664,7 +9664,7 @@ QDF_STATUS send_pdev_set_hw_mode_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd->hw_mode_index = hw_mode_index;
 	WMI_LOGI("%s: HW mode index:%d", __func__, cmd->hw_mode_index);
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				WMI_PDEV_SET_HW_MODE_CMDID)) {
 		WMI_LOGE("%s: Failed to send WMI_PDEV_SET_HW_MODE_CMDID",
 			__func__);
@@ -9711,7 +9711,7 @@ QDF_STATUS send_pdev_set_dual_mac_config_cmd_tlv(wmi_unified_t wmi_handle,
 	WMI_LOGI("%s: scan_config:%x fw_mode_config:%x",
 			__func__, msg->scan_config, msg->fw_mode_config);
 
-	if (wmi_unified_cmd_send(wmi_handle, buf, len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				WMI_PDEV_SET_MAC_CONFIG_CMDID)) {
 		WMI_LOGE("%s: Failed to send WMI_PDEV_SET_MAC_CONFIG_CMDID",
 				__func__);
@@ -9912,7 +9912,7 @@ QDF_STATUS send_enable_arp_ns_offload_cmd_tlv(wmi_unified_t wmi_handle,
 		}
 	}
 
-	res = wmi_unified_cmd_send(wmi_handle, buf, len,
+	res = wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
 				     WMI_SET_ARP_NS_OFFLOAD_CMDID);
 	if (res) {
 		WMI_LOGE("Failed to enable ARP NDP/NSffload");
@@ -10042,8 +10042,8 @@ QDF_STATUS send_process_roam_synch_complete_cmd_tlv(wmi_unified_t wmi_handle,
 		       WMITLV_GET_STRUCT_TLVLEN
 			       (wmi_roam_synch_complete_fixed_param));
 	cmd->vdev_id = vdev_id;
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_ROAM_SYNCH_COMPLETE)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_ROAM_SYNCH_COMPLETE)) {
 		WMI_LOGP("%s: failed to send roam synch confirmation",
 			 __func__);
 		qdf_nbuf_free(wmi_buf);
@@ -10099,8 +10099,8 @@ QDF_STATUS send_unit_test_cmd_tlv(wmi_unified_t wmi_handle,
 		unit_test_cmd_args[i] = wmi_utest->args[i];
 		WMI_LOGI("%d,", wmi_utest->args[i]);
 	}
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
-				 WMI_UNIT_TEST_CMDID)) {
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
+					 WMI_UNIT_TEST_CMDID)) {
 		WMI_LOGP("%s: failed to send unit test command", __func__);
 		qdf_nbuf_free(wmi_buf);
 		return QDF_STATUS_E_FAILURE;
@@ -10161,7 +10161,7 @@ QDF_STATUS send_roam_invoke_cmd_tlv(wmi_unified_t wmi_handle,
 				(sizeof(wmi_mac_addr)));
 	bssid_list = (wmi_mac_addr *)(buf_ptr + WMI_TLV_HDR_SIZE);
 	WMI_CHAR_ARRAY_TO_MAC_ADDR(roaminvoke->bssid, bssid_list);
-	if (wmi_unified_cmd_send(wmi_handle, wmi_buf, len,
+	if (wmi_unified_cmd_send_trusted(wmi_handle, wmi_buf, len,
 					WMI_ROAM_INVOKE_CMDID)) {
 		WMI_LOGP("%s: failed to send roam invoke command", __func__);
 		wmi_buf_free(wmi_buf);
@@ -10206,8 +10206,8 @@ QDF_STATUS send_roam_scan_offload_cmd_tlv(wmi_unified_t wmi_handle,
 	cmd_fp->vdev_id = vdev_id;
 	cmd_fp->command_arg = command;
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_ROAM_SCAN_CMD);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_ROAM_SCAN_CMD);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("wmi_unified_cmd_send WMI_ROAM_SCAN_CMD returned Error %d",
 			status);
@@ -10266,8 +10266,8 @@ QDF_STATUS send_roam_scan_offload_ap_profile_cmd_tlv(wmi_unified_t wmi_handle,
 	WMITLV_SET_HDR(buf_ptr,
 		       WMITLV_TAG_STRUC_wmi_ap_profile,
 		       WMITLV_GET_STRUCT_TLVLEN(wmi_ap_profile));
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_ROAM_AP_PROFILE);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_ROAM_AP_PROFILE);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("wmi_unified_cmd_send WMI_ROAM_AP_PROFILE returned Error %d",
 			status);
@@ -10320,8 +10320,8 @@ QDF_STATUS send_roam_scan_offload_scan_period_cmd_tlv(wmi_unified_t wmi_handle,
 	scan_period_fp->roam_scan_period = scan_period; /* 20 seconds */
 	scan_period_fp->roam_scan_age = scan_age;
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_ROAM_SCAN_PERIOD);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_ROAM_SCAN_PERIOD);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("wmi_unified_cmd_send WMI_ROAM_SCAN_PERIOD returned Error %d",
 			status);
@@ -10405,8 +10405,8 @@ QDF_STATUS send_roam_scan_offload_chan_list_cmd_tlv(wmi_unified_t wmi_handle,
 		WMI_LOGI("%d,", roam_chan_list_array[i]);
 	}
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_ROAM_CHAN_LIST);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_ROAM_CHAN_LIST);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("wmi_unified_cmd_send WMI_ROAM_CHAN_LIST returned Error %d",
 			status);
@@ -10465,8 +10465,8 @@ QDF_STATUS send_roam_scan_offload_rssi_change_cmd_tlv(wmi_unified_t wmi_handle,
 	rssi_change_fp->bcn_rssi_weight = bcn_rssi_weight;
 	rssi_change_fp->hirssi_delay_btw_scans = hirssi_delay_btw_scans;
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_ROAM_SCAN_RSSI_CHANGE_THRESHOLD);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_ROAM_SCAN_RSSI_CHANGE_THRESHOLD);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("wmi_unified_cmd_send WMI_ROAM_SCAN_RSSI_CHANGE_THRESHOLD returned Error %d",
 			status);
@@ -10619,8 +10619,8 @@ QDF_STATUS send_get_buf_extscan_hotlist_cmd_tlv(wmi_unified_t wmi_handle,
 		buf_ptr += WMI_TLV_HDR_SIZE +
 			   (min_entries * sizeof(wmi_extscan_hotlist_entry));
 
-		if (wmi_unified_cmd_send(wmi_handle, buf, len,
-					 WMI_EXTSCAN_CONFIGURE_HOTLIST_MONITOR_CMDID)) {
+		if (wmi_unified_cmd_send_trusted(wmi_handle, buf, len,
+						 WMI_EXTSCAN_CONFIGURE_HOTLIST_MONITOR_CMDID)) {
 			WMI_LOGE("%s: failed to send command", __func__);
 			qdf_nbuf_free(buf);
 			return QDF_STATUS_E_FAILURE;
@@ -10681,8 +10681,8 @@ QDF_STATUS send_power_dbg_cmd_tlv(wmi_unified_t wmi_handle,
 		WMI_LOGI("%d,", param->args[i]);
 	}
 
-	status = wmi_unified_cmd_send(wmi_handle, buf,
-				      len, WMI_PDEV_WAL_POWER_DEBUG_CMDID);
+	status = wmi_unified_cmd_send_trusted(wmi_handle, buf,
+					      len, WMI_PDEV_WAL_POWER_DEBUG_CMDID);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		WMI_LOGE("wmi_unified_cmd_send WMI_PDEV_WAL_POWER_DEBUG_CMDID returned Error %d",
 			status);
@@ -10795,7 +10795,7 @@ static QDF_STATUS init_cmd_send_tlv(wmi_unified_t wmi_handle,
 	qdf_mem_copy(&wmi_handle->final_abi_vers, &cmd->host_abi_vers,
 			sizeof(wmi_abi_version));
 #endif
-	return wmi_unified_cmd_send(wmi_handle, buf, len, WMI_INIT_CMDID);
+	return wmi_unified_cmd_send_trusted(wmi_handle, buf, len, WMI_INIT_CMDID);
 }
 
 /**
@@ -11545,6 +11545,39 @@ static QDF_STATUS extract_pdev_ext_stats_tlv(wmi_unified_t wmi_handle,
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * copy_vdev_stats_tlv() - copy one vdev stats record of a stats event
+ * @vdev_stats: host vdev stats to fill
+ * @ev: vdev stats record of the event
+ *
+ * Return: None
+ */
+static void copy_vdev_stats_tlv(wmi_host_vdev_stats *vdev_stats,
+				const wmi_vdev_stats *ev)
+{
+	vdev_stats->vdev_id = ev->vdev_id;
+	vdev_stats->vdev_snr.bcn_snr = ev->vdev_snr.bcn_snr;
+	vdev_stats->vdev_snr.dat_snr = ev->vdev_snr.dat_snr;
+
+	OS_MEMCPY(vdev_stats->tx_frm_cnt, ev->tx_frm_cnt,
+		sizeof(ev->tx_frm_cnt));
+	vdev_stats->rx_frm_cnt = ev->rx_frm_cnt;
+	OS_MEMCPY(vdev_stats->multiple_retry_cnt,
+			ev->multiple_retry_cnt,
+			sizeof(ev->multiple_retry_cnt));
+	OS_MEMCPY(vdev_stats->fail_cnt, ev->fail_cnt,
+			sizeof(ev->fail_cnt));
+	vdev_stats->rts_fail_cnt = ev->rts_fail_cnt;
+	vdev_stats->rts_succ_cnt = ev->rts_succ_cnt;
+	vdev_stats->rx_err_cnt = ev->rx_err_cnt;
+	vdev_stats->rx_discard_cnt = ev->rx_discard_cnt;
+	vdev_stats->ack_fail_cnt = ev->ack_fail_cnt;
+	OS_MEMCPY(vdev_stats->tx_rate_history, ev->tx_rate_history,
+		sizeof(ev->tx_rate_history));
+	OS_MEMCPY(vdev_stats->bcn_rssi_history, ev->bcn_rssi_history,
+		sizeof(ev->bcn_rssi_history));
+}
+
 /**
  * extract_vdev_stats_tlv() - extract vdev stats from event
  * @wmi_handle: wmi handle
@@ -11571,33 +11604,30 @@ static QDF_STATUS extract_vdev_stats_tlv(wmi_unified_t wmi_handle,
 				sizeof(wmi_pdev_stats)) +
 				(index * sizeof(wmi_vdev_stats)));
 
-		vdev_stats->vdev_id = ev->vdev_id;
-		vdev_stats->vdev_snr.bcn_snr = ev->vdev_snr.bcn_snr;
-		vdev_stats->vdev_snr.dat_snr = ev->vdev_snr.dat_snr;
-
-		OS_MEMCPY(vdev_stats->tx_frm_cnt, ev->tx_frm_cnt,
-			sizeof(ev->tx_frm_cnt));
-		vdev_stats->rx_frm_cnt = ev->rx_frm_cnt;
-		OS_MEMCPY(vdev_stats->multiple_retry_cnt,
-				ev->multiple_retry_cnt,
-				sizeof(ev->multiple_retry_cnt));
-		OS_MEMCPY(vdev_stats->fail_cnt, ev->fail_cnt,
-				sizeof(ev->fail_cnt));
-		vdev_stats->rts_fail_cnt = ev->rts_fail_cnt;
-		vdev_stats->rts_succ_cnt = ev->rts_succ_cnt;
-		vdev_stats->rx_err_cnt = ev->rx_err_cnt;
-		vdev_stats->rx_discard_cnt = ev->rx_discard_cnt;
-		vdev_stats->ack_fail_cnt = ev->ack_fail_cnt;
-		OS_MEMCPY(vdev_stats->tx_rate_history, ev->tx_rate_history,
-			sizeof(ev->tx_rate_history));
-		OS_MEMCPY(vdev_stats->bcn_rssi_history, ev->bcn_rssi_history,
-			sizeof(ev->bcn_rssi_history));
-
+		copy_vdev_stats_tlv(vdev_stats, ev);
 	}
 
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * copy_peer_stats_tlv() - copy one peer stats record of a stats event
+ * @peer_stats: host peer stats to fill
+ * @ev: peer stats record of the event
+ *
+ * Return: None
+ */
+static void copy_peer_stats_tlv(wmi_host_peer_stats *peer_stats,
+				const wmi_peer_stats *ev)
+{
+	OS_MEMCPY(&(peer_stats->peer_macaddr),
+		&(ev->peer_macaddr), sizeof(wmi_mac_addr));
+
+	peer_stats->peer_rssi = ev->peer_rssi;
+	peer_stats->peer_tx_rate = ev->peer_tx_rate;
+	peer_stats->peer_rx_rate = ev->peer_rx_rate;
+}
+
 /**
  * extract_peer_stats_tlv() - extract peer stats from event
  * @wmi_handle: wmi handle
@@ -11626,12 +11656,7 @@ static QDF_STATUS extract_peer_stats_tlv(wmi_unified_t wmi_handle,
 
 		OS_MEMSET(peer_stats, 0, sizeof(wmi_host_peer_stats));
 
-		OS_MEMCPY(&(peer_stats->peer_macaddr),
-			&(ev->peer_macaddr), sizeof(wmi_mac_addr));
-
-		peer_stats->peer_rssi = ev->peer_rssi;
-		peer_stats->peer_tx_rate = ev->peer_tx_rate;
-		peer_stats->peer_rx_rate = ev->peer_rx_rate;
+		copy_peer_stats_tlv(peer_stats, ev);
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -11668,6 +11693,23 @@ static QDF_STATUS extract_peer_extd_stats_tlv(wmi_unified_t wmi_handle,
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * copy_chan_stats_tlv() - copy one chan stats record of a stats event
+ * @chan_stats: host chan stats to fill
+ * @ev: chan stats record of the event
+ *
+ * Return: None
+ */
+static void copy_chan_stats_tlv(wmi_host_chan_stats *chan_stats,
+				const wmi_chan_stats *ev)
+{
+	chan_stats->chan_mhz = ev->chan_mhz;
+	chan_stats->sampling_period_us = ev->sampling_period_us;
+	chan_stats->rx_clear_count = ev->rx_clear_count;
+	chan_stats->tx_duration_us = ev->tx_duration_us;
+	chan_stats->rx_duration_us = ev->rx_duration_us;
+}
+
 /**
  * extract_chan_stats_tlv() - extract chan stats from event
  * @wmi_handle: wmi handle
@@ -11697,16 +11739,164 @@ static QDF_STATUS extract_chan_stats_tlv(wmi_unified_t wmi_handle,
 
 
 		/* Non-TLV doesnt have num_chan_stats */
-		chan_stats->chan_mhz = ev->chan_mhz;
-		chan_stats->sampling_period_us = ev->sampling_period_us;
-		chan_stats->rx_clear_count = ev->rx_clear_count;
-		chan_stats->tx_duration_us = ev->tx_duration_us;
-		chan_stats->rx_duration_us = ev->rx_duration_us;
+		copy_chan_stats_tlv(chan_stats, ev);
 	}
 
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * extract_stats_view_tlv() - locate the stats arrays of a stats event
+ * @wmi_handle: wmi handle
+ * @param evt_buf: pointer to event buffer
+ * @param view: Pointer to hold the array locations and counts
+ *
+ * Return: QDF_STATUS_SUCCESS for success or error code
+ */
+static QDF_STATUS extract_stats_view_tlv(wmi_unified_t wmi_handle,
+	void *evt_buf, struct wmi_host_stats_view *view)
+{
+	WMI_UPDATE_STATS_EVENTID_param_tlvs *param_buf;
+	wmi_stats_event_fixed_param *ev_param;
+
+	param_buf = (WMI_UPDATE_STATS_EVENTID_param_tlvs *) evt_buf;
+	ev_param = (wmi_stats_event_fixed_param *) param_buf->fixed_param;
+	if (!ev_param)
+		return QDF_STATUS_E_FAILURE;
+
+	view->num_pdev_stats = ev_param->num_pdev_stats;
+	view->num_vdev_stats = ev_param->num_vdev_stats;
+	view->num_peer_stats = ev_param->num_peer_stats;
+	view->num_chan_stats = ev_param->num_chan_stats;
+	view->pdev_stats_size = sizeof(wmi_pdev_stats);
+	view->vdev_stats_size = sizeof(wmi_vdev_stats);
+	view->peer_stats_size = sizeof(wmi_peer_stats);
+	view->chan_stats_size = sizeof(wmi_chan_stats);
+
+	view->pdev = (uint8_t *) param_buf->data;
+	view->vdev = view->pdev +
+		(view->num_pdev_stats * view->pdev_stats_size);
+	view->peer = view->vdev +
+		(view->num_vdev_stats * view->vdev_stats_size);
+	view->chan = view->peer +
+		(view->num_peer_stats * view->peer_stats_size);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * extract_vdev_stats_bulk_tlv() - extract a range of vdev stats from event
+ * @wmi_handle: wmi handle
+ * @param evt_buf: pointer to event buffer
+ * @param start: Index of the first vdev stats record to extract
+ * @param num: Number of entries in vdev_stats
+ * @param vdev_stats: Array to hold vdev stats
+ * @param num_filled: Set to the number of entries filled
+ *
+ * Return: QDF_STATUS_SUCCESS for success or error code
+ */
+static QDF_STATUS extract_vdev_stats_bulk_tlv(wmi_unified_t wmi_handle,
+	void *evt_buf, uint32_t start, uint32_t num,
+	wmi_host_vdev_stats *vdev_stats, uint32_t *num_filled)
+{
+	struct wmi_host_stats_view view;
+	const wmi_vdev_stats *ev;
+	uint32_t i;
+
+	*num_filled = 0;
+	if (extract_stats_view_tlv(wmi_handle, evt_buf, &view) !=
+	    QDF_STATUS_SUCCESS)
+		return QDF_STATUS_E_FAILURE;
+
+	if (start >= view.num_vdev_stats)
+		return QDF_STATUS_SUCCESS;
+
+	num = QDF_MIN(num, view.num_vdev_stats - start);
+	qdf_mem_zero(vdev_stats, num * sizeof(*vdev_stats));
+	ev = (const wmi_vdev_stats *) view.vdev + start;
+
+	for (i = 0; i < num; i++, ev++, vdev_stats++)
+		copy_vdev_stats_tlv(vdev_stats, ev);
+	*num_filled = num;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * extract_peer_stats_bulk_tlv() - extract a range of peer stats from event
+ * @wmi_handle: wmi handle
+ * @param evt_buf: pointer to event buffer
+ * @param start: Index of the first peer stats record to extract
+ * @param num: Number of entries in peer_stats
+ * @param peer_stats: Array to hold peer stats
+ * @param num_filled: Set to the number of entries filled
+ *
+ * Return: QDF_STATUS_SUCCESS for success or error code
+ */
+static QDF_STATUS extract_peer_stats_bulk_tlv(wmi_unified_t wmi_handle,
+	void *evt_buf, uint32_t start, uint32_t num,
+	wmi_host_peer_stats *peer_stats, uint32_t *num_filled)
+{
+	struct wmi_host_stats_view view;
+	const wmi_peer_stats *ev;
+	uint32_t i;
+
+	*num_filled = 0;
+	if (extract_stats_view_tlv(wmi_handle, evt_buf, &view) !=
+	    QDF_STATUS_SUCCESS)
+		return QDF_STATUS_E_FAILURE;
+
+	if (start >= view.num_peer_stats)
+		return QDF_STATUS_SUCCESS;
+
+	num = QDF_MIN(num, view.num_peer_stats - start);
+	qdf_mem_zero(peer_stats, num * sizeof(*peer_stats));
+	ev = (const wmi_peer_stats *) view.peer + start;
+
+	for (i = 0; i < num; i++, ev++, peer_stats++)
+		copy_peer_stats_tlv(peer_stats, ev);
+	*num_filled = num;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * extract_chan_stats_bulk_tlv() - extract a range of chan stats from event
+ * @wmi_handle: wmi handle
+ * @param evt_buf: pointer to event buffer
+ * @param start: Index of the first chan stats record to extract
+ * @param num: Number of entries in chan_stats
+ * @param chan_stats: Array to hold chan stats
+ * @param num_filled: Set to the number of entries filled
+ *
+ * Return: QDF_STATUS_SUCCESS for success or error code
+ */
+static QDF_STATUS extract_chan_stats_bulk_tlv(wmi_unified_t wmi_handle,
+	void *evt_buf, uint32_t start, uint32_t num,
+	wmi_host_chan_stats *chan_stats, uint32_t *num_filled)
+{
+	struct wmi_host_stats_view view;
+	const wmi_chan_stats *ev;
+	uint32_t i;
+
+	*num_filled = 0;
+	if (extract_stats_view_tlv(wmi_handle, evt_buf, &view) !=
+	    QDF_STATUS_SUCCESS)
+		return QDF_STATUS_E_FAILURE;
+
+	if (start >= view.num_chan_stats)
+		return QDF_STATUS_SUCCESS;
+
+	num = QDF_MIN(num, view.num_chan_stats - start);
+	ev = (const wmi_chan_stats *) view.chan + start;
+
+	for (i = 0; i < num; i++, ev++, chan_stats++)
+		copy_chan_stats_tlv(chan_stats, ev);
+	*num_filled = num;
+
+	return QDF_STATUS_SUCCESS;
+}
+
 /**
  * extract_profile_ctx_tlv() - extract profile context from event
  * @wmi_handle: wmi handle
@@ -12040,6 +12230,10 @@ struct wmi_ops tlv_ops =  {
 	.extract_bcnflt_stats = extract_bcnflt_stats_tlv,
 	.extract_peer_extd_stats = extract_peer_extd_stats_tlv,
 	.extract_chan_stats = extract_chan_stats_tlv,
+	.extract_stats_view = extract_stats_view_tlv,
+	.extract_vdev_stats_bulk = extract_vdev_stats_bulk_tlv,
+	.extract_peer_stats_bulk = extract_peer_stats_bulk_tlv,
+	.extract_chan_stats_bulk = extract_chan_stats_bulk_tlv,
 	.extract_profile_ctx = extract_profile_ctx_tlv,
 	.extract_profile_data = extract_profile_data_tlv,
 	.extract_chan_info_event = extract_chan_info_event_tlv,